@@ -67,7 +67,10 @@ int pf_writer_write(PfWriter* w, const char* path, int64_t nrows);
  * Usage:
  *   1. pf_sink_create() with schema and output directory
  *   2. pf_sink_start() to spawn the writer thread
- *   3. pf_sink_push() from hot path (non-blocking, returns 0 or -1)
+ *   3. pf_sink_push() from hot path (non-blocking, returns 0 or -1), or
+ *      pf_sink_reserve() + fill the returned row in place + pf_sink_commit()
+ *      to skip the copy (reserve returns NULL when the ring is full; a
+ *      commit without a successful, uncommitted reserve is a no-op)
  *   4. pf_sink_stop() to drain and join
  *   5. pf_sink_destroy() to cleanup
  */
@@ -78,6 +81,8 @@ PfSink* pf_sink_create(const char* output_dir, const PfColumnDef* cols, int ncol
                         int row_size, int compression, int batch_size);
 int     pf_sink_start(PfSink* s);
 int     pf_sink_push(PfSink* s, const void* row);
+void*   pf_sink_reserve(PfSink* s);
+void    pf_sink_commit(PfSink* s);
 void    pf_sink_stop(PfSink* s);
 void    pf_sink_destroy(PfSink* s);
 int64_t pf_sink_files_written(PfSink* s);
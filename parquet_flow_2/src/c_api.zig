@@ -181,16 +181,14 @@ export fn pf_writer_write(w: ?*WriterState, path: [*:0]const u8, num_rows: i64)
     const nrows: usize = @intCast(num_rows);
     const path_slice = std.mem.span(path);
 
-    const data = file_writer.writeParquetFile(
+    file_writer.writeParquetFileToPath(
         s.allocator,
+        path_slice,
         s.schema,
         s.col_data[0..s.num_columns],
         nrows,
         .{ .codec = s.codec },
     ) catch return -1;
-    defer s.allocator.free(data);
-
-    file_writer.writeFileToDisk(path_slice, data) catch return -1;
 
     // Reset column data for next write
     for (0..s.num_columns) |i| {
@@ -226,11 +224,12 @@ const SpscRingBuffer = @import("log_sink.zig").SpscRingBuffer;
 
 const SINK_RING_CAPACITY = 16384;
 const SINK_MAX_ROW_SIZE = 4096;
+const SinkRing = SpscRingBuffer([SINK_MAX_ROW_SIZE]u8, SINK_RING_CAPACITY);
 
 const SinkState = struct {
     allocator: std.mem.Allocator,
     gpa: std.heap.GeneralPurposeAllocator(.{}),
-    ring: SpscRingBuffer([SINK_MAX_ROW_SIZE]u8, SINK_RING_CAPACITY),
+    ring: SinkRing,
     writer_thread: ?std.Thread,
     should_stop: std.atomic.Value(bool),
     output_dir: []u8,
@@ -246,40 +245,33 @@ const SinkState = struct {
     entries_written: std.atomic.Value(usize),
 
     fn writerLoop(self: *SinkState) void {
-        var batch_buf: [8192][SINK_MAX_ROW_SIZE]u8 = undefined;
         var file_seq: usize = 0;
 
         while (!self.should_stop.load(.acquire)) {
-            const count = self.drainBatch(&batch_buf);
-            if (count > 0) {
-                self.writeBatch(batch_buf[0..count], file_seq);
+            if (self.drainBatch(file_seq)) {
                 file_seq += 1;
             } else {
                 nanosleep_ms(1);
             }
         }
         // Final drain
-        while (true) {
-            const count = self.drainBatch(&batch_buf);
-            if (count == 0) break;
-            self.writeBatch(batch_buf[0..count], file_seq);
+        while (self.drainBatch(file_seq)) {
             file_seq += 1;
         }
     }
 
-    fn drainBatch(self: *SinkState, batch: *[8192][SINK_MAX_ROW_SIZE]u8) usize {
-        var count: usize = 0;
-        while (count < self.batch_size and count < 8192) {
-            if (self.ring.pop()) |entry| {
-                batch[count] = entry;
-                count += 1;
-            } else break;
-        }
-        return count;
+    /// Write up to batch_size rows straight from ring memory, then release
+    /// them. Returns false if the ring was empty.
+    fn drainBatch(self: *SinkState, seq: usize) bool {
+        const rows = self.ring.peekContiguous(self.batch_size);
+        if (rows.len() == 0) return false;
+        self.writeBatch(rows, seq);
+        self.ring.release(rows.len());
+        return true;
     }
 
-    fn writeBatch(self: *SinkState, rows: [][SINK_MAX_ROW_SIZE]u8, seq: usize) void {
-        const nrows = rows.len;
+    fn writeBatch(self: *SinkState, rows: SinkRing.Span, seq: usize) void {
+        const nrows = rows.len();
         const allocator = self.allocator;
 
         // Allocate column arrays
@@ -304,7 +296,8 @@ const SinkState = struct {
             switch (self.schema[c].physical_type) {
                 .INT32 => {
                     const buf = allocator.alloc(i32, nrows) catch return;
-                    for (rows, 0..) |row, r| {
+                    for (0..nrows) |r| {
+                        const row = rows.at(r);
                         const offset = self.field_offsets[c];
                         buf[r] = std.mem.readInt(i32, row[offset..][0..4], .little);
                     }
@@ -313,7 +306,8 @@ const SinkState = struct {
                 },
                 .INT64 => {
                     const buf = allocator.alloc(i64, nrows) catch return;
-                    for (rows, 0..) |row, r| {
+                    for (0..nrows) |r| {
+                        const row = rows.at(r);
                         const offset = self.field_offsets[c];
                         buf[r] = std.mem.readInt(i64, row[offset..][0..8], .little);
                     }
@@ -322,7 +316,8 @@ const SinkState = struct {
                 },
                 .FLOAT => {
                     const buf = allocator.alloc(f32, nrows) catch return;
-                    for (rows, 0..) |row, r| {
+                    for (0..nrows) |r| {
+                        const row = rows.at(r);
                         const offset = self.field_offsets[c];
                         const bits = std.mem.readInt(u32, row[offset..][0..4], .little);
                         buf[r] = @bitCast(bits);
@@ -332,7 +327,8 @@ const SinkState = struct {
                 },
                 .DOUBLE => {
                     const buf = allocator.alloc(f64, nrows) catch return;
-                    for (rows, 0..) |row, r| {
+                    for (0..nrows) |r| {
+                        const row = rows.at(r);
                         const offset = self.field_offsets[c];
                         const bits = std.mem.readInt(u64, row[offset..][0..8], .little);
                         buf[r] = @bitCast(bits);
@@ -342,7 +338,8 @@ const SinkState = struct {
                 },
                 .BYTE_ARRAY => {
                     const buf = allocator.alloc([]const u8, nrows) catch return;
-                    for (rows, 0..) |row, r| {
+                    for (0..nrows) |r| {
+                        const row = rows.at(r);
                         const offset = self.field_offsets[c];
                         const size = self.field_sizes[c];
                         // Field layout: [data][len_u16] where len_u16 is at offset+size-2
@@ -360,16 +357,14 @@ const SinkState = struct {
         var fname_buf: [512]u8 = undefined;
         const fname = std.fmt.bufPrint(&fname_buf, "{s}/sink_{d:0>6}.parquet", .{ self.output_dir, seq }) catch return;
 
-        const data = file_writer.writeParquetFile(
+        file_writer.writeParquetFileToPath(
             allocator,
+            fname,
             self.schema,
             col_data_arr[0..self.num_columns],
             nrows,
             .{ .codec = self.codec },
         ) catch return;
-        defer allocator.free(data);
-
-        file_writer.writeFileToDisk(fname, data) catch return;
         _ = self.files_written.fetchAdd(1, .release);
         _ = self.entries_written.fetchAdd(nrows, .release);
     }
@@ -409,7 +404,7 @@ export fn pf_sink_create(
     state.* = .{
         .allocator = allocator,
         .gpa = gpa,
-        .ring = SpscRingBuffer([SINK_MAX_ROW_SIZE]u8, SINK_RING_CAPACITY).init(),
+        .ring = SinkRing.init(),
         .writer_thread = null,
         .should_stop = std.atomic.Value(bool).init(false),
         .output_dir = dir_copy,
@@ -463,10 +458,25 @@ export fn pf_sink_start(s: ?*SinkState) callconv(.c) c_int {
 
 export fn pf_sink_push(s: ?*SinkState, row: [*]const u8) callconv(.c) c_int {
     const state = s orelse return -1;
-    var entry: [SINK_MAX_ROW_SIZE]u8 = undefined;
-    @memcpy(entry[0..state.row_size], row[0..state.row_size]);
-    if (state.ring.push(entry)) return 0;
-    return -1;
+    const slot = state.ring.reserve() orelse return -1;
+    @memcpy(slot[0..state.row_size], row[0..state.row_size]);
+    _ = state.ring.commit();
+    return 0;
+}
+
+/// Zero-copy push: returns a row_size-byte slot to fill in place, or null if
+/// the ring is full. Publish it with pf_sink_commit().
+export fn pf_sink_reserve(s: ?*SinkState) callconv(.c) ?*anyopaque {
+    const state = s orelse return null;
+    const slot = state.ring.reserve() orelse return null;
+    return slot;
+}
+
+/// A no-op without a pending pf_sink_reserve() slot (the reserve returned
+/// NULL, or the slot was already committed).
+export fn pf_sink_commit(s: ?*SinkState) callconv(.c) void {
+    const state = s orelse return;
+    _ = state.ring.commit();
 }
 
 export fn pf_sink_stop(s: ?*SinkState) callconv(.c) void {
@@ -16,12 +16,16 @@ pub fn SpscRingBuffer(comptime T: type, comptime capacity: comptime_int) type {
         buffer: [capacity]T,
         write_pos: std.atomic.Value(usize),
         read_pos: std.atomic.Value(usize),
+        /// Producer-only: a `reserve()` handed out the slot at `write_pos`
+        /// and it has not been committed yet.
+        reserved: bool,
 
         pub fn init() Self {
             return .{
                 .buffer = undefined,
                 .write_pos = std.atomic.Value(usize).init(0),
                 .read_pos = std.atomic.Value(usize).init(0),
+                .reserved = false,
             };
         }
 
@@ -34,6 +38,34 @@ pub fn SpscRingBuffer(comptime T: type, comptime capacity: comptime_int) type {
 
             self.buffer[wp & mask] = item;
             self.write_pos.store(wp +% 1, .release);
+            // A pending reservation pointed at the slot just published
+            self.reserved = false;
+            return true;
+        }
+
+        /// Wait-free in-place push: returns the next free slot for the caller
+        /// to fill, or null if the ring is full. Publish it with `commit()`.
+        pub fn reserve(self: *Self) ?*T {
+            const wp = self.write_pos.load(.monotonic);
+            const rp = self.read_pos.load(.acquire);
+
+            if (wp -% rp >= capacity) {
+                self.reserved = false;
+                return null;
+            }
+
+            self.reserved = true;
+            return &self.buffer[wp & mask];
+        }
+
+        /// Publish the slot returned by the last `reserve()`. Returns false,
+        /// publishing nothing, without one: after a `reserve()` that returned
+        /// null, or a second `commit()` of the same slot.
+        pub fn commit(self: *Self) bool {
+            if (!self.reserved) return false;
+            self.reserved = false;
+            const wp = self.write_pos.load(.monotonic);
+            self.write_pos.store(wp +% 1, .release);
             return true;
         }
 
@@ -49,6 +81,43 @@ pub fn SpscRingBuffer(comptime T: type, comptime capacity: comptime_int) type {
             return item;
         }
 
+        /// Readable items as at most two contiguous runs of ring memory:
+        /// `first` starts at the read position, `second` continues from
+        /// index 0 after a wrap.
+        pub const Span = struct {
+            first: []const T,
+            second: []const T,
+
+            pub fn len(self: Span) usize {
+                return self.first.len + self.second.len;
+            }
+
+            pub fn at(self: Span, i: usize) *const T {
+                return if (i < self.first.len) &self.first[i] else &self.second[i - self.first.len];
+            }
+        };
+
+        /// Bulk pop: exposes up to `max` items in place with one acquire load.
+        /// Nothing is consumed until `release()`.
+        pub fn peekContiguous(self: *Self, max: usize) Span {
+            const rp = self.read_pos.load(.monotonic);
+            const wp = self.write_pos.load(.acquire);
+
+            const n = @min(wp -% rp, max);
+            const start = rp & mask;
+            const first_len = @min(n, capacity - start);
+            return .{
+                .first = self.buffer[start..][0..first_len],
+                .second = self.buffer[0 .. n - first_len],
+            };
+        }
+
+        /// Free the first `count` items returned by `peekContiguous()`.
+        pub fn release(self: *Self, count: usize) void {
+            const rp = self.read_pos.load(.monotonic);
+            self.read_pos.store(rp +% count, .release);
+        }
+
         pub fn len(self: *Self) usize {
             const wp = self.write_pos.load(.acquire);
             const rp = self.read_pos.load(.acquire);
@@ -143,13 +212,13 @@ pub const LogSink = struct {
     }
 
     fn drainBatch(self: *LogSink, batch: *[BATCH_SIZE]LogEntry) usize {
-        var count: usize = 0;
-        while (count < BATCH_SIZE) {
-            if (self.ring.pop()) |entry| {
-                batch[count] = entry;
-                count += 1;
-            } else break;
-        }
+        const span = self.ring.peekContiguous(BATCH_SIZE);
+        const count = span.len();
+        if (count == 0) return 0;
+
+        @memcpy(batch[0..span.first.len], span.first);
+        @memcpy(batch[span.first.len..][0..span.second.len], span.second);
+        self.ring.release(count);
         return count;
     }
 
@@ -208,3 +277,56 @@ test "SPSC ring buffer len" {
     _ = ring.pop();
     try std.testing.expectEqual(@as(usize, 1), ring.len());
 }
+
+test "SPSC ring buffer reserve/commit" {
+    var ring = SpscRingBuffer(u32, 2).init();
+
+    const slot = ring.reserve().?;
+    slot.* = 7;
+    try std.testing.expectEqual(@as(?u32, null), ring.pop()); // not yet published
+    try std.testing.expect(ring.commit());
+    try std.testing.expectEqual(@as(?u32, 7), ring.pop());
+
+    ring.reserve().?.* = 1;
+    try std.testing.expect(ring.commit());
+    ring.reserve().?.* = 2;
+    try std.testing.expect(ring.commit());
+    try std.testing.expect(ring.reserve() == null);
+}
+
+test "SPSC ring buffer commit needs a pending reservation" {
+    var ring = SpscRingBuffer(u32, 2).init();
+    try std.testing.expect(!ring.commit());
+
+    // A second commit of the same slot publishes nothing
+    ring.reserve().?.* = 1;
+    try std.testing.expect(ring.commit());
+    try std.testing.expect(!ring.commit());
+    try std.testing.expectEqual(@as(usize, 1), ring.len());
+
+    // Neither does a commit after a reserve that found the ring full
+    ring.reserve().?.* = 2;
+    try std.testing.expect(ring.commit());
+    try std.testing.expect(ring.reserve() == null);
+    try std.testing.expect(!ring.commit());
+    try std.testing.expectEqual(@as(usize, 2), ring.len());
+    try std.testing.expectEqual(@as(?u32, 1), ring.pop());
+    try std.testing.expectEqual(@as(?u32, 2), ring.pop());
+    try std.testing.expectEqual(@as(?u32, null), ring.pop());
+}
+
+test "SPSC ring buffer peekContiguous across wrap" {
+    var ring = SpscRingBuffer(u32, 4).init();
+
+    for (0..3) |i| try std.testing.expect(ring.push(@intCast(i)));
+    ring.release(ring.peekContiguous(2).len());
+    for (3..6) |i| try std.testing.expect(ring.push(@intCast(i)));
+
+    // Items 2..5 sit at indices 2,3,0,1
+    const span = ring.peekContiguous(8);
+    try std.testing.expectEqualSlices(u32, &.{ 2, 3 }, span.first);
+    try std.testing.expectEqualSlices(u32, &.{ 4, 5 }, span.second);
+    try std.testing.expectEqual(@as(u32, 4), span.at(2).*);
+    ring.release(span.len());
+    try std.testing.expectEqual(@as(?u32, null), ring.pop());
+}
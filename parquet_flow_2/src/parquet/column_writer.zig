@@ -5,15 +5,18 @@ const page_writer = @import("page_writer.zig");
 
 /// Write one column chunk (all pages for one column within one row group).
 /// Returns ColumnChunkInfo with offsets/sizes for the footer metadata.
+/// `base_offset` is the file offset of `output.items[0]`.
 pub fn writeColumnChunk(
     allocator: std.mem.Allocator,
     output: *std.ArrayList(u8),
+    base_offset: i64,
     col_spec: types.ColumnSpec,
     col_data: ColumnData,
     num_rows: usize,
     codec: types.CompressionCodec,
 ) !types.ColumnChunkInfo {
-    const data_page_offset: i64 = @intCast(output.items.len);
+    const chunk_start = output.items.len;
+    const data_page_offset: i64 = base_offset + @as(i64, @intCast(chunk_start));
 
     // 1. Encode values with PLAIN encoding
     var encoded_values: std.ArrayList(u8) = .empty;
@@ -53,7 +56,7 @@ pub fn writeColumnChunk(
         codec,
     );
 
-    const total_size: i64 = @as(i64, @intCast(output.items.len)) - data_page_offset;
+    const total_size: i64 = @intCast(output.items.len - chunk_start);
 
     return types.ColumnChunkInfo{
         .file_offset = data_page_offset,
@@ -85,6 +88,7 @@ test "write INT64 column chunk" {
     const info = try writeColumnChunk(
         allocator,
         &output,
+        0,
         .{ .name = "test", .physical_type = .INT64, .repetition_type = .REQUIRED },
         .{ .i64_values = &values },
         3,
@@ -106,6 +110,7 @@ test "write optional BYTE_ARRAY column chunk" {
     const info = try writeColumnChunk(
         allocator,
         &output,
+        0,
         .{ .name = "opt_col", .physical_type = .BYTE_ARRAY, .repetition_type = .OPTIONAL },
         .{ .byte_array_values = &strs, .def_levels = &def_levels },
         2,
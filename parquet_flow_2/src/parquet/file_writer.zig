@@ -55,10 +55,7 @@ pub fn writeLogEntriesWithOptions(
         .{ .byte_array_values = sources, .def_levels = def_levels },
     };
 
-    const data = try writeParquetFile(allocator, &types.LOG_SCHEMA, &col_data, num_rows, options);
-    defer allocator.free(data);
-
-    try writeFileToDisk(path, data);
+    try writeParquetFileToPath(allocator, path, &types.LOG_SCHEMA, &col_data, num_rows, options);
 }
 
 /// Build a complete Parquet file in memory and return the bytes.
@@ -84,13 +81,7 @@ pub fn writeParquetFile(
 
     var row_offset: usize = 0;
     while (row_offset < num_rows) {
-        // Estimate rows per row group
-        const remaining = num_rows - row_offset;
-        const rg_rows = if (num_rows <= 1) remaining else blk: {
-            const bytes_per_row = estimateBytesPerRow(columns, num_rows);
-            const target_rows = if (bytes_per_row > 0) options.row_group_size / bytes_per_row else remaining;
-            break :blk @min(@max(target_rows, 1), remaining);
-        };
+        const rg_rows = rowGroupRows(columns, num_rows, row_offset, options);
 
         // Slice column data for this row group
         var sliced: [32]ColumnData = undefined;
@@ -101,6 +92,7 @@ pub fn writeParquetFile(
         const rg_info = try row_group_writer.writeRowGroup(
             allocator,
             &output,
+            0,
             schema,
             sliced[0..columns.len],
             rg_rows,
@@ -125,6 +117,129 @@ pub fn writeParquetFile(
     return try output.toOwnedSlice(allocator);
 }
 
+/// Number of rows in the next row group starting at `row_offset`, sized so
+/// the group stays close to `options.row_group_size` bytes.
+fn rowGroupRows(columns: []const ColumnData, num_rows: usize, row_offset: usize, options: WriteOptions) usize {
+    const remaining = num_rows - row_offset;
+    if (num_rows <= 1) return remaining;
+    const bytes_per_row = estimateBytesPerRow(columns, num_rows);
+    const target_rows = if (bytes_per_row > 0) options.row_group_size / bytes_per_row else remaining;
+    return @min(@max(target_rows, 1), remaining);
+}
+
+/// Incremental on-disk Parquet writer. Emits "PAR1" on open, each row
+/// group's pages as soon as they are encoded, and the footer on close.
+/// Only the per-column-chunk metadata is retained between row groups, so
+/// resident memory is bounded by the largest row group.
+pub const StreamWriter = struct {
+    allocator: std.mem.Allocator,
+    fd: std.posix.fd_t,
+    offset: i64,
+    schema: []const types.ColumnSpec,
+    codec: types.CompressionCodec,
+    rg_infos: std.ArrayList(types.RowGroupInfo),
+    scratch: std.ArrayList(u8),
+    total_rows: i64,
+    closed: bool,
+
+    pub fn open(
+        allocator: std.mem.Allocator,
+        path: []const u8,
+        schema: []const types.ColumnSpec,
+        codec: types.CompressionCodec,
+    ) !StreamWriter {
+        const fd = try openForWrite(path);
+        errdefer std.posix.close(fd);
+
+        try writeAll(fd, types.PARQUET_MAGIC);
+
+        return .{
+            .allocator = allocator,
+            .fd = fd,
+            .offset = types.PARQUET_MAGIC.len,
+            .schema = schema,
+            .codec = codec,
+            .rg_infos = .empty,
+            .scratch = .empty,
+            .total_rows = 0,
+            .closed = false,
+        };
+    }
+
+    /// Encode one row group into the reusable scratch buffer and write it out.
+    pub fn writeRowGroup(self: *StreamWriter, columns: []const ColumnData, num_rows: usize) !void {
+        self.scratch.clearRetainingCapacity();
+        const rg_info = try row_group_writer.writeRowGroup(
+            self.allocator,
+            &self.scratch,
+            self.offset,
+            self.schema,
+            columns,
+            num_rows,
+            self.codec,
+        );
+        errdefer row_group_writer.freeRowGroupInfo(self.allocator, rg_info);
+
+        try writeAll(self.fd, self.scratch.items);
+        self.offset += @intCast(self.scratch.items.len);
+        self.total_rows += @intCast(num_rows);
+        try self.rg_infos.append(self.allocator, rg_info);
+    }
+
+    /// Write the footer and close the file.
+    pub fn close(self: *StreamWriter) !void {
+        if (self.closed) return;
+
+        self.scratch.clearRetainingCapacity();
+        try writeFileMetaData(self.allocator, &self.scratch, self.schema, self.rg_infos.items, self.total_rows, self.codec);
+        const footer_len: u32 = @intCast(self.scratch.items.len);
+        const footer_len_le = std.mem.nativeToLittle(u32, footer_len);
+        try self.scratch.appendSlice(self.allocator, std.mem.asBytes(&footer_len_le));
+        try self.scratch.appendSlice(self.allocator, types.PARQUET_MAGIC);
+
+        try writeAll(self.fd, self.scratch.items);
+        std.posix.close(self.fd);
+        self.closed = true;
+    }
+
+    pub fn deinit(self: *StreamWriter) void {
+        if (!self.closed) std.posix.close(self.fd);
+        for (self.rg_infos.items) |rgi| row_group_writer.freeRowGroupInfo(self.allocator, rgi);
+        self.rg_infos.deinit(self.allocator);
+        self.scratch.deinit(self.allocator);
+    }
+};
+
+/// Stream a Parquet file straight to `path`, one row group at a time.
+/// Equivalent to `writeParquetFile` + `writeFileToDisk` without holding the
+/// whole file in memory.
+pub fn writeParquetFileToPath(
+    allocator: std.mem.Allocator,
+    path: []const u8,
+    schema: []const types.ColumnSpec,
+    columns: []const ColumnData,
+    num_rows: usize,
+    options: WriteOptions,
+) !void {
+    var sw = try StreamWriter.open(allocator, path, schema, options.codec);
+    defer sw.deinit();
+
+    var row_offset: usize = 0;
+    while (row_offset < num_rows) {
+        const rg_rows = rowGroupRows(columns, num_rows, row_offset, options);
+
+        var sliced: [32]ColumnData = undefined;
+        for (columns, 0..) |col, i| {
+            sliced[i] = sliceColumnData(col, row_offset, rg_rows);
+        }
+
+        try sw.writeRowGroup(sliced[0..columns.len], rg_rows);
+        row_offset += rg_rows;
+    }
+
+    try sw.close();
+}
+
 fn estimateBytesPerRow(columns: []const ColumnData, num_rows: usize) usize {
     if (num_rows == 0) return 0;
     var total: usize = 0;
@@ -269,18 +384,26 @@ fn writeColumnChunk(enc: *ThriftCompactEncoder, col: types.ColumnChunkInfo, spec
 }
 
 pub fn writeFileToDisk(path: []const u8, data: []const u8) !void {
+    const fd = try openForWrite(path);
+    defer std.posix.close(fd);
+    try writeAll(fd, data);
+}
+
+fn openForWrite(path: []const u8) !std.posix.fd_t {
     var path_buf: [4096:0]u8 = undefined;
+    if (path.len >= path_buf.len) return error.NameTooLong;
     @memcpy(path_buf[0..path.len], path);
     path_buf[path.len] = 0;
 
-    const fd = try std.posix.openat(
+    return std.posix.openat(
         std.posix.AT.FDCWD,
         path_buf[0..path.len :0],
         .{ .ACCMODE = .WRONLY, .CREAT = true, .TRUNC = true },
         0o644,
     );
-    defer std.posix.close(fd);
+}
 
+fn writeAll(fd: std.posix.fd_t, data: []const u8) !void {
     var written: usize = 0;
     while (written < data.len) {
         const result = std.os.linux.write(fd, data[written..].ptr, data.len - written);
@@ -391,3 +514,33 @@ test "write DOUBLE column parquet file" {
     try std.testing.expectEqualSlices(u8, "PAR1", data[0..4]);
     try std.testing.expectEqualSlices(u8, "PAR1", data[data.len - 4 ..]);
 }
+
+test "stream parquet file to disk" {
+    const allocator = std.testing.allocator;
+    const path = "/tmp/parquet_flow_v2_stream_test.parquet";
+
+    const schema = [_]types.ColumnSpec{
+        .{ .name = "value", .physical_type = .INT64, .repetition_type = .REQUIRED },
+    };
+
+    var values: [1000]i64 = undefined;
+    for (&values, 0..) |*v, i| v.* = @intCast(i);
+    const col_data = [_]ColumnData{
+        .{ .i64_values = &values },
+    };
+
+    // Small row groups force several incremental writes
+    try writeParquetFileToPath(allocator, path, &schema, &col_data, values.len, .{ .row_group_size = 1024 });
+
+    // Byte-for-byte identical to the in-memory writer
+    const expected = try writeParquetFile(allocator, &schema, &col_data, values.len, .{ .row_group_size = 1024 });
+    defer allocator.free(expected);
+
+    const fd = try std.posix.openat(std.posix.AT.FDCWD, path, .{ .ACCMODE = .RDONLY }, 0);
+    defer std.posix.close(fd);
+    const actual = try allocator.alloc(u8, expected.len + 1);
+    defer allocator.free(actual);
+    const n = std.os.linux.read(fd, actual.ptr, actual.len);
+    try std.testing.expectEqual(expected.len, n);
+    try std.testing.expectEqualSlices(u8, expected, actual[0..n]);
+}
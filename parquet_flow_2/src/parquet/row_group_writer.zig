@@ -5,15 +5,17 @@ const ColumnData = column_writer.ColumnData;
 
 /// Write all column chunks for one row group.
 /// Returns RowGroupInfo with per-column metadata.
+/// `base_offset` is the file offset of `output.items[0]`.
 pub fn writeRowGroup(
     allocator: std.mem.Allocator,
     output: *std.ArrayList(u8),
+    base_offset: i64,
     schema: []const types.ColumnSpec,
     columns: []const ColumnData,
     num_rows: usize,
     codec: types.CompressionCodec,
 ) !types.RowGroupInfo {
-    const rg_start: i64 = @intCast(output.items.len);
+    const rg_start = output.items.len;
 
     var col_infos = try allocator.alloc(types.ColumnChunkInfo, schema.len);
     errdefer allocator.free(col_infos);
@@ -21,6 +23,7 @@ pub fn writeRowGroup(
         col_infos[i] = try column_writer.writeColumnChunk(
             allocator,
             output,
+            base_offset,
             col_spec,
             columns[i],
             num_rows,
@@ -28,7 +31,7 @@ pub fn writeRowGroup(
         );
     }
 
-    const total_byte_size: i64 = @as(i64, @intCast(output.items.len)) - rg_start;
+    const total_byte_size: i64 = @intCast(output.items.len - rg_start);
 
     return types.RowGroupInfo{
         .columns = col_infos,
@@ -59,7 +62,7 @@ test "write row group with two columns" {
         .{ .i32_values = &vals },
     };
 
-    const info = try writeRowGroup(allocator, &output, &schema, &col_data, 3, .UNCOMPRESSED);
+    const info = try writeRowGroup(allocator, &output, 0, &schema, &col_data, 3, .UNCOMPRESSED);
     defer freeRowGroupInfo(allocator, info);
 
     try std.testing.expectEqual(@as(i64, 3), info.num_rows);
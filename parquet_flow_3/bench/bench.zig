@@ -0,0 +1,641 @@
+const std = @import("std");
+const builtin = @import("builtin");
+const pf = @import("parquet_flow");
+const log_sink = pf.log_sink;
+const batch = pf.batch;
+const c_api = pf.c_api;
+const cycles = pf.cycles;
+const Histogram = pf.histogram.Histogram;
+const CompressionCodec = pf.types.CompressionCodec;
+const writeAll = pf.parquet.parquet_output.writeAll;
+const linux = std.os.linux;
+
+/// Layout version of the JSON result lines; bump when a field changes
+/// meaning so trend tooling can tell runs apart.
+const RESULT_VERSION = 1;
+
+/// Distinct messages each producer cycles through, built before timing.
+const POOL_SIZE = 4096;
+
+const MAX_PRODUCERS = log_sink.MAX_PRODUCERS - 1;
+
+const SinkKind = enum { log, typed, c };
+
+/// Message mix offered by every producer.
+const Mix = enum {
+    /// Fixed 48-byte `Order` records (fixed-width transpose path).
+    orders,
+    /// Log lines: 20-byte header plus a 32-160 byte message.
+    logs,
+    /// Log lines, 90% 24-byte and 10% 1 KiB messages (bimodal tail).
+    mixed,
+};
+
+const Format = enum { text, json };
+
+const BenchConfig = struct {
+    sinks: []const SinkKind = &.{.log},
+    codecs: []const CompressionCodec = &.{.UNCOMPRESSED},
+    encodings: []const batch.ColumnEncoding = &.{.default},
+    mix: Mix = .orders,
+    producers: u32 = 1,
+    messages: u64 = 1_000_000,
+    /// Offered messages per second per producer; 0 = as fast as possible.
+    rate: u64 = 0,
+    ring_capacity: u32 = log_sink.RING_CAPACITY,
+    batch_size: u32 = 65536,
+    wait_strategy: log_sink.WaitStrategy = .sleep,
+    encoder_threads: u32 = 0,
+    backend: log_sink.OutputBackend = .posix,
+    output_path: [:0]const u8 = "bench_out.parquet",
+    format: Format = .text,
+};
+
+const Order = extern struct {
+    timestamp_ns: i64,
+    symbol: [8]u8,
+    order_id: u64,
+    price: f64,
+    quantity: u32,
+    side: u32,
+    venue: u32,
+    flags: u32,
+};
+
+const OrderSink = pf.Sink(Order);
+
+/// Log line header; the message bytes follow it (BYTE_ARRAY tail).
+const LOG_COLUMNS = [_]batch.ColumnDef{
+    .{ .name = "timestamp_ns", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 0, .size = 8 },
+    .{ .name = "level", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    .{ .name = "thread", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 12, .size = 4 },
+    .{ .name = "message", .physical_type = .BYTE_ARRAY, .type_length = 0, .nullable = false, .offset = 16, .size = 4 },
+};
+const LOG_HEADER_SIZE = 20;
+
+const SYMBOLS = [_][8]u8{
+    "AAPL    ".*, "MSFT    ".*, "GOOGL   ".*, "AMZN    ".*,
+    "TSLA    ".*, "META    ".*, "NVDA    ".*, "JPM     ".*,
+};
+
+const LOG_TEXT = "order accepted venue=XNAS side=buy qty=100 px=187.25 session=4 " ++
+    "risk check passed limit=250000 used=118300 latency_us=12 route=direct " ++
+    "cancel replace ack seq=99812 clordid=AX-551 book depth=10 spread=0.01 ";
+
+// C ABI entry points, resolved against the library's exports so the `c`
+// sink measures exactly what a C caller pays.
+const SinkHandle = opaque {};
+const ProducerHandle = opaque {};
+extern fn pqflow_create(out: *?*SinkHandle, config: *const c_api.PqflowConfig) callconv(.c) i32;
+extern fn pqflow_set_schema(handle: ?*SinkHandle, columns: [*]const c_api.PqflowColumnDef, num_columns: u32) callconv(.c) i32;
+extern fn pqflow_register_producer(handle: ?*SinkHandle) callconv(.c) ?*ProducerHandle;
+extern fn pqflow_producer_log(handle: ?*ProducerHandle, record: [*]const u8, len: u32) callconv(.c) i32;
+extern fn pqflow_destroy(handle: ?*SinkHandle) callconv(.c) void;
+
+pub fn main(init: std.process.Init) !void {
+    const allocator = std.heap.c_allocator;
+
+    var config = BenchConfig{};
+    if (try parseArgs(allocator, init, &config)) {
+        try printUsage();
+        return;
+    }
+    if (config.producers == 0 or config.producers > MAX_PRODUCERS) return error.InvalidProducers;
+    if (config.messages == 0) return error.InvalidMessages;
+
+    const calibration = cycles.Calibration.measure(50 * std.time.ns_per_ms);
+
+    for (config.sinks) |sink_kind| {
+        for (config.codecs) |codec| {
+            for (config.encodings) |col_encoding| {
+                const run: Run = .{ .sink = sink_kind, .codec = codec, .encoding = col_encoding };
+                if (!run.supported(config)) {
+                    std.debug.print("skipping {s}/{s}/{s}: typed sink takes orders with the record's own encodings\n", .{
+                        @tagName(sink_kind), @tagName(codec), @tagName(col_encoding),
+                    });
+                    continue;
+                }
+                const result = try runOnce(allocator, config, run, calibration);
+                defer result.deinit(allocator);
+                try report(config, run, result, calibration);
+            }
+        }
+    }
+}
+
+/// One cell of the sink x codec x encoding matrix.
+const Run = struct {
+    sink: SinkKind,
+    codec: CompressionCodec,
+    encoding: batch.ColumnEncoding,
+
+    fn supported(self: Run, config: BenchConfig) bool {
+        if (self.sink != .typed) return true;
+        return config.mix == .orders and self.encoding == .default;
+    }
+};
+
+const Result = struct {
+    latency: *Histogram,
+    offered: u64,
+    accepted: u64,
+    input_bytes: u64,
+    /// Wall time until the last producer finished offering.
+    produce_ns: u64,
+    /// Wall time until the sink had drained and closed its file.
+    total_ns: u64,
+    file_bytes: u64,
+
+    fn deinit(self: Result, allocator: std.mem.Allocator) void {
+        allocator.destroy(self.latency);
+    }
+};
+
+/// Where a producer thread logs.
+const Target = union(SinkKind) {
+    log: *log_sink.Producer,
+    typed: OrderSink.Producer,
+    c: *ProducerHandle,
+
+    inline fn log(self: Target, msg: []const u8) bool {
+        return switch (self) {
+            .log => |p| if (p.log(msg)) |_| true else |_| false,
+            .typed => |p| if (p.log(@ptrCast(@alignCast(msg.ptr)))) |_| true else |_| false,
+            .c => |h| pqflow_producer_log(h, msg.ptr, @intCast(msg.len)) == 0,
+        };
+    }
+};
+
+const ActiveSink = union(SinkKind) {
+    log: *log_sink.LogSink,
+    typed: OrderSink,
+    c: *SinkHandle,
+
+    fn open(allocator: std.mem.Allocator, config: BenchConfig, run: Run) !ActiveSink {
+        const sink_config = log_sink.SinkConfig{
+            .batch_size = config.batch_size,
+            .file_path = config.output_path,
+            .codec = run.codec,
+            .ring_capacity = config.ring_capacity,
+            .wait_strategy = config.wait_strategy,
+            .num_encoder_threads = config.encoder_threads,
+            .output_backend = config.backend,
+        };
+
+        var columns_buf: [OrderSink.columns.len]batch.ColumnDef = undefined;
+        const columns = schemaColumns(config.mix, run.encoding, &columns_buf);
+
+        switch (run.sink) {
+            .typed => return .{ .typed = try OrderSink.init(sink_config, allocator) },
+            .log => {
+                const schema = batch.SchemaInfo{
+                    .columns = columns,
+                    .record_size = if (config.mix == .orders) @sizeOf(Order) else LOG_HEADER_SIZE,
+                    .nullable_count = 0,
+                    .null_bitmap_bytes = 0,
+                };
+                return .{ .log = try log_sink.LogSink.init(sink_config, schema, allocator) };
+            },
+            .c => {
+                const c_config = c_api.PqflowConfig{
+                    .file_path = config.output_path.ptr,
+                    .ring_buffer_size = config.ring_capacity,
+                    .batch_size = config.batch_size,
+                    .max_rows_per_file = 0,
+                    .compression = @enumFromInt(@intFromEnum(run.codec)),
+                    .wait_strategy = @intFromEnum(config.wait_strategy),
+                    .num_encoder_threads = config.encoder_threads,
+                    .compression_level = 0,
+                    .page_size = 0,
+                    .page_row_limit = 0,
+                    .max_bytes_per_file = 0,
+                    .rotate_interval_sec = 0,
+                    .output_backend = @intFromEnum(config.backend),
+                    .io_queue_depth = 0,
+                };
+                var handle: ?*SinkHandle = null;
+                if (pqflow_create(&handle, &c_config) != 0) return error.SinkCreateFailed;
+                errdefer pqflow_destroy(handle);
+
+                var defs: [OrderSink.columns.len]c_api.PqflowColumnDef = undefined;
+                for (columns, defs[0..columns.len]) |col, *def| {
+                    def.* = .{
+                        .name = nameZ(col.name),
+                        .type = @enumFromInt(@intFromEnum(col.physical_type)),
+                        .type_length = @intCast(col.type_length),
+                        .nullable = 0,
+                        .encoding = @intFromEnum(col.encoding),
+                        .bloom_filter = 0,
+                    };
+                }
+                if (pqflow_set_schema(handle, &defs, @intCast(columns.len)) != 0) return error.SchemaRejected;
+                return .{ .c = handle.? };
+            },
+        }
+    }
+
+    fn registerProducer(self: ActiveSink) !Target {
+        return switch (self) {
+            .log => |sink| .{ .log = try sink.registerProducer() },
+            .typed => |sink| .{ .typed = try sink.registerProducer() },
+            .c => |handle| .{ .c = pqflow_register_producer(handle) orelse return error.TooManyProducers },
+        };
+    }
+
+    /// Drain every ring, write the footer and close the file.
+    fn close(self: ActiveSink) void {
+        switch (self) {
+            .log => |sink| sink.deinit(),
+            .typed => |sink| sink.deinit(),
+            .c => |handle| pqflow_destroy(handle),
+        }
+    }
+};
+
+/// Column names are comptime literals, so they are NUL-terminated.
+fn nameZ(name: []const u8) [*:0]const u8 {
+    return @ptrCast(name.ptr);
+}
+
+/// The mix's columns with `requested` applied to every column that
+/// supports it (the rest keep their default encoding).
+fn schemaColumns(mix: Mix, requested: batch.ColumnEncoding, buf: []batch.ColumnDef) []const batch.ColumnDef {
+    const base: []const batch.ColumnDef = if (mix == .orders) &OrderSink.columns else &LOG_COLUMNS;
+    const columns = buf[0..base.len];
+    for (base, columns) |col, *out| {
+        out.* = col;
+        if (encodingApplies(requested, col.physical_type)) out.encoding = requested;
+    }
+    return columns;
+}
+
+/// Same type rules `pqflow_set_schema` enforces.
+fn encodingApplies(e: batch.ColumnEncoding, t: batch.PhysicalType) bool {
+    return switch (e) {
+        .default, .plain => true,
+        .dictionary => t != .BOOLEAN,
+        .delta_binary_packed => t == .INT32 or t == .INT64,
+        .byte_stream_split => t == .FLOAT or t == .DOUBLE,
+    };
+}
+
+/// Pre-built messages a producer cycles through, so the timed loop only
+/// stamps a timestamp and logs.
+const MessagePool = struct {
+    /// 8-aligned so `Order` records can be handed to the typed sink in place.
+    bytes: []align(8) u8,
+    offsets: []u32,
+
+    fn init(allocator: std.mem.Allocator, mix: Mix, thread: u32) !MessagePool {
+        var prng = std.Random.DefaultPrng.init(0x5EED + thread);
+        const random = prng.random();
+
+        const offsets = try allocator.alloc(u32, POOL_SIZE + 1);
+        errdefer allocator.free(offsets);
+        offsets[0] = 0;
+        for (0..POOL_SIZE) |i| {
+            const len: u32 = switch (mix) {
+                .orders => @sizeOf(Order),
+                .logs => LOG_HEADER_SIZE + random.intRangeAtMost(u32, 32, 160),
+                .mixed => LOG_HEADER_SIZE + @as(u32, if (random.uintLessThan(u32, 10) == 0) 1024 else 24),
+            };
+            offsets[i + 1] = offsets[i] + len;
+        }
+
+        const bytes = try allocator.alignedAlloc(u8, .fromByteUnits(8), offsets[POOL_SIZE]);
+        const pool: MessagePool = .{ .bytes = bytes, .offsets = offsets };
+        for (0..POOL_SIZE) |i| {
+            const msg = pool.get(i);
+            if (mix == .orders) {
+                const order: *Order = @ptrCast(@alignCast(msg.ptr));
+                order.* = .{
+                    .timestamp_ns = 0,
+                    .symbol = SYMBOLS[random.uintLessThan(usize, SYMBOLS.len)],
+                    .order_id = i,
+                    .price = 100.0 + @as(f64, @floatFromInt(random.uintLessThan(u32, 10_000))) / 100.0,
+                    .quantity = 1 + random.uintLessThan(u32, 1000),
+                    .side = random.uintLessThan(u32, 2),
+                    .venue = 1 + random.uintLessThan(u32, 4),
+                    .flags = 0,
+                };
+            } else {
+                const text_len: u32 = @intCast(msg.len - LOG_HEADER_SIZE);
+                std.mem.writeInt(i64, msg[0..8], 0, .little);
+                std.mem.writeInt(i32, msg[8..12], @intCast(random.uintLessThan(u32, 5)), .little);
+                std.mem.writeInt(i32, msg[12..16], @intCast(thread), .little);
+                std.mem.writeInt(u32, msg[16..20], text_len, .little);
+                for (msg[LOG_HEADER_SIZE..], 0..) |*b, j| b.* = LOG_TEXT[(i * 7 + j) % LOG_TEXT.len];
+            }
+        }
+        return pool;
+    }
+
+    fn deinit(self: MessagePool, allocator: std.mem.Allocator) void {
+        allocator.free(self.bytes);
+        allocator.free(self.offsets);
+    }
+
+    fn get(self: MessagePool, i: usize) []u8 {
+        const k = i % POOL_SIZE;
+        return self.bytes[self.offsets[k]..self.offsets[k + 1]];
+    }
+};
+
+const Worker = struct {
+    target: Target,
+    pool: MessagePool,
+    latency: *Histogram,
+    messages: u64,
+    interval_ticks: u64,
+    go: *const std.atomic.Value(bool),
+    accepted: u64 = 0,
+    input_bytes: u64 = 0,
+
+    fn run(self: *Worker) void {
+        while (!self.go.load(.acquire)) std.atomic.spinLoopHint();
+
+        const start = cycles.now();
+        var i: u64 = 0;
+        while (i < self.messages) : (i += 1) {
+            // Open loop: the schedule does not slip when a call is slow
+            if (self.interval_ticks != 0) {
+                const due = start + i * self.interval_ticks;
+                while (cycles.now() < due) std.atomic.spinLoopHint();
+            }
+            const msg = self.pool.get(i);
+            std.mem.writeInt(i64, msg[0..8], @intCast(i), .little);
+
+            const t0 = cycles.now();
+            const ok = self.target.log(msg);
+            const t1 = cycles.now();
+
+            self.latency.record(t1 -% t0);
+            if (ok) {
+                self.accepted += 1;
+                self.input_bytes += msg.len;
+            }
+        }
+    }
+};
+
+fn runOnce(allocator: std.mem.Allocator, config: BenchConfig, run: Run, calibration: cycles.Calibration) !Result {
+    const interval_ticks: u64 = if (config.rate == 0) 0 else @intFromFloat(
+        @as(f64, @floatFromInt(std.time.ns_per_s / config.rate)) / calibration.ns_per_tick,
+    );
+
+    const sink = try ActiveSink.open(allocator, config, run);
+    var sink_open = true;
+    defer if (sink_open) sink.close();
+
+    const workers = try allocator.alloc(Worker, config.producers);
+    defer allocator.free(workers);
+    var go = std.atomic.Value(bool).init(false);
+
+    var num_ready: usize = 0;
+    defer for (workers[0..num_ready]) |*w| {
+        w.pool.deinit(allocator);
+        allocator.destroy(w.latency);
+    };
+    for (workers, 0..) |*w, i| {
+        const target = try sink.registerProducer();
+        const pool = try MessagePool.init(allocator, config.mix, @intCast(i));
+        errdefer pool.deinit(allocator);
+        const latency = try allocator.create(Histogram);
+        latency.* = .empty;
+        w.* = .{
+            .target = target,
+            .pool = pool,
+            .latency = latency,
+            .messages = config.messages,
+            .interval_ticks = interval_ticks,
+            .go = &go,
+        };
+        num_ready += 1;
+    }
+
+    // Allocated up front: nothing may fail once producers are running
+    const latency = try allocator.create(Histogram);
+    errdefer allocator.destroy(latency);
+    latency.* = .empty;
+
+    const threads = try allocator.alloc(std.Thread, workers.len);
+    defer allocator.free(threads);
+    var num_spawned: usize = 0;
+    errdefer {
+        go.store(true, .release);
+        for (threads[0..num_spawned]) |t| t.join();
+    }
+    for (workers, threads) |*w, *t| {
+        t.* = try std.Thread.spawn(.{}, Worker.run, .{w});
+        num_spawned += 1;
+    }
+
+    const start_ns = cycles.monotonicNs();
+    go.store(true, .release);
+    for (threads) |t| t.join();
+    const produce_ns = cycles.monotonicNs() - start_ns;
+
+    sink_open = false;
+    sink.close();
+    const total_ns = cycles.monotonicNs() - start_ns;
+
+    var accepted: u64 = 0;
+    var input_bytes: u64 = 0;
+    for (workers) |*w| {
+        latency.merge(w.latency);
+        accepted += w.accepted;
+        input_bytes += w.input_bytes;
+    }
+
+    return .{
+        .latency = latency,
+        .offered = config.messages * config.producers,
+        .accepted = accepted,
+        .input_bytes = input_bytes,
+        .produce_ns = produce_ns,
+        .total_ns = total_ns,
+        .file_bytes = fileSize(config.output_path),
+    };
+}
+
+fn fileSize(path: [*:0]const u8) u64 {
+    const rc = linux.open(path, .{ .ACCMODE = .RDONLY, .CLOEXEC = true }, 0);
+    if (linux.errno(rc) != .SUCCESS) return 0;
+    const fd: linux.fd_t = @intCast(rc);
+    defer _ = linux.close(fd);
+    const end = linux.lseek(fd, 0, linux.SEEK.END);
+    if (linux.errno(end) != .SUCCESS) return 0;
+    return end;
+}
+
+const PERCENTILES = [_]struct { name: []const u8, p: f64 }{
+    .{ .name = "p50", .p = 50 },
+    .{ .name = "p90", .p = 90 },
+    .{ .name = "p99", .p = 99 },
+    .{ .name = "p999", .p = 99.9 },
+    .{ .name = "p9999", .p = 99.99 },
+};
+
+fn report(config: BenchConfig, run: Run, result: Result, calibration: cycles.Calibration) !void {
+    const hist = result.latency;
+    var lat: [PERCENTILES.len]u64 = undefined;
+    for (PERCENTILES, &lat) |pct, *v| v.* = calibration.toNs(hist.percentile(pct.p));
+    const max_ns = calibration.toNs(hist.max);
+    const mean_ns = hist.mean() * calibration.ns_per_tick;
+
+    const dropped = result.offered - result.accepted;
+    const drop_rate = ratio(dropped, result.offered);
+    const offered_rate = ratio(result.offered, result.produce_ns) * std.time.ns_per_s;
+    const input_mbps = ratio(result.input_bytes, result.total_ns) * 1000.0;
+    const disk_mbps = ratio(result.file_bytes, result.total_ns) * 1000.0;
+
+    var buf: [2048]u8 = undefined;
+    const line = switch (config.format) {
+        .text => try std.fmt.bufPrint(&buf,
+            \\{s:<5} {s:<6} {s:<12} {s:<19} producers={d} offered={d} dropped={d} ({d:.3}%) rate={d:.0}/s
+            \\      latency ns: p50={d} p90={d} p99={d} p99.9={d} p99.99={d} max={d} mean={d:.1}
+            \\      throughput: in {d:.1} MB/s, disk {d:.1} MB/s, file {d} bytes, {d:.3} s
+            \\
+        , .{
+            @tagName(run.sink),                  @tagName(config.mix),
+            @tagName(run.codec),                 @tagName(run.encoding),
+            config.producers,                    result.offered,
+            dropped,                             drop_rate * 100.0,
+            offered_rate,                        lat[0],
+            lat[1],                              lat[2],
+            lat[3],                              lat[4],
+            max_ns,                              mean_ns,
+            input_mbps,                          disk_mbps,
+            result.file_bytes,                   @as(f64, @floatFromInt(result.total_ns)) / std.time.ns_per_s,
+        }),
+        .json => try std.fmt.bufPrint(&buf,
+            "{{\"version\":{d},\"arch\":\"{s}\",\"sink\":\"{s}\",\"mix\":\"{s}\",\"codec\":\"{s}\",\"encoding\":\"{s}\"," ++
+                "\"producers\":{d},\"messages_per_producer\":{d},\"rate_per_producer\":{d},\"ring_capacity\":{d}," ++
+                "\"batch_size\":{d},\"wait_strategy\":\"{s}\",\"encoder_threads\":{d},\"backend\":\"{s}\"," ++
+                "\"offered\":{d},\"accepted\":{d},\"dropped\":{d},\"drop_rate\":{d:.6},\"offered_rate\":{d:.1}," ++
+                "\"latency_ns\":{{\"p50\":{d},\"p90\":{d},\"p99\":{d},\"p999\":{d},\"p9999\":{d},\"max\":{d},\"mean\":{d:.1}}}," ++
+                "\"input_bytes\":{d},\"file_bytes\":{d},\"produce_ns\":{d},\"total_ns\":{d}," ++
+                "\"input_mb_per_sec\":{d:.2},\"disk_mb_per_sec\":{d:.2},\"ns_per_tick\":{d:.6}}}\n",
+            .{
+                RESULT_VERSION,                @tagName(builtin.cpu.arch),
+                @tagName(run.sink),            @tagName(config.mix),
+                @tagName(run.codec),           @tagName(run.encoding),
+                config.producers,              config.messages,
+                config.rate,                   config.ring_capacity,
+                config.batch_size,             @tagName(config.wait_strategy),
+                config.encoder_threads,        @tagName(config.backend),
+                result.offered,                result.accepted,
+                dropped,                       drop_rate,
+                offered_rate,                  lat[0],
+                lat[1],                        lat[2],
+                lat[3],                        lat[4],
+                max_ns,                        mean_ns,
+                result.input_bytes,            result.file_bytes,
+                result.produce_ns,             result.total_ns,
+                input_mbps,                    disk_mbps,
+                calibration.ns_per_tick,
+            },
+        ),
+    };
+    try writeAll(1, line);
+}
+
+fn ratio(num: u64, den: u64) f64 {
+    if (den == 0) return 0;
+    return @as(f64, @floatFromInt(num)) / @as(f64, @floatFromInt(den));
+}
+
+fn parseArgs(allocator: std.mem.Allocator, init: std.process.Init, config: *BenchConfig) !bool {
+    var args = std.process.Args.Iterator.init(init.minimal.args);
+    _ = args.skip();
+
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "-h") or std.mem.eql(u8, arg, "--help")) {
+            return true;
+        }
+        const value = args.next() orelse return error.MissingValue;
+        if (std.mem.eql(u8, arg, "--sinks")) {
+            config.sinks = try parseList(SinkKind, allocator, value, parseEnum(SinkKind));
+        } else if (std.mem.eql(u8, arg, "--codecs")) {
+            config.codecs = try parseList(CompressionCodec, allocator, value, parseCodec);
+        } else if (std.mem.eql(u8, arg, "--encodings")) {
+            config.encodings = try parseList(batch.ColumnEncoding, allocator, value, parseEnum(batch.ColumnEncoding));
+        } else if (std.mem.eql(u8, arg, "--mix")) {
+            config.mix = parseEnum(Mix)(value) orelse return error.InvalidArgument;
+        } else if (std.mem.eql(u8, arg, "--producers")) {
+            config.producers = try std.fmt.parseInt(u32, value, 10);
+        } else if (std.mem.eql(u8, arg, "--messages")) {
+            config.messages = try std.fmt.parseInt(u64, value, 10);
+        } else if (std.mem.eql(u8, arg, "--rate")) {
+            config.rate = try std.fmt.parseInt(u64, value, 10);
+        } else if (std.mem.eql(u8, arg, "--ring")) {
+            config.ring_capacity = try std.fmt.parseInt(u32, value, 10);
+        } else if (std.mem.eql(u8, arg, "--batch")) {
+            config.batch_size = try std.fmt.parseInt(u32, value, 10);
+        } else if (std.mem.eql(u8, arg, "--wait")) {
+            config.wait_strategy = parseEnum(log_sink.WaitStrategy)(value) orelse return error.InvalidArgument;
+        } else if (std.mem.eql(u8, arg, "--encoder-threads")) {
+            config.encoder_threads = try std.fmt.parseInt(u32, value, 10);
+        } else if (std.mem.eql(u8, arg, "--backend")) {
+            config.backend = parseEnum(log_sink.OutputBackend)(value) orelse return error.InvalidArgument;
+        } else if (std.mem.eql(u8, arg, "--output")) {
+            config.output_path = try allocator.dupeZ(u8, value);
+        } else if (std.mem.eql(u8, arg, "--format")) {
+            config.format = parseEnum(Format)(value) orelse return error.InvalidArgument;
+        } else {
+            return error.InvalidArgument;
+        }
+    }
+    return false;
+}
+
+fn printUsage() !void {
+    try writeAll(1,
+        \\usage: zig build bench -Doptimize=ReleaseFast -- [options]
+        \\  --sinks log,typed,c          sinks to run (default log)
+        \\  --codecs none,snappy,gzip,zstd,lz4
+        \\                               codecs to run (default none)
+        \\  --encodings default,plain,dictionary,delta_binary_packed,byte_stream_split
+        \\                               encodings to run, applied where the column type allows
+        \\  --mix orders|logs|mixed      message mix (default orders)
+        \\  --producers N                producer threads, one ring each (default 1)
+        \\  --messages N                 messages per producer (default 1000000)
+        \\  --rate N                     offered messages/s per producer, 0 = flat out (default 0)
+        \\  --ring BYTES                 ring capacity per producer (default 4194304)
+        \\  --batch ROWS                 rows per row group (default 65536)
+        \\  --wait sleep|spin|spin_then_futex|futex
+        \\  --encoder-threads N          parallel column encoders (default 0)
+        \\  --backend posix|io_uring     file output backend (default posix)
+        \\  --output PATH                output file (default bench_out.parquet)
+        \\  --format text|json           json prints one object per run (default text)
+        \\Every sink x codec x encoding combination is one run.
+        \\
+    );
+}
+
+fn parseList(comptime T: type, allocator: std.mem.Allocator, value: []const u8, comptime parse: fn ([]const u8) ?T) ![]const T {
+    var list: std.ArrayList(T) = .empty;
+    errdefer list.deinit(allocator);
+    var it = std.mem.splitScalar(u8, value, ',');
+    while (it.next()) |item| {
+        try list.append(allocator, parse(item) orelse return error.InvalidArgument);
+    }
+    return list.toOwnedSlice(allocator);
+}
+
+fn parseEnum(comptime T: type) fn ([]const u8) ?T {
+    return struct {
+        fn parse(value: []const u8) ?T {
+            return std.meta.stringToEnum(T, value);
+        }
+    }.parse;
+}
+
+fn parseCodec(value: []const u8) ?CompressionCodec {
+    if (std.mem.eql(u8, value, "none")) return .UNCOMPRESSED;
+    if (std.mem.eql(u8, value, "snappy")) return .SNAPPY;
+    if (std.mem.eql(u8, value, "gzip")) return .GZIP;
+    if (std.mem.eql(u8, value, "zstd")) return .ZSTD;
+    if (std.mem.eql(u8, value, "lz4")) return .LZ4_RAW;
+    return null;
+}
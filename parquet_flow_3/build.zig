@@ -4,6 +4,13 @@ pub fn build(b: *std.Build) void {
     const target = b.standardTargetOptions(.{});
     const optimize = b.standardOptimizeOption(.{});
 
+    // Parquet decoding for src/reader.zig (vendored parzig)
+    const parzig_mod = b.createModule(.{
+        .root_source_file = b.path("deps/parzig/src/parzig.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+
     // Library root module
     const lib_mod = b.createModule(.{
         .root_source_file = b.path("src/root.zig"),
@@ -11,6 +18,8 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
         .link_libc = true,
     });
+    linkCodecs(lib_mod);
+    lib_mod.addImport("parzig", parzig_mod);
 
     // Static library
     const static_lib = b.addLibrary(.{
@@ -27,6 +36,8 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
         .link_libc = true,
     });
+    linkCodecs(shared_mod);
+    shared_mod.addImport("parzig", parzig_mod);
     const shared_lib = b.addLibrary(.{
         .name = "parquet_flow",
         .root_module = shared_mod,
@@ -44,11 +55,15 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
         .link_libc = true,
     });
-    test_mod.addImport("parquet_flow", b.createModule(.{
+    const test_lib_mod = b.createModule(.{
         .root_source_file = b.path("src/root.zig"),
         .target = target,
         .optimize = optimize,
-    }));
+        .link_libc = true,
+    });
+    linkCodecs(test_lib_mod);
+    test_lib_mod.addImport("parzig", parzig_mod);
+    test_mod.addImport("parquet_flow", test_lib_mod);
 
     const tests = b.addTest(.{
         .root_module = test_mod,
@@ -57,6 +72,36 @@ pub fn build(b: *std.Build) void {
     const test_step = b.step("test", "Run tests");
     test_step.dependOn(&run_tests.step);
 
+    // The test blocks inside src/, collected from the library root
+    const unit_mod = b.createModule(.{
+        .root_source_file = b.path("src/root.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    linkCodecs(unit_mod);
+    unit_mod.addImport("parzig", parzig_mod);
+    const unit_tests = b.addTest(.{
+        .root_module = unit_mod,
+    });
+    test_step.dependOn(&b.addRunArtifact(unit_tests).step);
+
+    // External ring buffer suite, against ring_buffer.zig on its own
+    const ring_test_mod = b.createModule(.{
+        .root_source_file = b.path("tests/test_ring_buffer.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+    ring_test_mod.addImport("ring_buffer", b.createModule(.{
+        .root_source_file = b.path("src/sink/ring_buffer.zig"),
+        .target = target,
+        .optimize = optimize,
+    }));
+    const ring_tests = b.addTest(.{
+        .root_module = ring_test_mod,
+    });
+    test_step.dependOn(&b.addRunArtifact(ring_tests).step);
+
     // Market data example
     const example_mod = b.createModule(.{
         .root_source_file = b.path("examples/market_data.zig"),
@@ -64,15 +109,70 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
         .link_libc = true,
     });
-    example_mod.addImport("parquet_flow", b.createModule(.{
+    const example_lib_mod = b.createModule(.{
         .root_source_file = b.path("src/root.zig"),
         .target = target,
         .optimize = optimize,
-    }));
+        .link_libc = true,
+    });
+    linkCodecs(example_lib_mod);
+    example_lib_mod.addImport("parzig", parzig_mod);
+    example_mod.addImport("parquet_flow", example_lib_mod);
 
     const example = b.addExecutable(.{
         .name = "market_data_example",
         .root_module = example_mod,
     });
     b.installArtifact(example);
+
+    // Latency/throughput benchmark: zig build bench -Doptimize=ReleaseFast -- [options]
+    const bench_mod = b.createModule(.{
+        .root_source_file = b.path("bench/bench.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    const bench_lib_mod = b.createModule(.{
+        .root_source_file = b.path("src/root.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    linkCodecs(bench_lib_mod);
+    bench_lib_mod.addImport("parzig", parzig_mod);
+    bench_mod.addImport("parquet_flow", bench_lib_mod);
+
+    const bench = b.addExecutable(.{
+        .name = "pqflow_bench",
+        .root_module = bench_mod,
+    });
+    const run_bench = b.addRunArtifact(bench);
+    if (b.args) |args| run_bench.addArgs(args);
+    const bench_step = b.step("bench", "Run the latency/throughput benchmark");
+    bench_step.dependOn(&run_bench.step);
+
+    // Decode files end to end: zig build verify -Doptimize=ReleaseFast -- <file.parquet>...
+    const verify_mod = b.createModule(.{
+        .root_source_file = b.path("tools/verify.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    verify_mod.addImport("parquet_flow", bench_lib_mod);
+
+    const verify = b.addExecutable(.{
+        .name = "pqflow_verify",
+        .root_module = verify_mod,
+    });
+    const run_verify = b.addRunArtifact(verify);
+    if (b.args) |args| run_verify.addArgs(args);
+    const verify_step = b.step("verify", "Decode Parquet files and check their row counts");
+    verify_step.dependOn(&run_verify.step);
+}
+
+/// System compression libraries used by src/parquet/compression.zig.
+fn linkCodecs(module: *std.Build.Module) void {
+    for ([_][]const u8{ "zstd", "z", "snappy", "lz4" }) |name| {
+        module.linkSystemLibrary(name, .{});
+    }
 }
@@ -41,7 +41,7 @@ pub fn main() !void {
 
     const allocator = std.heap.c_allocator;
 
-    var fw = try FileWriter.init(allocator, &COLUMNS, .UNCOMPRESSED);
+    var fw = try FileWriter.initFile(allocator, &COLUMNS, .UNCOMPRESSED, file_path);
     defer fw.deinit();
 
     var prng = std.Random.DefaultPrng.init(42);
@@ -80,7 +80,7 @@ pub fn main() !void {
         rows_written += batch_count;
     }
 
-    try fw.writeToFile(file_path);
+    _ = try fw.close();
 
     const end_ns = getTimeNs();
     const elapsed_ns = end_ns - start_ns;
@@ -5,8 +5,13 @@
  * from latency-sensitive hot paths (e.g., market data capture).
  *
  * Thread safety:
- *   - pqflow_log() is safe to call from a single producer thread
- *     concurrently with the internal consumer thread.
+ *   - pqflow_log() and pqflow_reserve()/pqflow_commit() are safe to call
+ *     from a single producer thread concurrently with the internal
+ *     consumer thread.
+ *   - Additional producer threads each call pqflow_register_producer()
+ *     once and log through their own handle (pqflow_producer_*). Every
+ *     producer has a private SPSC ring, so producers never contend.
+ *   - pqflow_log_columns() is safe from any thread.
  *   - All other functions must be called from a single thread.
  */
 
@@ -20,9 +25,11 @@
 extern "C" {
 #endif
 
-/* ---------- Opaque handle ------------------------------------------------ */
+/* ---------- Opaque handles ----------------------------------------------- */
 
 typedef struct pqflow_sink* pqflow_sink_t;
+typedef struct pqflow_producer* pqflow_producer_t;
+typedef struct pqflow_reader* pqflow_reader_t;
 
 /* ---------- Error codes -------------------------------------------------- */
 
@@ -54,8 +61,57 @@ typedef enum {
     PQFLOW_COMPRESS_SNAPPY = 1,
     PQFLOW_COMPRESS_GZIP   = 2,
     PQFLOW_COMPRESS_ZSTD   = 6,
+    PQFLOW_COMPRESS_LZ4_RAW = 7,
 } pqflow_compression;
 
+/* ---------- Column encodings --------------------------------------------- */
+
+typedef enum {
+    PQFLOW_ENCODING_DEFAULT             = 0,  /* Dictionary for byte arrays, PLAIN otherwise */
+    PQFLOW_ENCODING_PLAIN               = 1,
+    PQFLOW_ENCODING_DICTIONARY          = 2,  /* RLE_DICTIONARY, PLAIN past 1 MiB of dictionary */
+    PQFLOW_ENCODING_DELTA_BINARY_PACKED = 3,  /* I32/I64: timestamps, sequence numbers */
+    PQFLOW_ENCODING_BYTE_STREAM_SPLIT   = 4,  /* F32/F64: prices */
+} pqflow_encoding;
+
+/* ---------- Writer wait strategies --------------------------------------- */
+
+typedef enum {
+    PQFLOW_WAIT_SLEEP           = 0,  /* Poll with 50us sleeps (default) */
+    PQFLOW_WAIT_SPIN            = 1,  /* Busy-spin with pause; dedicates a core */
+    PQFLOW_WAIT_SPIN_THEN_FUTEX = 2,  /* Spin briefly, then park on a futex */
+    PQFLOW_WAIT_FUTEX           = 3,  /* Park immediately; producers wake it */
+} pqflow_wait_strategy;
+
+/* ---------- Output backends ---------------------------------------------- */
+
+typedef enum {
+    PQFLOW_OUTPUT_POSIX    = 0,  /* Blocking write() through the page cache (default) */
+    PQFLOW_OUTPUT_IO_URING = 1,  /* O_DIRECT from 4 KiB-aligned buffers via io_uring;
+                                    falls back to POSIX where unsupported */
+} pqflow_output_backend;
+
+/* ---------- Overflow policies -------------------------------------------- */
+
+/* What pqflow_log()/pqflow_reserve() do when the producer's ring is full. */
+typedef enum {
+    PQFLOW_OVERFLOW_DROP_NEWEST = 0,  /* Return PQFLOW_ERR_FULL (default) */
+    PQFLOW_OVERFLOW_BLOCK       = 1,  /* Spin, waking the writer, for up to
+                                         block_timeout_ns, then ERR_FULL */
+    PQFLOW_OVERFLOW_DROP_OLDEST = 2,  /* Evict the oldest records to make room */
+    PQFLOW_OVERFLOW_SPILL       = 3,  /* Append to a per-producer mmap'd journal
+                                         file, replayed in order once the ring drains */
+} pqflow_overflow_policy;
+
+/* ---------- Page policies ---------------------------------------------- */
+
+typedef enum {
+    PQFLOW_PAGES_DEFAULT     = 0,  /* Regular pages from the allocator */
+    PQFLOW_PAGES_TRANSPARENT = 1,  /* 2 MiB-aligned mapping with MADV_HUGEPAGE */
+    PQFLOW_PAGES_HUGETLB     = 2,  /* MAP_HUGETLB (vm.nr_hugepages); falls back to
+                                      transparent huge pages */
+} pqflow_page_policy;
+
 /* ---------- Column definition -------------------------------------------- */
 
 typedef struct {
@@ -63,18 +119,191 @@ typedef struct {
     pqflow_type    type;         /* Physical type */
     int32_t        type_length;  /* Byte length for FIXED_BYTE_ARRAY, 0 otherwise */
     int32_t        nullable;     /* 0 = required, 1 = optional */
+    pqflow_encoding encoding;    /* Value encoding; invalid type combos are rejected */
+    int32_t        bloom_filter; /* 1 = write a Bloom filter per row group (point lookups) */
+    int32_t        repeated;     /* 1 = LIST of `type` elements (not BYTE_ARRAY), e.g.
+                                    book levels; see "Record layout" below */
 } pqflow_column_def;
 
+/*
+ * Record layout: an optional null bitmap (1 bit per nullable column, in
+ * column order), then one slot per column, packed. Fixed-width columns hold
+ * their value. BYTE_ARRAY columns hold a uint32 byte length and repeated
+ * columns a uint32 element count; their bytes/elements follow the slots, in
+ * column order. A null list is written as a null; a count of 0 is an empty
+ * list.
+ */
+
 /* ---------- Sink configuration ------------------------------------------- */
 
 typedef struct {
-    const char*        file_path;          /* Output file path (null-terminated) */
-    uint32_t           ring_buffer_size;   /* Power of 2, default 1 << 20 */
-    uint32_t           batch_size;         /* Rows per batch, default 65536 */
-    uint32_t           max_rows_per_file;  /* 0 = unlimited */
-    pqflow_compression compression;        /* Compression codec */
+    const char*          file_path;          /* Output file path (null-terminated) */
+    uint32_t             ring_buffer_size;   /* Bytes, power of 2, default 1 << 22 */
+    uint32_t             batch_size;         /* Rows per batch, default 65536 */
+    uint32_t             max_rows_per_file;  /* Rotate before exceeding, 0 = unlimited */
+    pqflow_compression   compression;        /* Compression codec */
+    pqflow_wait_strategy wait_strategy;      /* Idle behavior of the writer thread */
+    uint32_t             num_encoder_threads; /* Parallel column encoders, 0 = serial */
+    int32_t              compression_level;  /* ZSTD/GZIP level, 0 = codec default */
+    uint32_t             page_size;          /* Target data page bytes, default 1 << 20 */
+    uint32_t             page_row_limit;     /* Max rows per data page, 0 = unlimited */
+    uint64_t             max_bytes_per_file; /* Rotate once reached, 0 = unlimited */
+    uint32_t             rotate_interval_sec; /* Rotate at multiples of this since the
+                                                 epoch (300 = every 5 min), 0 = never */
+    pqflow_output_backend output_backend;    /* How files reach disk */
+    uint32_t             io_queue_depth;     /* io_uring 1 MiB writes in flight, 0 = 4 */
+    pqflow_overflow_policy overflow_policy;  /* Full-ring behavior */
+    uint64_t             block_timeout_ns;   /* PQFLOW_OVERFLOW_BLOCK wait, 0 = 1 ms */
+    const char*          spill_path;         /* Journal prefix, producer i spills to
+                                                "<spill_path>.<i>"; NULL = "<file_path>.spill" */
+    uint32_t             spill_capacity;     /* Journal bytes per producer (sparse file),
+                                                power of 2 >= ring, 0 = 1 << 28 */
+    const char*          ring_path;          /* Crash-safe rings: producer i's ring is the
+                                                shared mapping of "<ring_path>.<i>" (put it
+                                                on /dev/shm); NULL = heap rings */
+    pqflow_page_policy   ring_pages;         /* Page size of heap rings */
+    uint64_t             numa_nodes;         /* Bit n = NUMA node n for rings, batch
+                                                buffers and sink threads; 0 = default */
+    int32_t              prefault;           /* 1 = fault in rings and batch buffers at
+                                                setup, not on the first burst */
+    const char*          writer_cpus;        /* CPU list ("2", "4-7,12") for the writer
+                                                thread; NULL = unpinned */
+    const char*          flush_cpus;         /* ... the flush and finalizer threads */
+    const char*          encoder_cpus;       /* ... encoder threads, one CPU each */
+    const char*          partition_column;   /* Route records by this required fixed-width
+                                                column to num_partitions outputs, each with
+                                                its own file and rotation, Hive-style:
+                                                "<dir>/<column>_bucket=<k>/<name>"; NULL = one */
+    uint32_t             num_partitions;     /* 1..24 when partition_column is set */
+    int32_t              partition_hash;     /* 0 = k is the INT32/INT64/BOOL key modulo
+                                                num_partitions; 1 = k is a hash of the
+                                                key */
 } pqflow_config;
 
+/* ---------- Runtime statistics ------------------------------------------- */
+
+/* Pipeline stages timed by the background threads; index into stages[]. */
+typedef enum {
+    PQFLOW_STAGE_DRAIN       = 0,  /* Writer thread: one pass over the rings */
+    PQFLOW_STAGE_COLUMNARIZE = 1,  /* Writer thread: records -> column buffers, per pass */
+    PQFLOW_STAGE_ENCODE      = 2,  /* Flush thread: encoding, per row group (summed
+                                      over columns, so CPU time with encoder threads) */
+    PQFLOW_STAGE_COMPRESS    = 3,  /* Flush thread: page compression, per row group */
+    PQFLOW_STAGE_WRITE       = 4,  /* Flush thread: row group bytes to the file output */
+    PQFLOW_STAGE_COUNT       = 5,
+} pqflow_stage;
+
+typedef struct {
+    uint64_t count;              /* Samples (passes or row groups) */
+    uint64_t total_ns;
+    uint64_t p50_ns;             /* Percentiles, within 1/128 of the true value */
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+} pqflow_stage_stats;
+
+typedef struct {
+    uint64_t records_logged;           /* Committed to the rings */
+    uint64_t bytes_logged;
+    uint64_t records_dropped_full;     /* PQFLOW_ERR_FULL returned */
+    uint64_t records_dropped_too_large; /* Longer than half the ring */
+    uint64_t records_written;          /* Drained into batches */
+    uint64_t batches_flushed;          /* Row groups written */
+    uint64_t write_errors;
+    uint64_t files_finalized;          /* Rotated files footered and renamed */
+    uint64_t bytes_uncompressed;       /* Column chunk bytes before compression */
+    uint64_t bytes_compressed;         /* ... and after */
+    uint64_t bytes_written;            /* Row group bytes sent to output files */
+    uint32_t num_producers;            /* Including the sink's own */
+    uint32_t ring_capacity;            /* Bytes per producer ring */
+    uint64_t ring_used_bytes;          /* Fullest ring right now */
+    uint64_t ring_high_water_bytes;    /* Fullest any ring was when drained */
+    pqflow_stage_stats stages[PQFLOW_STAGE_COUNT];
+    uint64_t records_dropped_oldest;   /* Evicted by PQFLOW_OVERFLOW_DROP_OLDEST */
+    uint64_t records_spilled;          /* Logged through the spill journal */
+    uint64_t spill_used_bytes;         /* Spilled and not yet replayed */
+    uint64_t records_recovered;        /* Left in ring files by a crashed run */
+    uint64_t column_rows_written;      /* Written by pqflow_log_columns() */
+    uint64_t rings_discarded;          /* Ring files with corrupt frames, started empty */
+    uint64_t records_rejected;         /* Drained but malformed (e.g. too short); not written */
+} pqflow_stats;
+
+/* ---------- Columnar batches --------------------------------------------- */
+
+/* Called once the sink no longer reads a batch's arrays. */
+typedef void (*pqflow_release_fn)(void* user_data);
+
+/*
+ * One column of a pqflow_column_batch, in Arrow layout. For nrows rows:
+ *   values    nrows values of the column's width back to back (BOOL: one
+ *             byte per value), null rows holding anything; BYTE_ARRAY: the
+ *             value bytes concatenated; repeated: the list elements
+ *             concatenated.
+ *   offsets   BYTE_ARRAY and repeated only: nrows + 1 offsets into values,
+ *             in bytes or elements; row i is offsets[i] .. offsets[i + 1].
+ *             NULL otherwise.
+ *   validity  Nullable columns only, or NULL for no nulls: bit i (LSB
+ *             first) set when row i is present.
+ */
+typedef struct {
+    const void*    values;
+    const int32_t* offsets;
+    const uint8_t* validity;
+} pqflow_column_data;
+
+typedef struct {
+    const pqflow_column_data* columns;  /* One per schema column, in order */
+    uint32_t                  num_columns;
+    pqflow_release_fn         release;  /* NULL: arrays are copied */
+    void*                     user_data;
+} pqflow_column_batch;
+
+/* ---------- Reading files back ------------------------------------------- */
+
+/*
+ * Which part of a file a scan reads. A NULL pqflow_read_options reads every
+ * flat column of every row group on one thread per CPU.
+ */
+typedef struct {
+    const uint32_t* row_groups;      /* Row groups in read order; NULL = all */
+    uint32_t        num_row_groups;
+    const uint32_t* columns;         /* Leaf columns by file index, in record order; NULL = all flat */
+    uint32_t        num_columns;
+    uint32_t        num_threads;     /* Decode threads; 0 = one per CPU, at most 64 */
+    /* Skip row groups whose footer min/max put an INT32/INT64 column wholly
+     * outside filter_min..filter_max (e.g. a time window). */
+    int32_t         filter_enabled;
+    uint32_t        filter_column;
+    int64_t         filter_min;
+    int64_t         filter_max;
+} pqflow_read_options;
+
+/*
+ * Called with every row of a scan in file order, rebuilt in the sink's record
+ * layout for the selected columns (see pqflow_set_schema). The record is only
+ * valid during the call. Return nonzero to stop the scan.
+ */
+typedef int (*pqflow_row_fn)(void* user_data, const uint8_t* record, uint32_t len);
+
+/*
+ * Crash recovery: with ring_path set, every committed record sits in a file
+ * mapping rather than heap memory, at the same push cost. pqflow_set_schema(),
+ * which starts the sink, reopens ring files a crashed process left behind
+ * (same ring_buffer_size and schema) and writes their records to the output
+ * before any new ones; the i-th pqflow_register_producer() call continues in
+ * ring i. Mismatched files are reset. Each ring file is locked (flock) while
+ * its sink runs, so a second sink or process with the same ring_path fails
+ * pqflow_set_schema() with PQFLOW_ERR_IO. Drained ring files are deleted on
+ * pqflow_destroy(). Records already taken from the rings into a batch, or in
+ * a file without its footer, are not covered.
+ *
+ * File rotation: when any of max_rows_per_file, max_bytes_per_file or
+ * rotate_interval_sec is set, file_path "<stem>.<ext>" becomes a series of
+ * "<stem>.000000.<ext>", "<stem>.000001.<ext>", ... Each file is written as
+ * "<name>.inprogress" and renamed once a background thread has written its
+ * footer and fsynced it, so rotation never stalls the writer thread.
+ */
+
 /* ---------- API functions ------------------------------------------------ */
 
 /*
@@ -99,17 +328,85 @@ pqflow_error pqflow_set_schema(pqflow_sink_t sink,
                                uint32_t num_columns);
 
 /*
- * Log a fixed-size binary record. Non-blocking; returns immediately.
- * If the ring buffer is full, the record is dropped and PQFLOW_ERR_FULL
- * is returned.
+ * Log a binary record. Non-blocking; returns immediately.
+ * Records are copied into the ring length-prefixed, so the cost scales with
+ * len; any len up to half of ring_buffer_size is accepted.
+ * If the ring buffer is full, config.overflow_policy decides: the record is
+ * dropped and PQFLOW_ERR_FULL returned (DROP_NEWEST; BLOCK after the
+ * timeout; DROP_OLDEST while the writer is draining the ring; SPILL once the
+ * journal is full too), older records are evicted, or it is spilled.
  *
  * @param sink    Sink handle.
  * @param record  Pointer to the binary record.
  * @param len     Length of the record in bytes.
- * @return PQFLOW_OK on success, PQFLOW_ERR_FULL if buffer is full.
+ * @return PQFLOW_OK on success, PQFLOW_ERR_FULL if the record was dropped.
  */
 pqflow_error pqflow_log(pqflow_sink_t sink, const void* record, uint32_t len);
 
+/*
+ * Reserve len bytes of ring memory for building a record in place, e.g. by
+ * decoding a packet directly into it. The record is invisible to the writer
+ * until pqflow_commit(); nothing is copied. Non-blocking.
+ * Must be called from the same thread as pqflow_log(). A second
+ * pqflow_reserve() without a commit abandons the first reservation.
+ *
+ * @param sink  Sink handle.
+ * @param len   Exact record length in bytes.
+ * @return Pointer to len writable bytes, or NULL if the ring is full, len is
+ *         0 or too large, or no schema is set.
+ */
+void* pqflow_reserve(pqflow_sink_t sink, uint32_t len);
+
+/*
+ * Publish the record claimed by the last pqflow_reserve().
+ *
+ * @param sink  Sink handle.
+ * @return PQFLOW_OK on success; PQFLOW_ERR_INVALID, publishing nothing, if
+ *         no reservation is pending (the last pqflow_reserve() returned NULL
+ *         or its record was already committed); error code otherwise.
+ */
+pqflow_error pqflow_commit(pqflow_sink_t sink);
+
+/*
+ * Log rows already laid out column by column, e.g. from an Arrow record
+ * batch. The flush thread writes them as row groups of up to batch_size
+ * rows straight from the arrays, skipping the ring and the row-to-column
+ * transpose. Safe from any thread; non-blocking. Not ordered against
+ * records logged through the rings.
+ *
+ * With batch->release set, the sink reads the arrays in place: they must
+ * stay valid until release(user_data) is called, once, from the flush
+ * thread. Without it, the arrays are copied before this returns. On any
+ * error the caller keeps the arrays and release is not called.
+ *
+ * @param sink   Sink handle.
+ * @param batch  Columns matching the schema. Must not be NULL.
+ * @param nrows  Rows in every column.
+ * @return PQFLOW_OK on success, PQFLOW_ERR_FULL while 16 batches are still
+ *         queued, PQFLOW_ERR_INVALID if the batch does not match the schema
+ *         or the sink is partitioned (partition_column).
+ */
+pqflow_error pqflow_log_columns(pqflow_sink_t sink, const pqflow_column_batch* batch, uint32_t nrows);
+
+/*
+ * Register a producer thread. The returned handle owns a private SPSC ring
+ * (ring_buffer_size bytes) that the writer thread drains round-robin with
+ * all others, so logging through it never contends with other producers.
+ * Safe to call from any thread after pqflow_set_schema(). The handle stays
+ * valid until pqflow_destroy() or the next pqflow_set_schema(), and must be
+ * used by one thread at a time.
+ *
+ * @param sink  Sink handle.
+ * @return Producer handle, or NULL if no schema is set, too many producers
+ *         (64) are registered, or allocation fails.
+ */
+pqflow_producer_t pqflow_register_producer(pqflow_sink_t sink);
+
+/* pqflow_log() / pqflow_reserve() / pqflow_commit() on a producer handle. */
+pqflow_error pqflow_producer_log(pqflow_producer_t producer, const void* record, uint32_t len);
+void*        pqflow_producer_reserve(pqflow_producer_t producer, uint32_t len);
+pqflow_error pqflow_producer_commit(pqflow_producer_t producer);
+
 /*
  * Flush buffered records to disk. Blocks until the current batch is written.
  *
@@ -118,6 +415,30 @@ pqflow_error pqflow_log(pqflow_sink_t sink, const void* record, uint32_t len);
  */
 pqflow_error pqflow_flush(pqflow_sink_t sink);
 
+/*
+ * Finish the current file and continue in the next one, e.g. at session
+ * close. Every record logged before the call lands in the finished file.
+ * Non-blocking; a no-op unless rotation is configured.
+ *
+ * @param sink  Sink handle.
+ * @return PQFLOW_OK on success, error code otherwise.
+ */
+pqflow_error pqflow_rotate(pqflow_sink_t sink);
+
+/*
+ * Snapshot the sink's counters and stage timings. Lock-free and safe from
+ * any thread: producers count into their own cache lines with plain stores,
+ * and this only reads them. Counters are read one at a time, so they may be
+ * a few records apart. Alert on ring_used_bytes (or ring_high_water_bytes)
+ * approaching ring_capacity before records_dropped_full starts to grow.
+ * Counters restart when pqflow_set_schema() replaces the sink.
+ *
+ * @param sink  Sink handle.
+ * @param out   Receives the snapshot. Must not be NULL.
+ * @return PQFLOW_OK on success, PQFLOW_ERR_SCHEMA if no schema is set.
+ */
+pqflow_error pqflow_get_stats(pqflow_sink_t sink, pqflow_stats* out);
+
 /*
  * Destroy the sink. Flushes remaining data and frees all resources.
  * Safe to call with NULL (no-op).
@@ -126,6 +447,57 @@ pqflow_error pqflow_flush(pqflow_sink_t sink);
  */
 void pqflow_destroy(pqflow_sink_t sink);
 
+/*
+ * Open a Parquet file to read back, e.g. one the sink wrote. Reads the
+ * footer only; pqflow_reader_scan() decodes selected row groups on a pool
+ * of threads. Columns inside a LIST are listed but cannot be scanned, and
+ * DELTA_BINARY_PACKED columns fail to decode (PQFLOW_ERR_IO).
+ *
+ * @param out   Receives the reader handle.
+ * @param path  File path.
+ * @return PQFLOW_OK on success, PQFLOW_ERR_IO if the file cannot be read.
+ */
+pqflow_error pqflow_reader_open(pqflow_reader_t* out, const char* path);
+
+/* Footer counts: row groups, rows and leaf columns of the file. */
+uint32_t pqflow_reader_num_row_groups(pqflow_reader_t reader);
+uint64_t pqflow_reader_num_rows(pqflow_reader_t reader);
+uint32_t pqflow_reader_num_columns(pqflow_reader_t reader);
+
+/*
+ * Decode the row groups and columns `opts` selects and call `fn` with every
+ * row, in order. Row groups are decoded in parallel, a few ahead of the one
+ * being delivered. With `fn` NULL the columns are only decoded and their row
+ * counts checked, which verifies the file.
+ *
+ * @param reader     Reader handle.
+ * @param opts       Selection, or NULL for all.
+ * @param fn         Row callback, or NULL.
+ * @param user_data  Passed to fn.
+ * @return PQFLOW_OK on success (also when fn stops the scan),
+ *         PQFLOW_ERR_INVALID for a bad row group, column or filter,
+ *         PQFLOW_ERR_IO if decoding fails.
+ */
+pqflow_error pqflow_reader_scan(pqflow_reader_t reader, const pqflow_read_options* opts,
+                                pqflow_row_fn fn, void* user_data);
+
+/*
+ * pqflow_reader_scan() into pqflow_log(): replay a capture into a sink whose
+ * schema matches the selected columns. Waits for ring room whatever the
+ * sink's overflow_policy, so no row is dropped, evicts an older record,
+ * spills or counts in records_dropped_full.
+ *
+ * @return As pqflow_reader_scan(); PQFLOW_ERR_SCHEMA if the sink has no
+ *         schema, PQFLOW_ERR_INVALID if a record is too large for its ring.
+ */
+pqflow_error pqflow_reader_replay(pqflow_reader_t reader, const pqflow_read_options* opts,
+                                  pqflow_sink_t sink);
+
+/*
+ * Close the reader. Safe to call with NULL (no-op).
+ */
+void pqflow_reader_close(pqflow_reader_t reader);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,6 +3,8 @@ const types = @import("parquet/types.zig");
 const schema_mod = @import("parquet/schema.zig");
 const log_sink = @import("sink/log_sink.zig");
 const batch_mod = @import("sink/batch.zig");
+const placement = @import("placement.zig");
+const reader_mod = @import("reader.zig");
 
 // ---------------------------------------------------------------------------
 // C-compatible struct definitions (must match include/parquet_flow.h)
@@ -32,6 +34,7 @@ pub const PqflowCompression = enum(i32) {
     SNAPPY = 1,
     GZIP = 2,
     ZSTD = 6,
+    LZ4_RAW = 7,
 };
 
 pub const PqflowColumnDef = extern struct {
@@ -39,6 +42,11 @@ pub const PqflowColumnDef = extern struct {
     type: PqflowType,
     type_length: i32,
     nullable: i32,
+    /// pqflow_encoding; raw int, validated in pqflow_set_schema.
+    encoding: i32,
+    bloom_filter: i32,
+    /// Nonzero: a LIST of `type` elements (fixed-width types only).
+    repeated: i32,
 };
 
 pub const PqflowConfig = extern struct {
@@ -47,8 +55,105 @@ pub const PqflowConfig = extern struct {
     batch_size: u32,
     max_rows_per_file: u32,
     compression: PqflowCompression,
+    /// pqflow_wait_strategy; kept as a raw int so out-of-range values from C
+    /// are rejected instead of producing an invalid enum.
+    wait_strategy: i32,
+    num_encoder_threads: u32,
+    compression_level: i32,
+    page_size: u32,
+    page_row_limit: u32,
+    max_bytes_per_file: u64,
+    rotate_interval_sec: u32,
+    /// pqflow_output_backend; raw int like wait_strategy.
+    output_backend: i32,
+    io_queue_depth: u32,
+    /// pqflow_overflow_policy; raw int like wait_strategy.
+    overflow_policy: i32,
+    block_timeout_ns: u64,
+    spill_path: ?[*:0]const u8,
+    spill_capacity: u32,
+    ring_path: ?[*:0]const u8,
+    /// pqflow_page_policy; raw int like wait_strategy.
+    ring_pages: i32,
+    numa_nodes: u64,
+    prefault: i32,
+    writer_cpus: ?[*:0]const u8,
+    flush_cpus: ?[*:0]const u8,
+    encoder_cpus: ?[*:0]const u8,
+    partition_column: ?[*:0]const u8,
+    num_partitions: u32,
+    partition_hash: i32,
 };
 
+pub const PQFLOW_STAGE_COUNT = 5;
+
+pub const PqflowStageStats = extern struct {
+    count: u64,
+    total_ns: u64,
+    p50_ns: u64,
+    p99_ns: u64,
+    p999_ns: u64,
+    max_ns: u64,
+};
+
+pub const PqflowStats = extern struct {
+    records_logged: u64,
+    bytes_logged: u64,
+    records_dropped_full: u64,
+    records_dropped_too_large: u64,
+    records_written: u64,
+    batches_flushed: u64,
+    write_errors: u64,
+    files_finalized: u64,
+    bytes_uncompressed: u64,
+    bytes_compressed: u64,
+    bytes_written: u64,
+    num_producers: u32,
+    ring_capacity: u32,
+    ring_used_bytes: u64,
+    ring_high_water_bytes: u64,
+    /// Indexed by pqflow_stage.
+    stages: [PQFLOW_STAGE_COUNT]PqflowStageStats,
+    records_dropped_oldest: u64,
+    records_spilled: u64,
+    spill_used_bytes: u64,
+    records_recovered: u64,
+    column_rows_written: u64,
+    rings_discarded: u64,
+    records_rejected: u64,
+};
+
+pub const PqflowColumnData = extern struct {
+    values: ?*const anyopaque,
+    offsets: ?[*]const i32,
+    validity: ?[*]const u8,
+};
+
+pub const PqflowColumnBatch = extern struct {
+    columns: ?[*]const PqflowColumnData,
+    num_columns: u32,
+    release: ?log_sink.ReleaseFn,
+    user_data: ?*anyopaque,
+};
+
+pub const PqflowReadOptions = extern struct {
+    row_groups: ?[*]const u32,
+    num_row_groups: u32,
+    columns: ?[*]const u32,
+    num_columns: u32,
+    num_threads: u32,
+    filter_enabled: i32,
+    filter_column: u32,
+    filter_min: i64,
+    filter_max: i64,
+};
+
+pub const PqflowRowFn = *const fn (user_data: ?*anyopaque, record: [*]const u8, len: u32) callconv(.c) c_int;
+
+comptime {
+    std.debug.assert(PQFLOW_STAGE_COUNT == @typeInfo(log_sink.Stage).@"enum".fields.len);
+}
+
 // ---------------------------------------------------------------------------
 // Internal sink wrapper
 // ---------------------------------------------------------------------------
@@ -56,9 +161,34 @@ pub const PqflowConfig = extern struct {
 const SinkState = struct {
     sink: ?*log_sink.LogSink,
     allocator: std.mem.Allocator,
-    file_path: []const u8,
+    file_path: [:0]const u8,
     batch_size: u32,
+    ring_capacity: u32,
     compression: PqflowCompression,
+    compression_level: i32,
+    page_size: u32,
+    page_row_limit: u32,
+    max_rows_per_file: u32,
+    max_bytes_per_file: u64,
+    rotate_interval_sec: u32,
+    wait_strategy: log_sink.WaitStrategy,
+    num_encoder_threads: u32,
+    output_backend: log_sink.OutputBackend,
+    io_queue_depth: u32,
+    overflow_policy: log_sink.OverflowPolicy,
+    block_timeout_ns: u64,
+    spill_path: ?[:0]const u8,
+    spill_capacity: u32,
+    ring_path: ?[:0]const u8,
+    ring_pages: log_sink.PagePolicy,
+    numa_nodes: u64,
+    prefault: bool,
+    writer_cpus: ?[:0]const u8,
+    flush_cpus: ?[:0]const u8,
+    encoder_cpus: ?[:0]const u8,
+    partition_column: ?[:0]const u8,
+    num_partitions: u32,
+    partition_hash: bool,
     // Owned copies of schema data that must outlive the sink
     column_defs: []batch_mod.ColumnDef,
 };
@@ -74,6 +204,20 @@ fn toHandle(state: *SinkState) *SinkHandle {
     return @ptrCast(state);
 }
 
+// Opaque per-thread producer handle exposed to C.
+const ProducerHandle = opaque {};
+
+fn toProducer(handle: *ProducerHandle) *log_sink.Producer {
+    return @ptrCast(@alignCast(handle));
+}
+
+fn mapLogError(err: log_sink.LogError) i32 {
+    return switch (err) {
+        log_sink.LogError.BufferFull => @intFromEnum(PqflowError.ERR_FULL),
+        log_sink.LogError.RecordTooLarge => @intFromEnum(PqflowError.ERR_INVALID),
+    };
+}
+
 // ---------------------------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------------------------
@@ -82,6 +226,76 @@ fn mapPhysicalTypeToBatch(t: PqflowType) batch_mod.PhysicalType {
     return @enumFromInt(@intFromEnum(t));
 }
 
+fn mapCompression(c: PqflowCompression) types.CompressionCodec {
+    return @enumFromInt(@intFromEnum(c));
+}
+
+fn mapWaitStrategy(w: i32) ?log_sink.WaitStrategy {
+    return switch (w) {
+        0 => .sleep,
+        1 => .spin,
+        2 => .spin_then_futex,
+        3 => .futex,
+        else => null,
+    };
+}
+
+fn mapOverflowPolicy(p: i32) ?log_sink.OverflowPolicy {
+    return switch (p) {
+        0 => .drop_newest,
+        1 => .block,
+        2 => .drop_oldest,
+        3 => .spill,
+        else => null,
+    };
+}
+
+fn mapPagePolicy(p: i32) ?log_sink.PagePolicy {
+    return switch (p) {
+        0 => .default,
+        1 => .transparent,
+        2 => .hugetlb,
+        else => null,
+    };
+}
+
+/// Owned copy of an optional C string.
+fn dupeOptional(allocator: std.mem.Allocator, str: ?[*:0]const u8) !?[:0]const u8 {
+    const s = str orelse return null;
+    return try allocator.dupeZ(u8, std.mem.span(s));
+}
+
+fn freeOptional(allocator: std.mem.Allocator, str: ?[:0]const u8) void {
+    if (str) |s| allocator.free(s);
+}
+
+/// Whether `list` is null or a valid CPU list.
+fn validCpuList(list: ?[*:0]const u8) bool {
+    const l = list orelse return true;
+    _ = placement.CpuSet.parse(std.mem.span(l)) catch return false;
+    return true;
+}
+
+fn mapOutputBackend(b: i32) ?log_sink.OutputBackend {
+    return switch (b) {
+        0 => .posix,
+        1 => .io_uring,
+        else => null,
+    };
+}
+
+/// Validate a pqflow_encoding against the column type.
+fn mapEncoding(e: i32, t: PqflowType) ?batch_mod.ColumnEncoding {
+    return switch (e) {
+        0 => .default,
+        1 => .plain,
+        2 => if (t != .BOOL) .dictionary else null,
+        3 => if (t == .I32 or t == .I64) .delta_binary_packed else null,
+        4 => if (t == .F32 or t == .F64) .byte_stream_split else null,
+        else => null,
+    };
+}
+
 /// Get the byte size of a physical type.
 fn physicalTypeSize(t: PqflowType, type_length: i32) u32 {
     return switch (t) {
@@ -112,13 +326,78 @@ fn createImpl(out: *?*SinkHandle, config: *const PqflowConfig) !i32 {
     else
         return @intFromEnum(PqflowError.ERR_INVALID);
 
+    const ring_capacity = if (config.ring_buffer_size != 0) config.ring_buffer_size else log_sink.RING_CAPACITY;
+    if (!std.math.isPowerOfTwo(ring_capacity) or ring_capacity < 128) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    const wait_strategy = mapWaitStrategy(config.wait_strategy) orelse
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    const output_backend = mapOutputBackend(config.output_backend) orelse
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    const overflow_policy = mapOverflowPolicy(config.overflow_policy) orelse
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    const spill_capacity = if (config.spill_capacity != 0) config.spill_capacity else log_sink.DEFAULT_SPILL_CAPACITY;
+    if (overflow_policy == .spill and (!std.math.isPowerOfTwo(spill_capacity) or spill_capacity < ring_capacity)) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    const owned_path = try allocator.dupeZ(u8, file_path);
+    errdefer allocator.free(owned_path);
+    const ring_pages = mapPagePolicy(config.ring_pages) orelse
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    if (!validCpuList(config.writer_cpus) or !validCpuList(config.flush_cpus) or !validCpuList(config.encoder_cpus)) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+    if (config.partition_column != null and (config.num_partitions == 0 or config.num_partitions > log_sink.MAX_PARTITIONS)) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    const owned_spill_path = try dupeOptional(allocator, config.spill_path);
+    errdefer freeOptional(allocator, owned_spill_path);
+    const owned_ring_path = try dupeOptional(allocator, config.ring_path);
+    errdefer freeOptional(allocator, owned_ring_path);
+    const writer_cpus = try dupeOptional(allocator, config.writer_cpus);
+    errdefer freeOptional(allocator, writer_cpus);
+    const flush_cpus = try dupeOptional(allocator, config.flush_cpus);
+    errdefer freeOptional(allocator, flush_cpus);
+    const encoder_cpus = try dupeOptional(allocator, config.encoder_cpus);
+    errdefer freeOptional(allocator, encoder_cpus);
+    const partition_column = try dupeOptional(allocator, config.partition_column);
+    errdefer freeOptional(allocator, partition_column);
+
     const state = try allocator.create(SinkState);
     state.* = .{
         .sink = null,
         .allocator = allocator,
-        .file_path = file_path,
+        .file_path = owned_path,
         .batch_size = if (config.batch_size != 0) config.batch_size else 65536,
+        .ring_capacity = ring_capacity,
         .compression = config.compression,
+        .compression_level = config.compression_level,
+        .page_size = if (config.page_size != 0) config.page_size else log_sink.PAGE_SIZE,
+        .page_row_limit = config.page_row_limit,
+        .max_rows_per_file = config.max_rows_per_file,
+        .max_bytes_per_file = config.max_bytes_per_file,
+        .rotate_interval_sec = config.rotate_interval_sec,
+        .wait_strategy = wait_strategy,
+        .num_encoder_threads = config.num_encoder_threads,
+        .output_backend = output_backend,
+        .io_queue_depth = config.io_queue_depth,
+        .overflow_policy = overflow_policy,
+        .block_timeout_ns = config.block_timeout_ns,
+        .spill_path = owned_spill_path,
+        .spill_capacity = spill_capacity,
+        .ring_path = owned_ring_path,
+        .ring_pages = ring_pages,
+        .numa_nodes = config.numa_nodes,
+        .prefault = config.prefault != 0,
+        .writer_cpus = writer_cpus,
+        .flush_cpus = flush_cpus,
+        .encoder_cpus = encoder_cpus,
+        .partition_column = partition_column,
+        .num_partitions = config.num_partitions,
+        .partition_hash = config.partition_hash != 0,
         .column_defs = &.{},
     };
 
@@ -131,7 +410,10 @@ export fn pqflow_set_schema(
     columns: [*]const PqflowColumnDef,
     num_columns: u32,
 ) callconv(.c) i32 {
-    return setSchemaImpl(handle, columns, num_columns) catch @intFromEnum(PqflowError.ERR_SCHEMA);
+    return setSchemaImpl(handle, columns, num_columns) catch |err| switch (err) {
+        error.FileOpenFailed, error.FileWriteFailed, error.RingFileLocked => @intFromEnum(PqflowError.ERR_IO),
+        else => @intFromEnum(PqflowError.ERR_SCHEMA),
+    };
 }
 
 fn setSchemaImpl(
@@ -163,7 +445,17 @@ fn setSchemaImpl(
 
     for (0..num_columns) |i| {
         const c = columns[i];
-        const size = physicalTypeSize(c.type, c.type_length);
+        const repeated = c.repeated != 0;
+        // A list's slot holds its element count, like a BYTE_ARRAY length
+        const size = if (repeated) 4 else physicalTypeSize(c.type, c.type_length);
+        const col_encoding = mapEncoding(c.encoding, c.type) orelse {
+            allocator.free(col_defs);
+            return @intFromEnum(PqflowError.ERR_INVALID);
+        };
+        if (repeated and c.type == .BYTE_ARRAY) {
+            allocator.free(col_defs);
+            return @intFromEnum(PqflowError.ERR_INVALID);
+        }
         col_defs[i] = .{
             .name = std.mem.span(c.name),
             .physical_type = mapPhysicalTypeToBatch(c.type),
@@ -171,6 +463,9 @@ fn setSchemaImpl(
             .nullable = c.nullable != 0,
             .offset = offset,
             .size = size,
+            .encoding = col_encoding,
+            .bloom_filter = c.bloom_filter != 0,
+            .repeated = repeated,
         };
         offset += size;
     }
@@ -185,18 +480,47 @@ fn setSchemaImpl(
     const sink_config = log_sink.SinkConfig{
         .batch_size = state.batch_size,
         .file_path = state.file_path,
+        .codec = mapCompression(state.compression),
+        .compression_level = state.compression_level,
+        .page_size = state.page_size,
+        .page_row_limit = state.page_row_limit,
+        .max_rows_per_file = state.max_rows_per_file,
+        .max_bytes_per_file = state.max_bytes_per_file,
+        .rotate_interval_ns = @as(u64, state.rotate_interval_sec) * std.time.ns_per_s,
+        .ring_capacity = state.ring_capacity,
+        .wait_strategy = state.wait_strategy,
+        .num_encoder_threads = state.num_encoder_threads,
+        .output_backend = state.output_backend,
+        .io_queue_depth = state.io_queue_depth,
+        .overflow_policy = state.overflow_policy,
+        .block_timeout_ns = state.block_timeout_ns,
+        .spill_path = state.spill_path,
+        .spill_capacity = state.spill_capacity,
+        .ring_path = state.ring_path,
+        .ring_pages = state.ring_pages,
+        .numa_nodes = state.numa_nodes,
+        .prefault = state.prefault,
+        .writer_cpus = state.writer_cpus,
+        .flush_cpus = state.flush_cpus,
+        .encoder_cpus = state.encoder_cpus,
+        .partition_column = state.partition_column,
+        .num_partitions = state.num_partitions,
+        .partition_hash = state.partition_hash,
     };
 
-    const sink = try log_sink.LogSink.init(sink_config, schema_info, allocator);
-
-    // Clean up old state if re-setting schema
+    // Clean up old state if re-setting schema. The old sink is finalized
+    // first so the new one can reopen the same path.
     if (state.sink) |old_sink| {
         old_sink.deinit();
+        state.sink = null;
     }
     if (state.column_defs.len > 0) {
         allocator.free(state.column_defs);
+        state.column_defs = &.{};
     }
 
+    const sink = try log_sink.LogSink.init(sink_config, schema_info, allocator);
+
     state.column_defs = col_defs;
     state.sink = sink;
 
@@ -216,16 +540,130 @@ export fn pqflow_log(
         return @intFromEnum(PqflowError.ERR_INVALID);
     }
 
-    sink.log(record[0..len]) catch |err| {
-        return switch (err) {
-            log_sink.LogError.BufferFull => @intFromEnum(PqflowError.ERR_FULL),
-            log_sink.LogError.RecordTooLarge => @intFromEnum(PqflowError.ERR_INVALID),
-        };
+    sink.log(record[0..len]) catch |err| return mapLogError(err);
+
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_log_columns(
+    handle: ?*SinkHandle,
+    batch: ?*const PqflowColumnBatch,
+    nrows: u32,
+) callconv(.c) i32 {
+    const sink_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const src = batch orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return @intFromEnum(PqflowError.ERR_SCHEMA);
+
+    const c_columns = src.columns orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    if (src.num_columns != state.column_defs.len) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    const columns = state.allocator.alloc(log_sink.ColumnData, src.num_columns) catch
+        return @intFromEnum(PqflowError.ERR_IO);
+    defer state.allocator.free(columns);
+    for (state.column_defs, c_columns[0..src.num_columns], columns) |def, c, *col| {
+        col.* = columnData(def, c, nrows) orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    sink.logColumns(.{
+        .columns = columns,
+        .num_rows = nrows,
+        .release = src.release,
+        .user_data = src.user_data,
+    }) catch |err| return switch (err) {
+        error.BufferFull => @intFromEnum(PqflowError.ERR_FULL),
+        error.InvalidColumns => @intFromEnum(PqflowError.ERR_INVALID),
+        error.OutOfMemory => @intFromEnum(PqflowError.ERR_IO),
     };
 
     return @intFromEnum(PqflowError.OK);
 }
 
+/// Slices over one C column of `nrows` rows, sized from the schema (and,
+/// for BYTE_ARRAY and repeated columns, from the last offset). Null if a
+/// needed array is missing.
+fn columnData(def: batch_mod.ColumnDef, c: PqflowColumnData, nrows: u32) ?log_sink.ColumnData {
+    const values: [*]const u8 = if (c.values) |v| @ptrCast(v) else if (nrows == 0) &[_]u8{} else return null;
+    var col = log_sink.ColumnData{ .values = undefined };
+    if (def.inTail()) {
+        const offsets = c.offsets orelse return null;
+        const end = offsets[nrows];
+        if (end < 0) return null;
+        const unit: usize = if (def.repeated) def.elementSize() else 1;
+        col.values = values[0 .. @as(usize, @intCast(end)) * unit];
+        col.offsets = offsets[0 .. @as(usize, nrows) + 1];
+    } else {
+        col.values = values[0 .. @as(usize, nrows) * def.size];
+    }
+    if (c.validity) |validity| col.validity = validity[0 .. (@as(usize, nrows) + 7) / 8];
+    return col;
+}
+
+export fn pqflow_reserve(handle: ?*SinkHandle, len: u32) callconv(.c) ?*anyopaque {
+    const sink_handle = handle orelse return null;
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return null;
+
+    if (len == 0) return null;
+
+    const dest = sink.reserve(len) catch return null;
+    return dest.ptr;
+}
+
+export fn pqflow_commit(handle: ?*SinkHandle) callconv(.c) i32 {
+    const sink_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return @intFromEnum(PqflowError.ERR_SCHEMA);
+
+    sink.commit() catch return @intFromEnum(PqflowError.ERR_INVALID);
+
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_register_producer(handle: ?*SinkHandle) callconv(.c) ?*ProducerHandle {
+    const sink_handle = handle orelse return null;
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return null;
+
+    const producer = sink.registerProducer() catch return null;
+    return @ptrCast(producer);
+}
+
+export fn pqflow_producer_log(
+    handle: ?*ProducerHandle,
+    record: [*]const u8,
+    len: u32,
+) callconv(.c) i32 {
+    const producer_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+
+    if (len == 0) {
+        return @intFromEnum(PqflowError.ERR_INVALID);
+    }
+
+    toProducer(producer_handle).log(record[0..len]) catch |err| return mapLogError(err);
+
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_producer_reserve(handle: ?*ProducerHandle, len: u32) callconv(.c) ?*anyopaque {
+    const producer_handle = handle orelse return null;
+
+    if (len == 0) return null;
+
+    const dest = toProducer(producer_handle).reserve(len) catch return null;
+    return dest.ptr;
+}
+
+export fn pqflow_producer_commit(handle: ?*ProducerHandle) callconv(.c) i32 {
+    const producer_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+
+    toProducer(producer_handle).commit() catch return @intFromEnum(PqflowError.ERR_INVALID);
+
+    return @intFromEnum(PqflowError.OK);
+}
+
 export fn pqflow_flush(handle: ?*SinkHandle) callconv(.c) i32 {
     const sink_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
     const state = toState(sink_handle);
@@ -236,6 +674,62 @@ export fn pqflow_flush(handle: ?*SinkHandle) callconv(.c) i32 {
     return @intFromEnum(PqflowError.OK);
 }
 
+export fn pqflow_rotate(handle: ?*SinkHandle) callconv(.c) i32 {
+    const sink_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return @intFromEnum(PqflowError.ERR_SCHEMA);
+
+    sink.rotate();
+
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_get_stats(handle: ?*SinkHandle, out: ?*PqflowStats) callconv(.c) i32 {
+    const sink_handle = handle orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const dest = out orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const state = toState(sink_handle);
+    const sink = state.sink orelse return @intFromEnum(PqflowError.ERR_SCHEMA);
+
+    const s = sink.stats();
+    dest.* = .{
+        .records_logged = s.records_logged,
+        .bytes_logged = s.bytes_logged,
+        .records_dropped_full = s.records_dropped_full,
+        .records_dropped_too_large = s.records_dropped_too_large,
+        .records_written = s.records_written,
+        .batches_flushed = s.batches_flushed,
+        .write_errors = s.write_errors,
+        .files_finalized = s.files_finalized,
+        .bytes_uncompressed = s.bytes_uncompressed,
+        .bytes_compressed = s.bytes_compressed,
+        .bytes_written = s.bytes_written,
+        .num_producers = s.num_producers,
+        .ring_capacity = s.ring_capacity,
+        .ring_used_bytes = s.ring_used_bytes,
+        .ring_high_water_bytes = s.ring_high_water_bytes,
+        .stages = undefined,
+        .records_dropped_oldest = s.records_dropped_oldest,
+        .records_spilled = s.records_spilled,
+        .spill_used_bytes = s.spill_used_bytes,
+        .records_recovered = s.records_recovered,
+        .column_rows_written = s.column_rows_written,
+        .rings_discarded = s.rings_discarded,
+        .records_rejected = s.records_rejected,
+    };
+    for (s.stages, &dest.stages) |stage, *d| {
+        d.* = .{
+            .count = stage.count,
+            .total_ns = stage.total_ns,
+            .p50_ns = stage.p50_ns,
+            .p99_ns = stage.p99_ns,
+            .p999_ns = stage.p999_ns,
+            .max_ns = stage.max_ns,
+        };
+    }
+
+    return @intFromEnum(PqflowError.OK);
+}
+
 export fn pqflow_destroy(handle: ?*SinkHandle) callconv(.c) void {
     const sink_handle = handle orelse return;
     const state = toState(sink_handle);
@@ -249,5 +743,124 @@ export fn pqflow_destroy(handle: ?*SinkHandle) callconv(.c) void {
         allocator.free(state.column_defs);
     }
 
+    allocator.free(state.file_path);
+    freeOptional(allocator, state.spill_path);
+    freeOptional(allocator, state.ring_path);
+    freeOptional(allocator, state.writer_cpus);
+    freeOptional(allocator, state.flush_cpus);
+    freeOptional(allocator, state.encoder_cpus);
+    freeOptional(allocator, state.partition_column);
     allocator.destroy(state);
 }
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+// Opaque reader handle exposed to C.
+const ReaderHandle = opaque {};
+
+fn toReader(handle: *ReaderHandle) *reader_mod.Reader {
+    return @ptrCast(@alignCast(handle));
+}
+
+export fn pqflow_reader_open(out: *?*ReaderHandle, path: ?[*:0]const u8) callconv(.c) i32 {
+    const p = path orelse return @intFromEnum(PqflowError.ERR_INVALID);
+    const r = reader_mod.Reader.open(std.heap.c_allocator, std.mem.span(p)) catch
+        return @intFromEnum(PqflowError.ERR_IO);
+    out.* = @ptrCast(r);
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_reader_num_row_groups(handle: ?*ReaderHandle) callconv(.c) u32 {
+    return toReader(handle orelse return 0).numRowGroups();
+}
+
+export fn pqflow_reader_num_rows(handle: ?*ReaderHandle) callconv(.c) u64 {
+    return toReader(handle orelse return 0).numRows();
+}
+
+export fn pqflow_reader_num_columns(handle: ?*ReaderHandle) callconv(.c) u32 {
+    return @intCast(toReader(handle orelse return 0).columns.len);
+}
+
+fn mapReadOptions(opts: ?*const PqflowReadOptions) reader_mod.ReadOptions {
+    const o = opts orelse return .{};
+    return .{
+        .row_groups = if (o.row_groups) |rg| rg[0..o.num_row_groups] else null,
+        .columns = if (o.columns) |c| c[0..o.num_columns] else null,
+        .filter = if (o.filter_enabled != 0) .{
+            .column = o.filter_column,
+            .min = o.filter_min,
+            .max = o.filter_max,
+        } else null,
+        .num_threads = o.num_threads,
+    };
+}
+
+fn mapReadError(err: anyerror) i32 {
+    return switch (err) {
+        error.UnsupportedColumn, error.InvalidRowGroup, error.InvalidFilter => @intFromEnum(PqflowError.ERR_INVALID),
+        else => @intFromEnum(PqflowError.ERR_IO),
+    };
+}
+
+const RowCallback = struct {
+    f: PqflowRowFn,
+    user_data: ?*anyopaque,
+
+    fn onRow(self: *const RowCallback, record: []const u8) bool {
+        return self.f(self.user_data, record.ptr, @intCast(record.len)) == 0;
+    }
+};
+
+export fn pqflow_reader_scan(
+    handle: ?*ReaderHandle,
+    opts: ?*const PqflowReadOptions,
+    f: ?PqflowRowFn,
+    user_data: ?*anyopaque,
+) callconv(.c) i32 {
+    const r = toReader(handle orelse return @intFromEnum(PqflowError.ERR_INVALID));
+    const options = mapReadOptions(opts);
+    if (f) |row_fn| {
+        const callback = RowCallback{ .f = row_fn, .user_data = user_data };
+        _ = r.scan(options, &callback, RowCallback.onRow) catch |err| return mapReadError(err);
+    } else {
+        _ = r.scan(options, {}, null) catch |err| return mapReadError(err);
+    }
+    return @intFromEnum(PqflowError.OK);
+}
+
+/// Logs every row into a sink, waiting while its ring is full rather than
+/// going through the overflow policy (see `LogSink.logWait`).
+const Replay = struct {
+    sink: *log_sink.LogSink,
+    err: ?log_sink.LogError = null,
+
+    fn onRow(self: *Replay, record: []const u8) bool {
+        self.sink.logWait(record) catch |err| {
+            self.err = err;
+            return false;
+        };
+        return true;
+    }
+};
+
+export fn pqflow_reader_replay(
+    handle: ?*ReaderHandle,
+    opts: ?*const PqflowReadOptions,
+    sink_handle: ?*SinkHandle,
+) callconv(.c) i32 {
+    const r = toReader(handle orelse return @intFromEnum(PqflowError.ERR_INVALID));
+    const state = toState(sink_handle orelse return @intFromEnum(PqflowError.ERR_INVALID));
+    const sink = state.sink orelse return @intFromEnum(PqflowError.ERR_SCHEMA);
+
+    var replay = Replay{ .sink = sink };
+    _ = r.scan(mapReadOptions(opts), &replay, Replay.onRow) catch |err| return mapReadError(err);
+    if (replay.err) |err| return mapLogError(err);
+    return @intFromEnum(PqflowError.OK);
+}
+
+export fn pqflow_reader_close(handle: ?*ReaderHandle) callconv(.c) void {
+    toReader(handle orelse return).close();
+}
@@ -0,0 +1,34 @@
+const std = @import("std");
+const linux = std.os.linux;
+
+// Thin wrappers over the Linux futex syscall (private, process-local).
+
+const FUTEX_WAIT: usize = 0;
+const FUTEX_WAKE: usize = 1;
+const FUTEX_PRIVATE_FLAG: usize = 128;
+
+/// Block while `word` still holds `expected`, for at most `timeout_ns`.
+/// Returns early on wake, signal or spurious wakeup; callers re-check state.
+pub fn wait(word: *const std.atomic.Value(u32), expected: u32, timeout_ns: u64) void {
+    var ts = linux.timespec{
+        .sec = @intCast(timeout_ns / std.time.ns_per_s),
+        .nsec = @intCast(timeout_ns % std.time.ns_per_s),
+    };
+    _ = linux.syscall4(
+        .futex,
+        @intFromPtr(&word.raw),
+        FUTEX_WAIT | FUTEX_PRIVATE_FLAG,
+        expected,
+        @intFromPtr(&ts),
+    );
+}
+
+/// Wake up to `count` threads blocked in `wait` on `word`.
+pub fn wake(word: *const std.atomic.Value(u32), count: u32) void {
+    _ = linux.syscall3(
+        .futex,
+        @intFromPtr(&word.raw),
+        FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+        count,
+    );
+}
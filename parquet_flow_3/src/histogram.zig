@@ -0,0 +1,217 @@
+const std = @import("std");
+
+/// Sub-buckets per power of two: values are kept to 1/128 (under 0.8%)
+/// relative precision, and exactly below 128.
+pub const SUB_BUCKET_BITS = 7;
+const SUB_BUCKETS: u64 = 1 << SUB_BUCKET_BITS;
+
+/// Buckets covering the whole u64 range.
+pub const NUM_BUCKETS: usize = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+/// HDR-style log-linear histogram of u64 samples (latencies in ticks or ns).
+/// Each power of two is split into `SUB_BUCKETS` linear buckets, so
+/// recording is a bit scan and an increment, and any quantile is reported
+/// to within 1/128 of the true value however wide the range.
+///
+/// Single writer. Merge per-thread histograms with `merge()` to report them
+/// together, or write with `recordShared()` and read with
+/// `sharedPercentiles()` while the writer runs. About 58 KiB, so allocate it
+/// rather than keep it on the stack.
+pub const Histogram = struct {
+    counts: [NUM_BUCKETS]u64,
+    total: u64,
+    sum: u64,
+    min: u64,
+    max: u64,
+
+    pub const empty: Histogram = .{
+        .counts = @splat(0),
+        .total = 0,
+        .sum = 0,
+        .min = std.math.maxInt(u64),
+        .max = 0,
+    };
+
+    pub fn reset(self: *Histogram) void {
+        self.* = empty;
+    }
+
+    pub fn record(self: *Histogram, value: u64) void {
+        self.counts[bucketIndex(value)] += 1;
+        self.total += 1;
+        self.sum +%= value;
+        self.min = @min(self.min, value);
+        self.max = @max(self.max, value);
+    }
+
+    /// `record()` for a histogram other threads read while it is written.
+    /// Still single-writer: every field is bumped with a relaxed load and
+    /// store, which compile to plain moves, so readers never see a torn value.
+    pub fn recordShared(self: *Histogram, value: u64) void {
+        bump(&self.counts[bucketIndex(value)], 1);
+        bump(&self.total, 1);
+        bump(&self.sum, value);
+        if (value < load(&self.min)) @atomicStore(u64, &self.min, value, .monotonic);
+        if (value > load(&self.max)) @atomicStore(u64, &self.max, value, .monotonic);
+    }
+
+    pub fn merge(self: *Histogram, other: *const Histogram) void {
+        for (&self.counts, other.counts) |*c, o| c.* += o;
+        self.total += other.total;
+        self.sum +%= other.sum;
+        self.min = @min(self.min, other.min);
+        self.max = @max(self.max, other.max);
+    }
+
+    /// Value at or below which `p` percent of samples fall: the upper bound
+    /// of the bucket holding that sample, capped at the recorded maximum.
+    /// 0 when empty.
+    pub fn percentile(self: *const Histogram, p: f64) u64 {
+        if (self.total == 0) return 0;
+        const rank = rankOf(p, self.total);
+        var seen: u64 = 0;
+        for (self.counts, 0..) |count, i| {
+            seen += count;
+            if (seen >= rank) return @min(bucketUpper(i), self.max);
+        }
+        return self.max;
+    }
+
+    /// `percentile()` of each of `ps` (ascending) into `out`, for a histogram
+    /// written through `recordShared()` meanwhile. One pass over the buckets;
+    /// samples recorded during the pass may or may not be counted.
+    pub fn sharedPercentiles(self: *const Histogram, ps: []const f64, out: []u64) void {
+        var total: u64 = 0;
+        for (&self.counts) |*c| total += load(c);
+        const max = load(&self.max);
+
+        var k: usize = 0;
+        if (total > 0) {
+            var seen: u64 = 0;
+            for (&self.counts, 0..) |*c, i| {
+                seen += load(c);
+                while (k < ps.len and seen >= rankOf(ps[k], total)) : (k += 1) {
+                    out[k] = @min(bucketUpper(i), max);
+                }
+                if (k == ps.len) break;
+            }
+        }
+        for (out[k..ps.len]) |*v| v.* = if (total == 0) 0 else max;
+    }
+
+    /// Sample count, sum and maximum of a histogram written through
+    /// `recordShared()`.
+    pub fn sharedTotals(self: *const Histogram) struct { count: u64, sum: u64, max: u64 } {
+        return .{ .count = load(&self.total), .sum = load(&self.sum), .max = load(&self.max) };
+    }
+
+    pub fn mean(self: *const Histogram) f64 {
+        if (self.total == 0) return 0;
+        return @as(f64, @floatFromInt(self.sum)) / @as(f64, @floatFromInt(self.total));
+    }
+
+    pub fn minValue(self: *const Histogram) u64 {
+        return if (self.total == 0) 0 else self.min;
+    }
+};
+
+fn load(ptr: *const u64) u64 {
+    return @atomicLoad(u64, ptr, .monotonic);
+}
+
+fn bump(ptr: *u64, n: u64) void {
+    @atomicStore(u64, ptr, load(ptr) +% n, .monotonic);
+}
+
+/// 1-based rank of the sample at percentile `p` of `total`.
+fn rankOf(p: f64, total: u64) u64 {
+    const clamped = std.math.clamp(p, 0.0, 100.0);
+    const rank_f = @ceil(clamped / 100.0 * @as(f64, @floatFromInt(total)));
+    return @max(1, @as(u64, @intFromFloat(rank_f)));
+}
+
+pub fn bucketIndex(value: u64) usize {
+    if (value < SUB_BUCKETS) return @intCast(value);
+    const exp: u6 = @intCast(63 - @clz(value));
+    const shift: u6 = exp - SUB_BUCKET_BITS;
+    const sub = (value >> shift) - SUB_BUCKETS;
+    return @intCast(SUB_BUCKETS + @as(u64, shift) * SUB_BUCKETS + sub);
+}
+
+/// Largest value that lands in bucket `index`.
+pub fn bucketUpper(index: usize) u64 {
+    if (index < SUB_BUCKETS) return index;
+    const k: u64 = index - SUB_BUCKETS;
+    const shift: u6 = @intCast(k / SUB_BUCKETS);
+    const lower = (SUB_BUCKETS + k % SUB_BUCKETS) << shift;
+    return lower + ((@as(u64, 1) << shift) - 1);
+}
+
+// ---- Tests ----
+
+test "buckets are exact below 128 and within 1/128 above" {
+    for (0..SUB_BUCKETS) |v| try std.testing.expectEqual(@as(u64, v), bucketUpper(bucketIndex(v)));
+
+    var value: u64 = SUB_BUCKETS;
+    while (value < (1 << 40)) : (value = value * 3 + 1) {
+        const upper = bucketUpper(bucketIndex(value));
+        try std.testing.expect(upper >= value);
+        try std.testing.expect(upper - value <= value / SUB_BUCKETS);
+    }
+    try std.testing.expectEqual(NUM_BUCKETS - 1, bucketIndex(std.math.maxInt(u64)));
+    try std.testing.expectEqual(@as(u64, std.math.maxInt(u64)), bucketUpper(NUM_BUCKETS - 1));
+}
+
+test "percentiles of a uniform distribution" {
+    const hist = try std.testing.allocator.create(Histogram);
+    defer std.testing.allocator.destroy(hist);
+    hist.* = .empty;
+    for (1..10_001) |v| hist.record(v);
+
+    try std.testing.expectEqual(@as(u64, 10_000), hist.total);
+    try std.testing.expectEqual(@as(u64, 1), hist.minValue());
+    try std.testing.expectEqual(@as(u64, 10_000), hist.percentile(100));
+    for ([_]f64{ 50, 99, 99.9 }) |p| {
+        const expected = p / 100.0 * 10_000.0;
+        const actual: f64 = @floatFromInt(hist.percentile(p));
+        try std.testing.expect(@abs(actual - expected) <= expected / 128.0 + 1);
+    }
+    try std.testing.expectApproxEqAbs(@as(f64, 5000.5), hist.mean(), 0.001);
+
+    const other = try std.testing.allocator.create(Histogram);
+    defer std.testing.allocator.destroy(other);
+    other.* = .empty;
+    other.record(1_000_000);
+    hist.merge(other);
+    try std.testing.expectEqual(@as(u64, 10_001), hist.total);
+    try std.testing.expectEqual(@as(u64, 1_000_000), hist.percentile(100));
+}
+
+test "shared recording reports the same percentiles" {
+    const allocator = std.testing.allocator;
+    const plain = try allocator.create(Histogram);
+    defer allocator.destroy(plain);
+    const shared = try allocator.create(Histogram);
+    defer allocator.destroy(shared);
+    plain.* = .empty;
+    shared.* = .empty;
+
+    var value: u64 = 1;
+    for (0..5000) |_| {
+        plain.record(value);
+        shared.recordShared(value);
+        value = (value * 7 + 3) % 100_003;
+    }
+
+    const ps = [_]f64{ 50, 99, 99.9, 100 };
+    var out: [ps.len]u64 = undefined;
+    shared.sharedPercentiles(&ps, &out);
+    for (ps, out) |p, v| try std.testing.expectEqual(plain.percentile(p), v);
+    try std.testing.expectEqual(plain.sum, shared.sharedTotals().sum);
+
+    const empty = try allocator.create(Histogram);
+    defer allocator.destroy(empty);
+    empty.* = .empty;
+    empty.sharedPercentiles(&ps, &out);
+    for (out) |v| try std.testing.expectEqual(@as(u64, 0), v);
+}
@@ -0,0 +1,201 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const types = @import("types.zig");
+const thrift = @import("thrift.zig");
+const CompactProtocolWriter = thrift.CompactProtocolWriter;
+const dictionary = @import("dictionary.zig");
+
+/// Target false positive probability of a column chunk's filter.
+pub const DEFAULT_FPP: f64 = 0.01;
+
+/// Largest bitset a chunk may get (same default as parquet-mr); chunks with
+/// more distinct values accept a higher false positive rate instead.
+pub const MAX_BLOOM_FILTER_SIZE: usize = 1 << 20;
+
+const MIN_BLOOM_FILTER_SIZE: usize = @sizeOf(Block);
+
+/// One 256-bit block: eight 32-bit words, one bit set in each per value.
+const Block = @Vector(8, u32);
+
+/// Salts of the split-block algorithm (Parquet BloomFilter.md).
+const SALT: Block = .{
+    0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+    0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31,
+};
+
+/// Parquet split-block Bloom filter over the xxHash64 (seed 0) of each
+/// value's PLAIN bytes, without the BYTE_ARRAY length prefix. The top 32
+/// bits of the hash pick a block and the low 32 bits set one bit in each of
+/// its words, so an insert or lookup touches a single cache line.
+pub const BloomFilter = struct {
+    gpa: Allocator,
+    blocks: []Block,
+
+    /// A filter sized for `ndv` distinct values at `fpp`, with a power of two
+    /// bytes between 32 and `MAX_BLOOM_FILTER_SIZE`.
+    pub fn init(allocator: Allocator, ndv: usize, fpp: f64) !BloomFilter {
+        const num_bytes = optimalNumBytes(ndv, fpp);
+        const blocks = try allocator.alloc(Block, num_bytes / @sizeOf(Block));
+        @memset(blocks, @splat(0));
+        return .{ .gpa = allocator, .blocks = blocks };
+    }
+
+    pub fn deinit(self: *BloomFilter) void {
+        self.gpa.free(self.blocks);
+    }
+
+    /// Clear the filter and size it for `ndv` values at `fpp`, keeping the
+    /// bitset's memory when the size does not change.
+    pub fn reset(self: *BloomFilter, ndv: usize, fpp: f64) !void {
+        const num_blocks = optimalNumBytes(ndv, fpp) / @sizeOf(Block);
+        if (num_blocks != self.blocks.len) {
+            const blocks = try self.gpa.alloc(Block, num_blocks);
+            self.gpa.free(self.blocks);
+            self.blocks = blocks;
+        }
+        @memset(self.blocks, @splat(0));
+    }
+
+    /// The bitset as written to the file: words little-endian, in order.
+    pub fn bitset(self: *const BloomFilter) []const u8 {
+        return std.mem.sliceAsBytes(self.blocks);
+    }
+
+    fn blockIndex(self: *const BloomFilter, hash: u64) usize {
+        return @intCast(((hash >> 32) * self.blocks.len) >> 32);
+    }
+
+    fn mask(hash: u64) Block {
+        const key: Block = @splat(@truncate(hash));
+        const bits: @Vector(8, u5) = @intCast((key *% SALT) >> @splat(27));
+        return @as(Block, @splat(1)) << bits;
+    }
+
+    pub fn insertHash(self: *BloomFilter, hash: u64) void {
+        const block = &self.blocks[self.blockIndex(hash)];
+        block.* |= mask(hash);
+    }
+
+    /// False if the value with this hash was never inserted; true if it
+    /// probably was.
+    pub fn mightContainHash(self: *const BloomFilter, hash: u64) bool {
+        const m = mask(hash);
+        return @reduce(.And, (self.blocks[self.blockIndex(hash)] & m) == m);
+    }
+
+    pub fn insert(self: *BloomFilter, value: []const u8) void {
+        self.insertHash(hashValue(value));
+    }
+
+    pub fn mightContain(self: *const BloomFilter, value: []const u8) bool {
+        return self.mightContainHash(hashValue(value));
+    }
+
+    /// Insert every value of a PLAIN-encoded buffer of `physical_type`.
+    pub fn insertPlainValues(self: *BloomFilter, physical_type: types.PhysicalType, type_length: ?i32, plain: []const u8) void {
+        switch (physical_type) {
+            .INT32, .FLOAT => self.insertFixed(4, plain),
+            .INT64, .DOUBLE => self.insertFixed(8, plain),
+            else => {
+                const width = dictionary.plainValueWidth(physical_type, type_length);
+                if (width == 0) return;
+                var pos: usize = 0;
+                while (pos < plain.len) {
+                    const value = if (width) |w| plain[pos..][0..w] else blk: {
+                        const len = std.mem.readInt(u32, plain[pos..][0..4], .little);
+                        pos += 4;
+                        break :blk plain[pos..][0..len];
+                    };
+                    pos += value.len;
+                    self.insert(value);
+                }
+            },
+        }
+    }
+
+    fn insertFixed(self: *BloomFilter, comptime width: usize, plain: []const u8) void {
+        var pos: usize = 0;
+        while (pos + width <= plain.len) : (pos += width) {
+            self.insertHash(std.hash.XxHash64.hash(0, plain[pos..][0..width]));
+        }
+    }
+
+    /// Write the BloomFilterHeader that precedes the bitset in the file.
+    pub fn writeHeader(self: *const BloomFilter, tw: *CompactProtocolWriter) !void {
+        try tw.writeFieldI32(1, @intCast(self.bitset().len));
+        // algorithm, hash and compression are unions of empty structs:
+        // BLOCK, XXHASH and UNCOMPRESSED, each field 1
+        for ([_]i16{ 2, 3, 4 }) |field_id| {
+            try tw.writeFieldStruct(field_id);
+            try tw.writeStructBegin();
+            try tw.writeFieldStruct(1);
+            try tw.writeStructBegin();
+            try tw.writeStructEnd();
+            try tw.writeStructEnd();
+        }
+        try tw.writeFieldStop();
+    }
+};
+
+pub fn hashValue(value: []const u8) u64 {
+    return std.hash.XxHash64.hash(0, value);
+}
+
+/// Bitset bytes for `ndv` distinct values at false positive rate `fpp`
+/// (split-block formula, bits = -8 * ndv / ln(1 - fpp^(1/8))), rounded up to
+/// a power of two and clamped to [32, MAX_BLOOM_FILTER_SIZE].
+pub fn optimalNumBytes(ndv: usize, fpp: f64) usize {
+    const n: f64 = @floatFromInt(@max(ndv, 1));
+    const bits = -8.0 * n / @log(1.0 - std.math.pow(f64, fpp, 1.0 / 8.0));
+    const bytes = @min(bits / 8.0, @as(f64, @floatFromInt(MAX_BLOOM_FILTER_SIZE)));
+    const wanted: usize = @intFromFloat(@ceil(bytes));
+    return std.math.clamp(std.math.ceilPowerOfTwoAssert(usize, @max(wanted, 1)), MIN_BLOOM_FILTER_SIZE, MAX_BLOOM_FILTER_SIZE);
+}
+
+// ---- Tests ----
+
+test "filter sizes follow the split-block formula" {
+    try std.testing.expectEqual(@as(usize, 32), optimalNumBytes(1, DEFAULT_FPP));
+    // 1000 values at 1% need ~1210 bytes
+    try std.testing.expectEqual(@as(usize, 2048), optimalNumBytes(1000, DEFAULT_FPP));
+    try std.testing.expectEqual(MAX_BLOOM_FILTER_SIZE, optimalNumBytes(100_000_000, DEFAULT_FPP));
+}
+
+test "inserted values are always found and others mostly are not" {
+    const allocator = std.testing.allocator;
+    var filter = try BloomFilter.init(allocator, 10_000, DEFAULT_FPP);
+    defer filter.deinit();
+
+    var plain: [10_000]i64 = undefined;
+    for (&plain, 0..) |*v, i| v.* = @as(i64, @intCast(i)) * 7919;
+    filter.insertPlainValues(.INT64, null, std.mem.sliceAsBytes(&plain));
+
+    for (plain) |v| try std.testing.expect(filter.mightContain(std.mem.asBytes(&v)));
+
+    var false_positives: usize = 0;
+    for (0..10_000) |i| {
+        const v: i64 = @as(i64, @intCast(i)) * 7919 + 1;
+        if (filter.mightContain(std.mem.asBytes(&v))) false_positives += 1;
+    }
+    try std.testing.expect(false_positives < 300);
+}
+
+test "byte array values hash without their length prefix" {
+    const allocator = std.testing.allocator;
+    const encoding = @import("encoding.zig");
+    var plain: std.ArrayList(u8) = .empty;
+    defer plain.deinit(allocator);
+    try encoding.encodePlainByteArray(&.{ "AAPL", "MSFT" }, &plain, allocator);
+
+    var filter = try BloomFilter.init(allocator, 2, DEFAULT_FPP);
+    defer filter.deinit();
+    filter.insertPlainValues(.BYTE_ARRAY, null, plain.items);
+
+    try std.testing.expect(filter.mightContain("AAPL"));
+    try std.testing.expect(filter.mightContain("MSFT"));
+    var expected = try BloomFilter.init(allocator, 2, DEFAULT_FPP);
+    defer expected.deinit();
+    expected.insertHash(hashValue("AAPL"));
+    expected.insertHash(hashValue("MSFT"));
+    try std.testing.expectEqualSlices(u8, expected.bitset(), filter.bitset());
+}
@@ -1,28 +1,258 @@
 const std = @import("std");
 const Allocator = std.mem.Allocator;
 const types = @import("types.zig");
+const cycles = @import("../cycles.zig");
 
-/// Compress data using the specified codec.
+const c = @cImport({
+    @cInclude("zstd.h");
+    @cInclude("zlib.h");
+    @cInclude("lz4.h");
+    @cInclude("snappy-c.h");
+});
+
+/// Per-thread compression state. Codec contexts are created on first use and
+/// reused for every later page, and output lands in a buffer that keeps its
+/// capacity, so steady-state compression does not allocate.
+///
+/// Not thread-safe: each encoding thread owns one.
+pub const Compressor = struct {
+    allocator: Allocator,
+    /// Codec level for ZSTD and GZIP; 0 selects the codec's default
+    /// (ZSTD 3, GZIP 6). SNAPPY and LZ4_RAW have no levels.
+    level: i32,
+    zstd_ctx: ?*c.ZSTD_CCtx,
+    deflate_stream: ?*c.z_stream,
+    lz4_state: ?[]align(16) u8,
+    /// Compressed output; valid until the next `compress()`.
+    out: std.ArrayList(u8),
+    /// Scratch for page bodies assembled from several parts (see page.zig).
+    body: std.ArrayList(u8),
+    /// Nanoseconds spent in codec calls so far.
+    elapsed_ns: u64,
+
+    pub fn init(allocator: Allocator, level: i32) Compressor {
+        return .{
+            .allocator = allocator,
+            .level = level,
+            .zstd_ctx = null,
+            .deflate_stream = null,
+            .lz4_state = null,
+            .out = .empty,
+            .body = .empty,
+            .elapsed_ns = 0,
+        };
+    }
+
+    pub fn deinit(self: *Compressor) void {
+        if (self.zstd_ctx) |ctx| _ = c.ZSTD_freeCCtx(ctx);
+        if (self.deflate_stream) |strm| {
+            _ = c.deflateEnd(strm);
+            self.allocator.destroy(strm);
+        }
+        if (self.lz4_state) |state| self.allocator.free(state);
+        self.out.deinit(self.allocator);
+        self.body.deinit(self.allocator);
+    }
+
+    /// Compress `input` with `codec`. UNCOMPRESSED returns `input` itself;
+    /// every other codec returns a slice of the reused output buffer, valid
+    /// until the next call.
+    pub fn compress(self: *Compressor, codec: types.CompressionCodec, input: []const u8) ![]const u8 {
+        if (codec == .UNCOMPRESSED) return input;
+        const start_ns = cycles.monotonicNs();
+        defer self.elapsed_ns += cycles.monotonicNs() - start_ns;
+        return switch (codec) {
+            .UNCOMPRESSED => unreachable,
+            .SNAPPY => self.compressSnappy(input),
+            .GZIP => self.compressGzip(input),
+            .ZSTD => self.compressZstd(input),
+            .LZ4_RAW => self.compressLz4(input),
+        };
+    }
+
+    fn compressZstd(self: *Compressor, input: []const u8) ![]const u8 {
+        const ctx = self.zstd_ctx orelse blk: {
+            const new_ctx = c.ZSTD_createCCtx() orelse return error.OutOfMemory;
+            self.zstd_ctx = new_ctx;
+            break :blk new_ctx;
+        };
+
+        try self.out.resize(self.allocator, c.ZSTD_compressBound(input.len));
+        const n = c.ZSTD_compressCCtx(
+            ctx,
+            self.out.items.ptr,
+            self.out.items.len,
+            input.ptr,
+            input.len,
+            self.level,
+        );
+        if (c.ZSTD_isError(n) != 0) return error.ZstdCompressFailed;
+        return self.out.items[0..n];
+    }
+
+    fn compressGzip(self: *Compressor, input: []const u8) ![]const u8 {
+        const strm = self.deflate_stream orelse blk: {
+            const new_strm = try self.allocator.create(c.z_stream);
+            errdefer self.allocator.destroy(new_strm);
+            new_strm.* = std.mem.zeroes(c.z_stream);
+
+            const level: c_int = if (self.level == 0) c.Z_DEFAULT_COMPRESSION else @intCast(self.level);
+            // windowBits 15 + 16 selects the gzip wrapper Parquet requires
+            const rc = c.deflateInit2_(
+                new_strm,
+                level,
+                c.Z_DEFLATED,
+                15 + 16,
+                8,
+                c.Z_DEFAULT_STRATEGY,
+                c.ZLIB_VERSION,
+                @sizeOf(c.z_stream),
+            );
+            if (rc != c.Z_OK) return error.GzipCompressFailed;
+            self.deflate_stream = new_strm;
+            break :blk new_strm;
+        };
+
+        if (c.deflateReset(strm) != c.Z_OK) return error.GzipCompressFailed;
+        try self.out.resize(self.allocator, @intCast(c.deflateBound(strm, @intCast(input.len))));
+
+        strm.next_in = @constCast(input.ptr);
+        strm.avail_in = @intCast(input.len);
+        strm.next_out = self.out.items.ptr;
+        strm.avail_out = @intCast(self.out.items.len);
+        if (c.deflate(strm, c.Z_FINISH) != c.Z_STREAM_END) return error.GzipCompressFailed;
+
+        return self.out.items[0..@intCast(strm.total_out)];
+    }
+
+    fn compressSnappy(self: *Compressor, input: []const u8) ![]const u8 {
+        try self.out.resize(self.allocator, c.snappy_max_compressed_length(input.len));
+        var n: usize = self.out.items.len;
+        if (c.snappy_compress(input.ptr, input.len, self.out.items.ptr, &n) != c.SNAPPY_OK) {
+            return error.SnappyCompressFailed;
+        }
+        return self.out.items[0..n];
+    }
+
+    fn compressLz4(self: *Compressor, input: []const u8) ![]const u8 {
+        if (input.len > c.LZ4_MAX_INPUT_SIZE) return error.Lz4CompressFailed;
+        const state = self.lz4_state orelse blk: {
+            const new_state = try self.allocator.alignedAlloc(u8, .@"16", @intCast(c.LZ4_sizeofState()));
+            self.lz4_state = new_state;
+            break :blk new_state;
+        };
+
+        const src_len: c_int = @intCast(input.len);
+        try self.out.resize(self.allocator, @intCast(c.LZ4_compressBound(src_len)));
+        const n = c.LZ4_compress_fast_extState(
+            state.ptr,
+            input.ptr,
+            self.out.items.ptr,
+            src_len,
+            @intCast(self.out.items.len),
+            1,
+        );
+        if (n <= 0) return error.Lz4CompressFailed;
+        return self.out.items[0..@intCast(n)];
+    }
+};
+
+/// Compress data using the specified codec at its default level.
 /// Returns owned slice that must be freed by the caller (with the same allocator).
-/// For UNCOMPRESSED, returns a copy of the input.
+/// For UNCOMPRESSED, returns a copy of the input. Hot paths should keep a
+/// `Compressor` instead.
 pub fn compress(codec: types.CompressionCodec, input: []const u8, allocator: Allocator) ![]u8 {
-    return switch (codec) {
-        .UNCOMPRESSED => {
-            const result = try allocator.alloc(u8, input.len);
-            @memcpy(result, input);
-            return result;
-        },
-        .GZIP => {
-            // TODO: implement using std.compress.flate when API stabilizes
-            return error.CompressionNotImplemented;
-        },
-        .SNAPPY => {
-            // TODO: implement via C libsnappy linkage
-            return error.CompressionNotImplemented;
-        },
-        .ZSTD => {
-            // TODO: Zig std only has zstd decompressor; need libzstd C linkage for compression
-            return error.CompressionNotImplemented;
-        },
-    };
+    var compressor = Compressor.init(allocator, 0);
+    defer compressor.deinit();
+    return allocator.dupe(u8, try compressor.compress(codec, input));
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+const test_input = "hello hello hello hello hello hello hello hello hello hello hello";
+
+fn expectGunzip(compressed: []const u8, expected: []const u8) !void {
+    var strm = std.mem.zeroes(c.z_stream);
+    try std.testing.expectEqual(@as(c_int, c.Z_OK), c.inflateInit2_(&strm, 15 + 16, c.ZLIB_VERSION, @sizeOf(c.z_stream)));
+    defer _ = c.inflateEnd(&strm);
+
+    var buf: [256]u8 = undefined;
+    strm.next_in = @constCast(compressed.ptr);
+    strm.avail_in = @intCast(compressed.len);
+    strm.next_out = &buf;
+    strm.avail_out = buf.len;
+    try std.testing.expectEqual(@as(c_int, c.Z_STREAM_END), c.inflate(&strm, c.Z_FINISH));
+    try std.testing.expectEqualSlices(u8, expected, buf[0..@intCast(strm.total_out)]);
+}
+
+test "UNCOMPRESSED returns the input without copying" {
+    var compressor = Compressor.init(std.testing.allocator, 0);
+    defer compressor.deinit();
+
+    const out = try compressor.compress(.UNCOMPRESSED, test_input);
+    try std.testing.expectEqual(@as([*]const u8, test_input), out.ptr);
+}
+
+test "ZSTD round trip reuses its context" {
+    var compressor = Compressor.init(std.testing.allocator, 1);
+    defer compressor.deinit();
+
+    for (0..2) |_| {
+        const out = try compressor.compress(.ZSTD, test_input);
+        try std.testing.expect(out.len < test_input.len);
+
+        var buf: [256]u8 = undefined;
+        const n = c.ZSTD_decompress(&buf, buf.len, out.ptr, out.len);
+        try std.testing.expect(c.ZSTD_isError(n) == 0);
+        try std.testing.expectEqualSlices(u8, test_input, buf[0..n]);
+    }
+    try std.testing.expect(compressor.zstd_ctx != null);
+}
+
+test "GZIP round trip" {
+    var compressor = Compressor.init(std.testing.allocator, 0);
+    defer compressor.deinit();
+
+    for (0..2) |_| {
+        const out = try compressor.compress(.GZIP, test_input);
+        try std.testing.expect(out.len < test_input.len);
+        // gzip magic
+        try std.testing.expectEqualSlices(u8, &.{ 0x1f, 0x8b }, out[0..2]);
+        try expectGunzip(out, test_input);
+    }
+}
+
+test "SNAPPY round trip" {
+    var compressor = Compressor.init(std.testing.allocator, 0);
+    defer compressor.deinit();
+
+    const out = try compressor.compress(.SNAPPY, test_input);
+    try std.testing.expect(out.len < test_input.len);
+
+    var buf: [256]u8 = undefined;
+    var n: usize = buf.len;
+    try std.testing.expect(c.snappy_uncompress(out.ptr, out.len, &buf, &n) == c.SNAPPY_OK);
+    try std.testing.expectEqualSlices(u8, test_input, buf[0..n]);
+}
+
+test "LZ4_RAW round trip" {
+    var compressor = Compressor.init(std.testing.allocator, 0);
+    defer compressor.deinit();
+
+    const out = try compressor.compress(.LZ4_RAW, test_input);
+    try std.testing.expect(out.len < test_input.len);
+
+    var buf: [256]u8 = undefined;
+    const n = c.LZ4_decompress_safe(out.ptr, &buf, @intCast(out.len), buf.len);
+    try std.testing.expect(n >= 0);
+    try std.testing.expectEqualSlices(u8, test_input, buf[0..@intCast(n)]);
+}
+
+test "one-shot compress returns an owned copy" {
+    const allocator = std.testing.allocator;
+    const out = try compress(.UNCOMPRESSED, test_input, allocator);
+    defer allocator.free(out);
+    try std.testing.expectEqualSlices(u8, test_input, out);
 }
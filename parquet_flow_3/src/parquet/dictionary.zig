@@ -0,0 +1,266 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const types = @import("types.zig");
+const encoding = @import("encoding.zig");
+
+/// Largest dictionary page a column chunk may build before it falls back to
+/// PLAIN (same default as parquet-mr).
+pub const MAX_DICTIONARY_PAGE_SIZE: usize = 1 << 20;
+
+/// Builds the dictionary for one column chunk: each distinct value is
+/// stored once, in PLAIN layout, and every value is replaced by its index.
+///
+/// The hash table stores only indices; keys are hashed and compared through
+/// the value bytes in `dict_plain`, so values are never copied twice.
+pub const DictEncoder = struct {
+    gpa: Allocator,
+    /// Distinct values in PLAIN layout, in index order: the dictionary page body.
+    dict_plain: std.ArrayList(u8),
+    /// Location of each distinct value's PLAIN bytes within `dict_plain`.
+    entries: std.ArrayList(Entry),
+    map: std.HashMapUnmanaged(u32, void, IndexContext, std.hash_map.default_max_load_percentage),
+    /// Dictionary index of every value added, in order.
+    indices: std.ArrayList(u32),
+
+    const Entry = struct {
+        offset: u32,
+        len: u32,
+    };
+
+    const IndexContext = struct {
+        encoder: *const DictEncoder,
+
+        pub fn hash(self: IndexContext, index: u32) u64 {
+            return std.hash.Wyhash.hash(0, self.encoder.valueBytes(index));
+        }
+
+        pub fn eql(_: IndexContext, a: u32, b: u32) bool {
+            return a == b;
+        }
+    };
+
+    const BytesAdapter = struct {
+        encoder: *const DictEncoder,
+
+        pub fn hash(_: BytesAdapter, value: []const u8) u64 {
+            return std.hash.Wyhash.hash(0, value);
+        }
+
+        pub fn eql(self: BytesAdapter, a: []const u8, b: u32) bool {
+            return std.mem.eql(u8, a, self.encoder.valueBytes(b));
+        }
+    };
+
+    pub fn init(allocator: Allocator) DictEncoder {
+        return .{
+            .gpa = allocator,
+            .dict_plain = .empty,
+            .entries = .empty,
+            .map = .empty,
+            .indices = .empty,
+        };
+    }
+
+    pub fn deinit(self: *DictEncoder) void {
+        self.dict_plain.deinit(self.gpa);
+        self.entries.deinit(self.gpa);
+        self.map.deinit(self.gpa);
+        self.indices.deinit(self.gpa);
+    }
+
+    /// Empty the dictionary for the next chunk, keeping every buffer's capacity.
+    pub fn reset(self: *DictEncoder) void {
+        self.dict_plain.clearRetainingCapacity();
+        self.entries.clearRetainingCapacity();
+        self.map.clearRetainingCapacity();
+        self.indices.clearRetainingCapacity();
+    }
+
+    fn valueBytes(self: *const DictEncoder, index: u32) []const u8 {
+        const e = self.entries.items[index];
+        return self.dict_plain.items[e.offset..][0..e.len];
+    }
+
+    pub fn numEntries(self: *const DictEncoder) u32 {
+        return @intCast(self.entries.items.len);
+    }
+
+    /// Width of the RLE-encoded indices (at least 1 for reader compatibility).
+    pub fn bitWidth(self: *const DictEncoder) u5 {
+        const max_index = self.numEntries() -| 1;
+        return @max(1, @as(u5, @intCast(32 - @clz(max_index))));
+    }
+
+    /// Add every value of a PLAIN-encoded buffer. `value_width` is the fixed
+    /// value size, or null for BYTE_ARRAY (4-byte length prefix per value).
+    /// Returns false once the dictionary page would exceed `max_size`; the
+    /// encoder must then be discarded and the chunk written as PLAIN.
+    pub fn addPlainValues(self: *DictEncoder, plain: []const u8, value_width: ?usize, max_size: usize) !bool {
+        var pos: usize = 0;
+        while (pos < plain.len) {
+            const len = value_width orelse 4 + std.mem.readInt(u32, plain[pos..][0..4], .little);
+            const index = try self.insert(plain[pos..][0..len], max_size) orelse return false;
+            try self.indices.append(self.gpa, index);
+            pos += len;
+        }
+        return true;
+    }
+
+    /// Index of `value`, adding it if new; null if it does not fit.
+    fn insert(self: *DictEncoder, value: []const u8, max_size: usize) !?u32 {
+        // Reserve first so nothing can fail once the map slot is claimed.
+        try self.entries.ensureUnusedCapacity(self.gpa, 1);
+        try self.dict_plain.ensureUnusedCapacity(self.gpa, value.len);
+
+        const gop = try self.map.getOrPutContextAdapted(
+            self.gpa,
+            value,
+            BytesAdapter{ .encoder = self },
+            IndexContext{ .encoder = self },
+        );
+        if (gop.found_existing) return gop.key_ptr.*;
+
+        if (self.dict_plain.items.len + value.len > max_size) {
+            self.map.removeByPtr(gop.key_ptr);
+            return null;
+        }
+
+        const index = self.numEntries();
+        self.entries.appendAssumeCapacity(.{
+            .offset = @intCast(self.dict_plain.items.len),
+            .len = @intCast(value.len),
+        });
+        self.dict_plain.appendSliceAssumeCapacity(value);
+        gop.key_ptr.* = index;
+        return index;
+    }
+
+    /// RLE_DICTIONARY data page values for `indices` (a slice of
+    /// `self.indices`, one page's worth): one bit-width byte followed by the
+    /// RLE/bit-packed hybrid indices (no length prefix).
+    pub fn encodeIndices(self: *const DictEncoder, indices: []const u32, out: *std.ArrayList(u8)) !void {
+        const bit_width = self.bitWidth();
+        try out.append(self.gpa, bit_width);
+        try encoding.encodeRleBitPackedHybrid(indices, bit_width, out, self.gpa);
+    }
+};
+
+/// PLAIN value size of a fixed-width physical type; null for BYTE_ARRAY.
+pub fn plainValueWidth(physical_type: types.PhysicalType, type_length: ?i32) ?usize {
+    return switch (physical_type) {
+        .BOOLEAN => 1,
+        .INT32, .FLOAT => 4,
+        .INT64, .DOUBLE => 8,
+        .INT96 => 12,
+        .FIXED_LEN_BYTE_ARRAY => @intCast(type_length orelse 0),
+        .BYTE_ARRAY => null,
+    };
+}
+
+// ---- Tests ----
+
+/// Reference decoder for the RLE/bit-packed hybrid, used to check output.
+fn decodeHybrid(data: []const u8, bit_width: u5, count: usize, out: []u32) !void {
+    var pos: usize = 0;
+    var n: usize = 0;
+    while (n < count) {
+        var header: u64 = 0;
+        var shift: u6 = 0;
+        while (true) {
+            const b = data[pos];
+            pos += 1;
+            header |= @as(u64, b & 0x7F) << shift;
+            if (b & 0x80 == 0) break;
+            shift += 7;
+        }
+        if (header & 1 == 0) {
+            const run: usize = @intCast(header >> 1);
+            var val: u32 = 0;
+            const byte_width = (@as(u32, bit_width) + 7) / 8;
+            for (0..byte_width) |j| val |= @as(u32, data[pos + j]) << @intCast(j * 8);
+            pos += byte_width;
+            for (0..run) |_| {
+                if (n < count) out[n] = val;
+                n += 1;
+            }
+        } else {
+            const num_values: usize = @intCast((header >> 1) * 8);
+            var bit_pos: usize = 0;
+            for (0..num_values) |_| {
+                var val: u32 = 0;
+                for (0..bit_width) |b| {
+                    const bit = (data[pos + (bit_pos + b) / 8] >> @intCast((bit_pos + b) % 8)) & 1;
+                    val |= @as(u32, bit) << @intCast(b);
+                }
+                bit_pos += bit_width;
+                if (n < count) out[n] = val;
+                n += 1;
+            }
+            pos += num_values * bit_width / 8;
+        }
+    }
+    if (pos != data.len) return error.TrailingBytes;
+}
+
+test "hybrid encoding round trips mixed runs" {
+    const allocator = std.testing.allocator;
+    // Short runs, a long run that starts mid-group, and a ragged tail
+    var values: [64]u32 = undefined;
+    for (&values, 0..) |*v, i| {
+        v.* = if (i >= 3 and i < 30) 5 else @intCast(i % 7);
+    }
+
+    var buf: std.ArrayList(u8) = .empty;
+    defer buf.deinit(allocator);
+    try encoding.encodeRleBitPackedHybrid(values[0..61], 3, &buf, allocator);
+
+    var decoded: [61]u32 = undefined;
+    try decodeHybrid(buf.items, 3, decoded.len, &decoded);
+    try std.testing.expectEqualSlices(u32, values[0..61], &decoded);
+}
+
+test "dictionary encodes repeated byte arrays" {
+    const allocator = std.testing.allocator;
+    const symbols = [_][]const u8{ "AAPL", "MSFT", "AAPL", "GOOG", "MSFT", "AAPL" };
+
+    var plain: std.ArrayList(u8) = .empty;
+    defer plain.deinit(allocator);
+    try encoding.encodePlainByteArray(&symbols, &plain, allocator);
+
+    var dict = DictEncoder.init(allocator);
+    defer dict.deinit();
+    try std.testing.expect(try dict.addPlainValues(plain.items, null, MAX_DICTIONARY_PAGE_SIZE));
+
+    try std.testing.expectEqual(@as(u32, 3), dict.numEntries());
+    try std.testing.expectEqualSlices(u32, &.{ 0, 1, 0, 2, 1, 0 }, dict.indices.items);
+    try std.testing.expectEqual(@as(u5, 2), dict.bitWidth());
+
+    // The dictionary page body is the PLAIN encoding of the distinct values
+    var expected: std.ArrayList(u8) = .empty;
+    defer expected.deinit(allocator);
+    try encoding.encodePlainByteArray(&.{ "AAPL", "MSFT", "GOOG" }, &expected, allocator);
+    try std.testing.expectEqualSlices(u8, expected.items, dict.dict_plain.items);
+
+    var out: std.ArrayList(u8) = .empty;
+    defer out.deinit(allocator);
+    try dict.encodeIndices(dict.indices.items, &out);
+    try std.testing.expectEqual(@as(u8, 2), out.items[0]);
+    var decoded: [6]u32 = undefined;
+    try decodeHybrid(out.items[1..], 2, decoded.len, &decoded);
+    try std.testing.expectEqualSlices(u32, dict.indices.items, &decoded);
+}
+
+test "dictionary gives up past the size limit" {
+    const allocator = std.testing.allocator;
+    var plain: std.ArrayList(u8) = .empty;
+    defer plain.deinit(allocator);
+    for (0..100) |i| {
+        const v: i64 = @intCast(i);
+        try encoding.encodePlain(i64, &[_]i64{v}, &plain, allocator);
+    }
+
+    var dict = DictEncoder.init(allocator);
+    defer dict.deinit();
+    try std.testing.expect(!try dict.addPlainValues(plain.items, 8, 64));
+    try std.testing.expectEqual(@as(u32, 8), dict.numEntries());
+}
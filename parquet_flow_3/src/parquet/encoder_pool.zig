@@ -0,0 +1,147 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const futex = @import("../futex.zig");
+const ColumnWriter = @import("writer.zig").ColumnWriter;
+const Compressor = @import("compression.zig").Compressor;
+const ThreadPlacement = @import("../placement.zig").ThreadPlacement;
+
+/// Upper bound on a single futex sleep; waits re-check their condition.
+const WAIT_SLICE_NS: u64 = 100 * std.time.ns_per_ms;
+
+/// Fixed pool of helper threads that encode and compress the column chunks
+/// of one row group in parallel. The calling thread works alongside the
+/// helpers and returns once every column has been flushed; the caller then
+/// stitches the chunks together in column order, so file layout and
+/// offsets are identical to the serial path.
+///
+/// Every helper keeps its own `Compressor`, so codec contexts and output
+/// buffers are reused across row groups. Column flushes allocate from each
+/// ColumnWriter's allocator concurrently, so that allocator (and the pool's)
+/// must be thread-safe.
+pub const EncoderPool = struct {
+    allocator: Allocator,
+    threads: []std.Thread,
+
+    /// Bumped once per job (and on shutdown); helpers futex-wait on it.
+    generation: std.atomic.Value(u32),
+    shutdown: std.atomic.Value(bool),
+
+    // Current job. Written by the caller before bumping `generation`.
+    columns: []ColumnWriter,
+    level: i32,
+    next_index: std.atomic.Value(usize),
+    /// Helpers that have finished the current job; the caller waits for all
+    /// of them so no helper touches job state after `flushColumns` returns.
+    finished: std.atomic.Value(u32),
+    first_error: std.atomic.Value(u16),
+
+    /// Helper `k` applies `placement.forWorker(k)` as it starts.
+    pub fn init(allocator: Allocator, num_threads: u32, placement: ThreadPlacement) !*EncoderPool {
+        const self = try allocator.create(EncoderPool);
+        errdefer allocator.destroy(self);
+
+        self.* = .{
+            .allocator = allocator,
+            .threads = &.{},
+            .generation = std.atomic.Value(u32).init(0),
+            .shutdown = std.atomic.Value(bool).init(false),
+            .columns = &.{},
+            .level = 0,
+            .next_index = std.atomic.Value(usize).init(0),
+            .finished = std.atomic.Value(u32).init(0),
+            .first_error = std.atomic.Value(u16).init(0),
+        };
+
+        const threads = try allocator.alloc(std.Thread, num_threads);
+        errdefer allocator.free(threads);
+
+        var spawned: usize = 0;
+        errdefer {
+            self.stopThreads(threads[0..spawned]);
+        }
+        while (spawned < threads.len) : (spawned += 1) {
+            threads[spawned] = try std.Thread.spawn(.{}, workerMain, .{ self, placement.forWorker(@intCast(spawned)) });
+        }
+
+        self.threads = threads;
+        return self;
+    }
+
+    pub fn deinit(self: *EncoderPool) void {
+        self.stopThreads(self.threads);
+        const allocator = self.allocator;
+        allocator.free(self.threads);
+        allocator.destroy(self);
+    }
+
+    fn stopThreads(self: *EncoderPool, threads: []std.Thread) void {
+        self.shutdown.store(true, .release);
+        _ = self.generation.fetchAdd(1, .release);
+        futex.wake(&self.generation, std.math.maxInt(u32));
+        for (threads) |t| t.join();
+    }
+
+    /// Flush (encode + compress) every column, spread over the pool and the
+    /// calling thread, which uses `compressor`; helpers compress at the same
+    /// level. Returns the first error any column hit.
+    pub fn flushColumns(self: *EncoderPool, columns: []ColumnWriter, compressor: *Compressor) anyerror!void {
+        if (columns.len == 0) return;
+
+        self.columns = columns;
+        self.level = compressor.level;
+        self.next_index.store(0, .monotonic);
+        self.finished.store(0, .monotonic);
+        self.first_error.store(0, .monotonic);
+        _ = self.generation.fetchAdd(1, .release);
+        futex.wake(&self.generation, std.math.maxInt(u32));
+
+        self.work(compressor);
+
+        const num_threads: u32 = @intCast(self.threads.len);
+        while (true) {
+            const done = self.finished.load(.acquire);
+            if (done == num_threads) break;
+            futex.wait(&self.finished, done, WAIT_SLICE_NS);
+        }
+
+        const code = self.first_error.load(.acquire);
+        if (code != 0) return @errorFromInt(code);
+    }
+
+    fn work(self: *EncoderPool, compressor: *Compressor) void {
+        while (true) {
+            const i = self.next_index.fetchAdd(1, .monotonic);
+            if (i >= self.columns.len) return;
+            self.columns[i].flush(compressor) catch |err| {
+                _ = self.first_error.cmpxchgStrong(0, @intFromError(err), .acq_rel, .monotonic);
+            };
+        }
+    }
+
+    fn workerMain(self: *EncoderPool, placement: ThreadPlacement) void {
+        placement.apply();
+        // Jobs only start after init returns, so generation 0 is never work;
+        // reading it here instead could miss a job bumped before this thread ran.
+        var seen: u32 = 0;
+        var compressor = Compressor.init(self.allocator, 0);
+        defer compressor.deinit();
+        while (true) {
+            var gen = self.generation.load(.acquire);
+            while (gen == seen) {
+                futex.wait(&self.generation, seen, WAIT_SLICE_NS);
+                gen = self.generation.load(.acquire);
+            }
+            seen = gen;
+
+            if (self.shutdown.load(.acquire)) return;
+
+            compressor.level = self.level;
+            self.work(&compressor);
+
+            const num_threads: u32 = @intCast(self.threads.len);
+            if (self.finished.fetchAdd(1, .acq_rel) + 1 == num_threads) {
+                futex.wake(&self.finished, 1);
+            }
+        }
+    }
+};
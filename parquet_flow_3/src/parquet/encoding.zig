@@ -1,5 +1,6 @@
 const std = @import("std");
 const Allocator = std.mem.Allocator;
+const types = @import("types.zig");
 
 /// Encode values in PLAIN format (little-endian packed).
 pub fn encodePlain(comptime T: type, values: []const T, buf: *std.ArrayList(u8), gpa: Allocator) !void {
@@ -30,6 +31,21 @@ pub fn encodePlainBool(values: []const bool, buf: *std.ArrayList(u8), gpa: Alloc
     }
 }
 
+/// Encode booleans stored one byte per value (0 or 1) in PLAIN format.
+pub fn encodePlainBoolBytes(values: []const u8, buf: *std.ArrayList(u8), gpa: Allocator) !void {
+    try buf.ensureUnusedCapacity(gpa, (values.len + 7) / 8);
+    var i: usize = 0;
+    while (i < values.len) : (i += 8) {
+        var byte: u8 = 0;
+        const end = @min(i + 8, values.len);
+        for (values[i..end], 0..) |v, bit| {
+            const bit_index: u3 = @intCast(bit);
+            byte |= @as(u8, @intFromBool(v != 0)) << bit_index;
+        }
+        buf.appendAssumeCapacity(byte);
+    }
+}
+
 /// Encode byte arrays in PLAIN format: 4-byte LE length prefix + data for each.
 pub fn encodePlainByteArray(values: []const []const u8, buf: *std.ArrayList(u8), gpa: Allocator) !void {
     for (values) |v| {
@@ -40,7 +56,9 @@ pub fn encodePlainByteArray(values: []const []const u8, buf: *std.ArrayList(u8),
     }
 }
 
-/// RLE/Bit-Pack Hybrid encoder.
+/// RLE/Bit-Pack Hybrid encoder. Runs of 8 or more equal values become RLE
+/// runs; everything else is bit-packed in whole groups of 8, so zero padding
+/// only ever appears after the last value.
 pub fn encodeRleBitPackedHybrid(values: []const u32, bit_width: u5, buf: *std.ArrayList(u8), gpa: Allocator) !void {
     if (values.len == 0) return;
     if (bit_width == 0) return;
@@ -49,11 +67,7 @@ pub fn encodeRleBitPackedHybrid(values: []const u32, bit_width: u5, buf: *std.Ar
     var i: usize = 0;
 
     while (i < values.len) {
-        // Count run of identical values
-        var run_len: usize = 1;
-        while (i + run_len < values.len and values[i + run_len] == values[i]) {
-            run_len += 1;
-        }
+        const run_len = runLength(values, i);
 
         if (run_len >= 8) {
             // RLE run: header = (count << 1)
@@ -65,38 +79,23 @@ pub fn encodeRleBitPackedHybrid(values: []const u32, bit_width: u5, buf: *std.Ar
             }
             i += run_len;
         } else {
-            // Bit-packed run: collect values until next RLE-eligible run
-            var bp_count: usize = 0;
-            var scan = i;
-            while (scan < values.len) {
-                var next_run: usize = 1;
-                while (scan + next_run < values.len and values[scan + next_run] == values[scan]) {
-                    next_run += 1;
-                }
-                if (next_run >= 8 and bp_count > 0) break;
-                if (next_run >= 8 and bp_count == 0) {
-                    bp_count += next_run;
-                    scan += next_run;
-                    break;
-                }
-                bp_count += next_run;
-                scan += next_run;
+            // Bit-packed run: whole groups of 8 until the next RLE-eligible run
+            var end = i + 8;
+            while (end < values.len and runLength(values, end) < 8) {
+                end += 8;
             }
-
-            // Round up to multiple of 8
-            const padded_count = ((bp_count + 7) / 8) * 8;
-            const num_groups = padded_count / 8;
+            const num_groups = (end - i) / 8;
 
             // Header: (num_groups << 1) | 1
             try writeVarintToBuf((@as(u64, num_groups) << 1) | 1, buf, gpa);
 
-            // Bit-pack values
+            // Bit-pack values, zero-padding the final group
             var bit_buf: u64 = 0;
             var bits_in_buf: u6 = 0;
 
-            var k: usize = 0;
-            while (k < padded_count) : (k += 1) {
-                const val: u32 = if (i + k < values.len) values[i + k] else 0;
+            var k = i;
+            while (k < end) : (k += 1) {
+                const val: u32 = if (k < values.len) values[k] else 0;
                 bit_buf |= @as(u64, val) << bits_in_buf;
                 bits_in_buf += @intCast(bit_width);
 
@@ -106,15 +105,22 @@ pub fn encodeRleBitPackedHybrid(values: []const u32, bit_width: u5, buf: *std.Ar
                     bits_in_buf -= 8;
                 }
             }
-            if (bits_in_buf > 0) {
-                try buf.append(gpa, @as(u8, @intCast(bit_buf & 0xFF)));
-            }
+            // 8 * bit_width bits per group: always byte-aligned here
 
-            i += bp_count;
+            i = @min(end, values.len);
         }
     }
 }
 
+/// Number of values equal to `values[start]` starting at `start`.
+fn runLength(values: []const u32, start: usize) usize {
+    var n: usize = 1;
+    while (start + n < values.len and values[start + n] == values[start]) {
+        n += 1;
+    }
+    return n;
+}
+
 /// Encode definition levels: 4-byte LE length prefix, then RLE/bit-packed hybrid data.
 pub fn encodeDefinitionLevels(values: []const u8, max_level: u8, out: *std.ArrayList(u8), gpa: Allocator) !void {
     if (max_level == 0) return;
@@ -149,6 +155,111 @@ pub fn encodeDefinitionLevels(values: []const u8, max_level: u8, out: *std.Array
     try out.appendSlice(gpa, tmp_buf.items);
 }
 
+/// Repetition levels are encoded exactly like definition levels.
+pub const encodeRepetitionLevels = encodeDefinitionLevels;
+
+/// Values per DELTA_BINARY_PACKED block and miniblocks per block (the
+/// parquet-mr defaults: 4 miniblocks of 32 values).
+pub const DELTA_BLOCK_SIZE = 128;
+pub const DELTA_MINIBLOCKS = 4;
+const DELTA_MINIBLOCK_SIZE = DELTA_BLOCK_SIZE / DELTA_MINIBLOCKS;
+
+/// Encode INT32/INT64 values as DELTA_BINARY_PACKED. Deltas wrap in the
+/// value's own width, as readers decode them, so INT32 widths stay <= 32.
+pub fn encodeDeltaBinaryPacked(comptime T: type, values: []align(1) const T, buf: *std.ArrayList(u8), gpa: Allocator) !void {
+    comptime std.debug.assert(T == i32 or T == i64);
+    const U = std.meta.Int(.unsigned, @bitSizeOf(T));
+
+    // Header: <block size> <miniblocks per block> <total count> <first value>
+    try writeVarintToBuf(DELTA_BLOCK_SIZE, buf, gpa);
+    try writeVarintToBuf(DELTA_MINIBLOCKS, buf, gpa);
+    try writeVarintToBuf(values.len, buf, gpa);
+    try writeZigZagToBuf(if (values.len > 0) values[0] else 0, buf, gpa);
+    if (values.len <= 1) return;
+
+    var deltas: [DELTA_BLOCK_SIZE]T = undefined;
+    var i: usize = 1;
+    while (i < values.len) {
+        const n = @min(DELTA_BLOCK_SIZE, values.len - i);
+        var min_delta: T = std.math.maxInt(T);
+        for (0..n) |j| {
+            deltas[j] = values[i + j] -% values[i + j - 1];
+            min_delta = @min(min_delta, deltas[j]);
+        }
+
+        // Block: <min delta> <miniblock bit widths> <miniblocks>
+        try writeZigZagToBuf(min_delta, buf, gpa);
+
+        var adjusted: [DELTA_BLOCK_SIZE]u64 = @splat(0);
+        var widths: [DELTA_MINIBLOCKS]u8 = @splat(0);
+        for (0..n) |j| {
+            const d: U = @bitCast(deltas[j] -% min_delta);
+            adjusted[j] = d;
+            const w: u8 = @intCast(@bitSizeOf(U) - @clz(d));
+            widths[j / DELTA_MINIBLOCK_SIZE] = @max(widths[j / DELTA_MINIBLOCK_SIZE], w);
+        }
+        try buf.appendSlice(gpa, &widths);
+
+        // Miniblocks past the last value are omitted; a partial last
+        // miniblock is zero-padded to its full size.
+        const used_miniblocks = (n + DELTA_MINIBLOCK_SIZE - 1) / DELTA_MINIBLOCK_SIZE;
+        for (0..used_miniblocks) |m| {
+            const start = m * DELTA_MINIBLOCK_SIZE;
+            try packBits(adjusted[start..][0..DELTA_MINIBLOCK_SIZE], @intCast(widths[m]), buf, gpa);
+        }
+
+        i += n;
+    }
+}
+
+/// Bit-pack `values` at `bit_width` bits each, LSB-first. Emits exactly
+/// `values.len * bit_width / 8` bytes when that product is a multiple of 8.
+fn packBits(values: []const u64, bit_width: u7, buf: *std.ArrayList(u8), gpa: Allocator) !void {
+    if (bit_width == 0) return;
+    try buf.ensureUnusedCapacity(gpa, (values.len * bit_width + 7) / 8);
+
+    var bit_buf: u128 = 0;
+    var bits_in_buf: u8 = 0;
+    for (values) |v| {
+        bit_buf |= @as(u128, v) << @intCast(bits_in_buf);
+        bits_in_buf += bit_width;
+        while (bits_in_buf >= 8) {
+            buf.appendAssumeCapacity(@truncate(bit_buf));
+            bit_buf >>= 8;
+            bits_in_buf -= 8;
+        }
+    }
+    if (bits_in_buf > 0) buf.appendAssumeCapacity(@truncate(bit_buf));
+}
+
+/// Encode fixed-width PLAIN values as BYTE_STREAM_SPLIT: byte k of every
+/// value goes to stream k, and the streams are concatenated. Exponent and
+/// high mantissa bytes of nearby floats then sit together and compress well.
+pub fn encodeByteStreamSplit(plain: []const u8, width: usize, buf: *std.ArrayList(u8), gpa: Allocator) !void {
+    std.debug.assert(plain.len % width == 0);
+    const count = plain.len / width;
+    const out = try buf.addManyAsSlice(gpa, plain.len);
+    for (0..width) |k| {
+        const stream = out[k * count ..][0..count];
+        for (stream, 0..) |*b, i| b.* = plain[i * width + k];
+    }
+}
+
+/// Whether `physical_type` can be written with value `encoding`.
+pub fn supportsEncoding(physical_type: types.PhysicalType, encoding: types.Encoding) bool {
+    return switch (encoding) {
+        .PLAIN => true,
+        .DELTA_BINARY_PACKED => physical_type == .INT32 or physical_type == .INT64,
+        .BYTE_STREAM_SPLIT => physical_type == .FLOAT or physical_type == .DOUBLE,
+        .RLE, .RLE_DICTIONARY => false,
+    };
+}
+
+fn writeZigZagToBuf(value: i64, buf: *std.ArrayList(u8), gpa: Allocator) !void {
+    const zigzag: u64 = @bitCast((value << 1) ^ (value >> 63));
+    try writeVarintToBuf(zigzag, buf, gpa);
+}
+
 fn writeVarintToBuf(value: u64, buf: *std.ArrayList(u8), gpa: Allocator) !void {
     var v = value;
     while (v >= 0x80) {
@@ -157,3 +268,42 @@ fn writeVarintToBuf(value: u64, buf: *std.ArrayList(u8), gpa: Allocator) !void {
     }
     try buf.append(gpa, @as(u8, @intCast(v & 0x7F)));
 }
+
+// ---- Tests ----
+
+test "DELTA_BINARY_PACKED packs a constant stride" {
+    const allocator = std.testing.allocator;
+    var values: [5]i64 = undefined;
+    for (&values, 0..) |*v, i| v.* = 1000 + @as(i64, @intCast(i)) * 10;
+
+    var buf: std.ArrayList(u8) = .empty;
+    defer buf.deinit(allocator);
+    try encodeDeltaBinaryPacked(i64, &values, &buf, allocator);
+
+    // Header: block 128 (varint 0x80 0x01), 4 miniblocks, 5 values, first 1000 (zigzag 2000)
+    // Block: min delta 10 (zigzag 20), all widths 0, no miniblock bytes
+    try std.testing.expectEqualSlices(u8, &.{ 0x80, 0x01, 4, 5, 0xD0, 0x0F, 20, 0, 0, 0, 0 }, buf.items);
+}
+
+test "DELTA_BINARY_PACKED pads the last miniblock" {
+    const allocator = std.testing.allocator;
+    const values = [_]i32{ 7, 5, 3, 4 };
+
+    var buf: std.ArrayList(u8) = .empty;
+    defer buf.deinit(allocator);
+    try encodeDeltaBinaryPacked(i32, &values, &buf, allocator);
+
+    // Deltas -2 -2 1, min -2 (zigzag 3): adjusted 0 0 3 need 2 bits; one
+    // 32-value miniblock of 8 bytes follows the 4 width bytes.
+    try std.testing.expectEqualSlices(u8, &.{ 0x80, 0x01, 4, 4, 14, 3, 2, 0, 0, 0 }, buf.items[0..10]);
+    try std.testing.expectEqual(@as(usize, 18), buf.items.len);
+    try std.testing.expectEqual(@as(u8, 0x30), buf.items[10]);
+}
+
+test "BYTE_STREAM_SPLIT transposes value bytes" {
+    const allocator = std.testing.allocator;
+    var buf: std.ArrayList(u8) = .empty;
+    defer buf.deinit(allocator);
+    try encodeByteStreamSplit(&.{ 1, 2, 3, 4, 5, 6, 7, 8 }, 4, &buf, allocator);
+    try std.testing.expectEqualSlices(u8, &.{ 1, 5, 2, 6, 3, 7, 4, 8 }, buf.items);
+}
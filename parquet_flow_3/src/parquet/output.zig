@@ -0,0 +1,295 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const linux = std.os.linux;
+
+/// How a streaming FileWriter gets its bytes to disk.
+pub const OutputBackend = enum {
+    /// Blocking `write()` calls through the page cache.
+    posix,
+    /// O_DIRECT writes from aligned staging buffers, submitted through
+    /// io_uring with a bounded number in flight. Bypasses the page cache.
+    io_uring,
+};
+
+/// O_DIRECT offset, length and buffer alignment (the common logical block
+/// size; also a page, so the staging buffers are page-aligned).
+pub const DIRECT_ALIGNMENT: usize = 4096;
+
+/// Size of each io_uring staging buffer, and so of each submitted write.
+pub const DIRECT_BUFFER_SIZE: usize = 1 << 20;
+
+pub const DEFAULT_QUEUE_DEPTH: u32 = 4;
+pub const MAX_QUEUE_DEPTH: u32 = 64;
+
+pub const OutputOptions = struct {
+    backend: OutputBackend = .posix,
+    /// io_uring writes in flight (and staging buffers held); 0 selects
+    /// `DEFAULT_QUEUE_DEPTH`.
+    queue_depth: u32 = 0,
+};
+
+/// Destination of a streaming FileWriter. Opening with `.io_uring` falls
+/// back to `.posix` when the kernel refuses io_uring or the filesystem
+/// refuses O_DIRECT (tmpfs, for one); `backend()` reports what was opened.
+pub const FileOutput = union(OutputBackend) {
+    posix: linux.fd_t,
+    io_uring: *DirectOutput,
+
+    pub fn open(allocator: Allocator, path: [*:0]const u8, options: OutputOptions) !FileOutput {
+        if (options.backend == .io_uring) {
+            if (DirectOutput.open(allocator, path, options.queue_depth)) |direct| {
+                return .{ .io_uring = direct };
+            } else |err| switch (err) {
+                error.DirectIoUnsupported => {},
+                else => |e| return e,
+            }
+        }
+        const rc = linux.open(path, .{ .ACCMODE = .WRONLY, .CREAT = true, .TRUNC = true, .CLOEXEC = true }, 0o644);
+        if (linux.errno(rc) != .SUCCESS) return error.FileOpenFailed;
+        return .{ .posix = @intCast(rc) };
+    }
+
+    pub fn backend(self: FileOutput) OutputBackend {
+        return std.meta.activeTag(self);
+    }
+
+    pub fn write(self: FileOutput, bytes: []const u8) !void {
+        switch (self) {
+            .posix => |fd| try writeAll(fd, bytes),
+            .io_uring => |direct| try direct.write(bytes),
+        }
+    }
+
+    /// Wait for every write, optionally fsync, and close. Releases the
+    /// output even when it fails.
+    pub fn close(self: FileOutput, sync: bool) !void {
+        switch (self) {
+            .posix => |fd| {
+                const synced = !sync or linux.errno(linux.fsync(fd)) == .SUCCESS;
+                _ = linux.close(fd);
+                if (!synced) return error.FileSyncFailed;
+            },
+            .io_uring => |direct| try direct.close(sync),
+        }
+    }
+
+    /// Close without waiting for or checking outstanding writes (error paths).
+    pub fn abandon(self: FileOutput) void {
+        switch (self) {
+            .posix => |fd| _ = linux.close(fd),
+            .io_uring => |direct| direct.abandon(),
+        }
+    }
+};
+
+pub fn writeAll(fd: linux.fd_t, bytes: []const u8) !void {
+    var written: usize = 0;
+    while (written < bytes.len) {
+        const rc = linux.write(fd, bytes[written..].ptr, bytes.len - written);
+        switch (linux.errno(rc)) {
+            .SUCCESS => written += rc,
+            .INTR => {},
+            else => return error.FileWriteFailed,
+        }
+    }
+}
+
+/// O_DIRECT file written through io_uring. Bytes are copied into a ring of
+/// `queue_depth` aligned staging buffers; each full buffer is submitted as
+/// one write at its file offset and the caller moves on to the next buffer,
+/// only waiting when that one is still in flight. So at most `queue_depth`
+/// writes are outstanding and `write()` blocks only when the device is
+/// `queue_depth` buffers behind.
+///
+/// O_DIRECT lengths must be aligned too, so `close()` pads the last partial
+/// buffer with zeros, writes it whole, then truncates the file back to its
+/// logical size.
+pub const DirectOutput = struct {
+    gpa: Allocator,
+    fd: linux.fd_t,
+    ring: linux.IoUring,
+    /// `queue_depth` staging buffers of `DIRECT_BUFFER_SIZE`, back to back.
+    staging: []align(DIRECT_ALIGNMENT) u8,
+    /// Submitted length of each buffer still in flight; 0 when free.
+    in_flight: []u32,
+    current: usize,
+    /// Bytes staged in the current buffer.
+    fill: usize,
+    /// File offset of the current buffer (everything before it is submitted).
+    offset: u64,
+    pending: u32,
+
+    pub fn open(allocator: Allocator, path: [*:0]const u8, queue_depth: u32) !*DirectOutput {
+        const depth = std.math.clamp(if (queue_depth == 0) DEFAULT_QUEUE_DEPTH else queue_depth, 1, MAX_QUEUE_DEPTH);
+
+        const self = try allocator.create(DirectOutput);
+        errdefer allocator.destroy(self);
+
+        var ring = linux.IoUring.init(@intCast(std.math.ceilPowerOfTwoAssert(u32, depth)), 0) catch |err| switch (err) {
+            error.SystemOutdated, error.PermissionDenied => return error.DirectIoUnsupported,
+            else => return error.FileOpenFailed,
+        };
+        errdefer ring.deinit();
+
+        const staging = try allocator.alignedAlloc(u8, .fromByteUnits(DIRECT_ALIGNMENT), depth * DIRECT_BUFFER_SIZE);
+        errdefer allocator.free(staging);
+        const in_flight = try allocator.alloc(u32, depth);
+        errdefer allocator.free(in_flight);
+        @memset(in_flight, 0);
+
+        const rc = linux.open(path, .{ .ACCMODE = .WRONLY, .CREAT = true, .TRUNC = true, .CLOEXEC = true, .DIRECT = true }, 0o644);
+        switch (linux.errno(rc)) {
+            .SUCCESS => {},
+            .INVAL => return error.DirectIoUnsupported,
+            else => return error.FileOpenFailed,
+        }
+
+        self.* = .{
+            .gpa = allocator,
+            .fd = @intCast(rc),
+            .ring = ring,
+            .staging = staging,
+            .in_flight = in_flight,
+            .current = 0,
+            .fill = 0,
+            .offset = 0,
+            .pending = 0,
+        };
+        return self;
+    }
+
+    fn buffer(self: *DirectOutput, index: usize) []align(DIRECT_ALIGNMENT) u8 {
+        const start = index * DIRECT_BUFFER_SIZE;
+        return @alignCast(self.staging[start .. start + DIRECT_BUFFER_SIZE]);
+    }
+
+    pub fn write(self: *DirectOutput, bytes: []const u8) !void {
+        var rest = bytes;
+        while (rest.len > 0) {
+            const n = @min(rest.len, DIRECT_BUFFER_SIZE - self.fill);
+            @memcpy(self.buffer(self.current)[self.fill..][0..n], rest[0..n]);
+            self.fill += n;
+            rest = rest[n..];
+            if (self.fill == DIRECT_BUFFER_SIZE) try self.submitCurrent(DIRECT_BUFFER_SIZE);
+        }
+    }
+
+    /// Submit the first `len` (aligned) bytes of the current buffer and
+    /// advance to the next one, waiting until it is free.
+    fn submitCurrent(self: *DirectOutput, len: usize) !void {
+        const index = self.current;
+        _ = try self.ring.write(index, self.fd, self.buffer(index)[0..len], self.offset);
+        _ = try self.ring.submit();
+        self.in_flight[index] = @intCast(len);
+        self.pending += 1;
+        self.offset += len;
+        self.current = (index + 1) % self.in_flight.len;
+        self.fill = 0;
+        while (self.in_flight[self.current] != 0) try self.reapOne();
+    }
+
+    fn reapOne(self: *DirectOutput) !void {
+        const cqe = try self.ring.copy_cqe();
+        const index: usize = @intCast(cqe.user_data);
+        const expected = self.in_flight[index];
+        self.in_flight[index] = 0;
+        self.pending -= 1;
+        // Short O_DIRECT writes only happen on a full or failing device.
+        if (cqe.res < 0 or @as(u32, @intCast(cqe.res)) != expected) return error.FileWriteFailed;
+    }
+
+    pub fn close(self: *DirectOutput, sync: bool) !void {
+        defer self.abandon();
+
+        const logical_size = self.offset + self.fill;
+        if (self.fill > 0) {
+            const len = std.mem.alignForward(usize, self.fill, DIRECT_ALIGNMENT);
+            @memset(self.buffer(self.current)[self.fill..len], 0);
+            try self.submitCurrent(len);
+        }
+        while (self.pending > 0) try self.reapOne();
+
+        if (self.offset != logical_size) {
+            if (linux.errno(linux.ftruncate(self.fd, @intCast(logical_size))) != .SUCCESS) return error.FileWriteFailed;
+        }
+        if (sync and linux.errno(linux.fsync(self.fd)) != .SUCCESS) return error.FileSyncFailed;
+    }
+
+    /// Release everything. Every in-flight write is reaped first, whatever
+    /// its result, so the kernel never writes from freed staging memory. If
+    /// the ring itself fails, the staging buffers are leaked instead.
+    pub fn abandon(self: *DirectOutput) void {
+        const allocator = self.gpa;
+        var drained = true;
+        while (self.pending > 0) {
+            const cqe = self.ring.copy_cqe() catch |err| switch (err) {
+                error.SignalInterrupt => continue,
+                else => {
+                    drained = false;
+                    break;
+                },
+            };
+            self.in_flight[@intCast(cqe.user_data)] = 0;
+            self.pending -= 1;
+        }
+        _ = linux.close(self.fd);
+        self.ring.deinit();
+        allocator.free(self.in_flight);
+        if (drained) allocator.free(self.staging);
+        allocator.destroy(self);
+    }
+};
+
+// ---- Tests ----
+
+fn readBack(allocator: Allocator, path: [*:0]const u8) ![]u8 {
+    const rc = linux.open(path, .{ .ACCMODE = .RDONLY, .CLOEXEC = true }, 0);
+    if (linux.errno(rc) != .SUCCESS) return error.FileOpenFailed;
+    const fd: linux.fd_t = @intCast(rc);
+    defer _ = linux.close(fd);
+
+    var out: std.ArrayList(u8) = .empty;
+    errdefer out.deinit(allocator);
+    var buf: [64 * 1024]u8 = undefined;
+    while (true) {
+        const n = linux.read(fd, &buf, buf.len);
+        if (linux.errno(n) != .SUCCESS) return error.FileReadFailed;
+        if (n == 0) break;
+        try out.appendSlice(allocator, buf[0..n]);
+    }
+    return out.toOwnedSlice(allocator);
+}
+
+test "both backends write the same bytes at an unaligned size" {
+    const allocator = std.testing.allocator;
+    // Several staging buffers' worth plus an unaligned tail
+    const data = try allocator.alloc(u8, 3 * DIRECT_BUFFER_SIZE + 12345);
+    defer allocator.free(data);
+    for (data, 0..) |*b, i| b.* = @truncate(i *% 31);
+
+    // The cache directory is less likely than /tmp to be tmpfs, so the
+    // io_uring run exercises O_DIRECT where the host allows it.
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try @import("../testing.zig").tmpPath(allocator, &tmp, "output.bin");
+    defer allocator.free(path);
+
+    for ([_]OutputBackend{ .posix, .io_uring }) |backend| {
+        const out = try FileOutput.open(allocator, path, .{ .backend = backend, .queue_depth = 2 });
+        // Odd-sized pieces so writes straddle staging buffers
+        var pos: usize = 0;
+        while (pos < data.len) {
+            const n = @min(data.len - pos, 100_003);
+            out.write(data[pos..][0..n]) catch |err| {
+                out.abandon();
+                return err;
+            };
+            pos += n;
+        }
+        try out.close(true);
+
+        const written = try readBack(allocator, path);
+        defer allocator.free(written);
+        try std.testing.expectEqualSlices(u8, data, written);
+    }
+}
@@ -1,20 +1,19 @@
 const std = @import("std");
-const Allocator = std.mem.Allocator;
 const types = @import("types.zig");
 const thrift = @import("thrift.zig");
 const CompactProtocolWriter = thrift.CompactProtocolWriter;
 const compression = @import("compression.zig");
 
-/// A built data page: serialized page header + compressed page data.
+/// A built page (data or dictionary): serialized page header + compressed page data.
+/// Both parts are borrowed: `header_bytes` from the caller's header writer
+/// and `data_bytes` from the compressor (or from the caller's values when
+/// nothing needed copying). They are valid until the next page is built
+/// with the same writer and compressor.
 pub const DataPage = struct {
-    header_bytes: []u8,
-    data_bytes: []u8,
-    gpa: Allocator,
-
-    pub fn deinit(self: *DataPage) void {
-        self.gpa.free(self.header_bytes);
-        self.gpa.free(self.data_bytes);
-    }
+    header_bytes: []const u8,
+    data_bytes: []const u8,
+    /// Page body size before compression.
+    uncompressed_size: usize,
 
     pub fn totalSize(self: *const DataPage) usize {
         return self.header_bytes.len + self.data_bytes.len;
@@ -22,6 +21,7 @@ pub const DataPage = struct {
 };
 
 /// Build a data page from encoded values and optional definition/repetition levels.
+/// The page header is serialized into `header`, which is reset first.
 pub fn buildDataPage(
     encoded_values: []const u8,
     def_levels: ?[]const u8,
@@ -29,34 +29,28 @@ pub fn buildDataPage(
     num_values: i32,
     data_encoding: types.Encoding,
     codec: types.CompressionCodec,
-    allocator: Allocator,
+    compressor: *compression.Compressor,
+    header: *CompactProtocolWriter,
 ) !DataPage {
-    // Assemble uncompressed page body: rep_levels | def_levels | encoded_values
-    var uncompressed_size: usize = 0;
-    if (rep_levels) |rl| uncompressed_size += rl.len;
-    if (def_levels) |dl| uncompressed_size += dl.len;
-    uncompressed_size += encoded_values.len;
-
-    var uncompressed = try allocator.alloc(u8, uncompressed_size);
-    defer allocator.free(uncompressed);
-
-    var offset: usize = 0;
-    if (rep_levels) |rl| {
-        @memcpy(uncompressed[offset..][0..rl.len], rl);
-        offset += rl.len;
-    }
-    if (def_levels) |dl| {
-        @memcpy(uncompressed[offset..][0..dl.len], dl);
-        offset += dl.len;
+    // Page body: rep_levels | def_levels | encoded_values. Without levels the
+    // values are the body, so UNCOMPRESSED pages are never copied here.
+    var body: []const u8 = encoded_values;
+    if (rep_levels != null or def_levels != null) {
+        const scratch = &compressor.body;
+        scratch.clearRetainingCapacity();
+        if (rep_levels) |rl| try scratch.appendSlice(compressor.allocator, rl);
+        if (def_levels) |dl| try scratch.appendSlice(compressor.allocator, dl);
+        try scratch.appendSlice(compressor.allocator, encoded_values);
+        body = scratch.items;
     }
-    @memcpy(uncompressed[offset..][0..encoded_values.len], encoded_values);
+    const uncompressed_size = body.len;
 
     // Compress
-    const compressed_data = try compression.compress(codec, uncompressed, allocator);
+    const compressed_data = try compressor.compress(codec, body);
 
     // Serialize PageHeader
-    var tw = CompactProtocolWriter.init(allocator);
-    defer tw.deinit();
+    const tw = header;
+    tw.reset();
 
     try tw.writeFieldI32(1, @intFromEnum(types.PageType.DATA_PAGE));
     try tw.writeFieldI32(2, @intCast(uncompressed_size));
@@ -73,13 +67,43 @@ pub fn buildDataPage(
 
     try tw.writeFieldStop();
 
-    // Copy header bytes
-    const header_bytes = try allocator.alloc(u8, tw.getWritten().len);
-    @memcpy(header_bytes, tw.getWritten());
+    return DataPage{
+        .header_bytes = tw.getWritten(),
+        .data_bytes = compressed_data,
+        .uncompressed_size = uncompressed_size,
+    };
+}
+
+/// Build a dictionary page from the PLAIN-encoded distinct values, with its
+/// header serialized into `header` like `buildDataPage`.
+pub fn buildDictionaryPage(
+    dict_plain: []const u8,
+    num_values: i32,
+    codec: types.CompressionCodec,
+    compressor: *compression.Compressor,
+    header: *CompactProtocolWriter,
+) !DataPage {
+    const compressed_data = try compressor.compress(codec, dict_plain);
+
+    const tw = header;
+    tw.reset();
+
+    try tw.writeFieldI32(1, @intFromEnum(types.PageType.DICTIONARY_PAGE));
+    try tw.writeFieldI32(2, @intCast(dict_plain.len));
+    try tw.writeFieldI32(3, @intCast(compressed_data.len));
+
+    // field 7: DictionaryPageHeader struct
+    try tw.writeFieldStruct(7);
+    try tw.writeStructBegin();
+    try tw.writeFieldI32(1, num_values);
+    try tw.writeFieldI32(2, @intFromEnum(types.Encoding.PLAIN));
+    try tw.writeStructEnd();
+
+    try tw.writeFieldStop();
 
     return DataPage{
-        .header_bytes = header_bytes,
+        .header_bytes = tw.getWritten(),
         .data_bytes = compressed_data,
-        .gpa = allocator,
+        .uncompressed_size = dict_plain.len,
     };
 }
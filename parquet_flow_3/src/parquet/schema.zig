@@ -25,8 +25,30 @@ pub const ColumnDef = struct {
     repetition_type: types.FieldRepetitionType = .REQUIRED,
     converted_type: ?types.ConvertedType = null,
     logical_type: ?types.LogicalType = null,
+    /// Dictionary-encode this column (RLE_DICTIONARY), falling back to PLAIN
+    /// when the dictionary grows too large or does not pay off. null enables
+    /// it for BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY columns only.
+    dictionary: ?bool = null,
+    /// Value encoding for non-dictionary pages (and dictionary fallback):
+    /// PLAIN, DELTA_BINARY_PACKED (INT32/INT64) or BYTE_STREAM_SPLIT
+    /// (FLOAT/DOUBLE). Unsupported combinations are written as PLAIN.
+    encoding: types.Encoding = .PLAIN,
+    /// Write a split-block Bloom filter for each chunk of this column, for
+    /// point lookups on high-cardinality keys such as order IDs.
+    bloom_filter: bool = false,
+    /// The column is a LIST of required fixed-width `physical_type`
+    /// elements (not BYTE_ARRAY), written
+    /// as the standard three-level group `<name> (LIST) { repeated group
+    /// list { required element; } }`. `repetition_type` then applies to the
+    /// list itself, and values are written per row with
+    /// `ColumnWriter.writeList`.
+    list: bool = false,
 };
 
+/// Names of the repeated group and the leaf of a LIST column.
+pub const LIST_GROUP_NAME = "list";
+pub const LIST_ELEMENT_NAME = "element";
+
 /// Schema: a list of SchemaElements with a root element.
 pub const Schema = struct {
     elements: std.ArrayList(SchemaElement),
@@ -57,8 +79,31 @@ pub const Schema = struct {
             .num_children = @intCast(columns.len),
         });
 
-        // Leaf elements
+        // Leaf elements, each LIST under its two groups
         for (columns) |col| {
+            if (col.list) {
+                try schema.elements.append(allocator, .{
+                    .name = col.name,
+                    .repetition_type = col.repetition_type,
+                    .num_children = 1,
+                    .converted_type = .LIST,
+                    .logical_type = .LIST,
+                });
+                try schema.elements.append(allocator, .{
+                    .name = LIST_GROUP_NAME,
+                    .repetition_type = .REPEATED,
+                    .num_children = 1,
+                });
+                try schema.elements.append(allocator, .{
+                    .name = LIST_ELEMENT_NAME,
+                    .physical_type = col.physical_type,
+                    .type_length = col.type_length,
+                    .repetition_type = .REQUIRED,
+                    .converted_type = col.converted_type,
+                    .logical_type = col.logical_type,
+                });
+                continue;
+            }
             try schema.elements.append(allocator, .{
                 .name = col.name,
                 .physical_type = col.physical_type,
@@ -100,7 +145,6 @@ pub fn writeSchemaElement(writer: *CompactProtocolWriter, elem: SchemaElement) !
     if (elem.logical_type) |lt| {
         try writeLogicalType(writer, lt);
     }
-    try writer.writeFieldStop();
 }
 
 fn writeLogicalType(writer: *CompactProtocolWriter, lt: types.LogicalType) !void {
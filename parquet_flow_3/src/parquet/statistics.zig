@@ -0,0 +1,425 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const types = @import("types.zig");
+const thrift = @import("thrift.zig");
+const CompactProtocolWriter = thrift.CompactProtocolWriter;
+const dictionary = @import("dictionary.zig");
+
+/// Column chunk statistics (ColumnMetaData field 12). `min`/`max` are
+/// PLAIN values without a length prefix, absent when no value is orderable.
+pub const Statistics = struct {
+    null_count: i64,
+    min: ?[]const u8,
+    max: ?[]const u8,
+};
+
+/// Sortedness of page bounds across a column index (BoundaryOrder).
+pub const BoundaryOrder = enum(i32) {
+    UNORDERED = 0,
+    ASCENDING = 1,
+    DESCENDING = 2,
+};
+
+/// Per-page statistics and locations of one column chunk, collected while
+/// its pages are built and written after the row groups as the Parquet page
+/// index (ColumnIndex + OffsetIndex). Chunk statistics are merged from the
+/// pages, so values are only scanned once.
+pub const PageIndex = struct {
+    gpa: Allocator,
+    physical_type: types.PhysicalType,
+    /// INT32/INT64 annotated `INTEGER(_, false)`: bounds sort unsigned.
+    unsigned: bool,
+    /// Min and max bytes of every page, back to back.
+    values: std.ArrayList(u8),
+    pages: std.ArrayList(Page),
+    /// False once a page has non-null values but no min/max (INT96, or
+    /// floats that are all NaN); the chunk then gets no ColumnIndex.
+    orderable: bool,
+
+    pub const Page = struct {
+        /// Offset of the page header from the start of the chunk.
+        offset: i64,
+        /// Header plus compressed body.
+        compressed_size: i32,
+        first_row_index: i64,
+        null_count: i64,
+        /// Null pages (no non-null value) have no bounds.
+        bounds: ?Bounds,
+    };
+
+    const Bounds = struct {
+        min_start: u32,
+        min_len: u32,
+        max_len: u32,
+    };
+
+    pub fn init(allocator: Allocator, physical_type: types.PhysicalType, unsigned: bool) PageIndex {
+        return .{
+            .gpa = allocator,
+            .physical_type = physical_type,
+            .unsigned = unsigned,
+            .values = .empty,
+            .pages = .empty,
+            .orderable = true,
+        };
+    }
+
+    pub fn deinit(self: *PageIndex) void {
+        self.values.deinit(self.gpa);
+        self.pages.deinit(self.gpa);
+    }
+
+    /// Record a data page of `num_values` levels, `null_count` of them null,
+    /// whose non-null values are the PLAIN bytes `plain`.
+    pub fn addPage(
+        self: *PageIndex,
+        offset: i64,
+        compressed_size: usize,
+        first_row_index: i64,
+        num_values: usize,
+        null_count: usize,
+        plain: []const u8,
+        type_length: ?i32,
+    ) !void {
+        var bounds: ?Bounds = null;
+        if (null_count < num_values) {
+            const min_start: u32 = @intCast(self.values.items.len);
+            if (try appendMinMax(self.physical_type, self.unsigned, type_length, plain, &self.values, self.gpa)) |lens| {
+                bounds = .{ .min_start = min_start, .min_len = lens[0], .max_len = lens[1] };
+            } else {
+                self.orderable = false;
+            }
+        }
+        try self.pages.append(self.gpa, .{
+            .offset = offset,
+            .compressed_size = @intCast(compressed_size),
+            .first_row_index = first_row_index,
+            .null_count = @intCast(null_count),
+            .bounds = bounds,
+        });
+    }
+
+    fn minOf(self: *const PageIndex, b: Bounds) []const u8 {
+        return self.values.items[b.min_start..][0..b.min_len];
+    }
+
+    fn maxOf(self: *const PageIndex, b: Bounds) []const u8 {
+        return self.values.items[b.min_start + b.min_len ..][0..b.max_len];
+    }
+
+    /// Chunk statistics merged from the pages; slices borrow `values`.
+    pub fn statistics(self: *const PageIndex) Statistics {
+        var stats = Statistics{ .null_count = 0, .min = null, .max = null };
+        for (self.pages.items) |page| {
+            stats.null_count += page.null_count;
+            const b = page.bounds orelse continue;
+            const min = self.minOf(b);
+            const max = self.maxOf(b);
+            if (stats.min == null or compare(self.physical_type, self.unsigned, min, stats.min.?) == .lt) stats.min = min;
+            if (stats.max == null or compare(self.physical_type, self.unsigned, max, stats.max.?) == .gt) stats.max = max;
+        }
+        if (!self.orderable) {
+            stats.min = null;
+            stats.max = null;
+        }
+        return stats;
+    }
+
+    fn boundaryOrder(self: *const PageIndex) BoundaryOrder {
+        var ascending = true;
+        var descending = true;
+        var prev: ?Bounds = null;
+        for (self.pages.items) |page| {
+            const b = page.bounds orelse continue;
+            if (prev) |p| {
+                const min_order = compare(self.physical_type, self.unsigned, self.minOf(b), self.minOf(p));
+                const max_order = compare(self.physical_type, self.unsigned, self.maxOf(b), self.maxOf(p));
+                if (min_order == .lt or max_order == .lt) ascending = false;
+                if (min_order == .gt or max_order == .gt) descending = false;
+            }
+            prev = b;
+        }
+        if (ascending) return .ASCENDING;
+        if (descending) return .DESCENDING;
+        return .UNORDERED;
+    }
+
+    /// Whether `writeColumnIndex` has anything to write.
+    pub fn hasColumnIndex(self: *const PageIndex) bool {
+        return self.orderable and self.pages.items.len > 0;
+    }
+
+    /// Write the fields of this chunk's ColumnIndex; the caller ends the struct.
+    pub fn writeColumnIndex(self: *const PageIndex, tw: *CompactProtocolWriter) !void {
+        const num_pages: u32 = @intCast(self.pages.items.len);
+
+        try tw.writeFieldList(1, .BOOL_TRUE, num_pages);
+        for (self.pages.items) |page| try tw.writeBool(page.bounds == null);
+
+        try tw.writeFieldList(2, .BINARY, num_pages);
+        for (self.pages.items) |page| {
+            try tw.writeBinary(if (page.bounds) |b| self.minOf(b) else "");
+        }
+
+        try tw.writeFieldList(3, .BINARY, num_pages);
+        for (self.pages.items) |page| {
+            try tw.writeBinary(if (page.bounds) |b| self.maxOf(b) else "");
+        }
+
+        try tw.writeFieldI32(4, @intFromEnum(self.boundaryOrder()));
+
+        try tw.writeFieldList(5, .I64, num_pages);
+        for (self.pages.items) |page| try tw.writeI64(page.null_count);
+    }
+
+    /// Write the fields of this chunk's OffsetIndex, for a chunk starting at
+    /// file offset `chunk_offset`; the caller ends the struct.
+    pub fn writeOffsetIndex(self: *const PageIndex, tw: *CompactProtocolWriter, chunk_offset: i64) !void {
+        try tw.writeFieldList(1, .STRUCT, @intCast(self.pages.items.len));
+        for (self.pages.items) |page| {
+            try tw.writeStructBegin();
+            try tw.writeFieldI64(1, chunk_offset + page.offset);
+            try tw.writeFieldI32(2, page.compressed_size);
+            try tw.writeFieldI64(3, page.first_row_index);
+            try tw.writeStructEnd();
+        }
+    }
+};
+
+/// Write the fields of a Statistics struct; the caller ends the struct.
+pub fn writeStatistics(tw: *CompactProtocolWriter, stats: Statistics) !void {
+    try tw.writeFieldI64(3, stats.null_count);
+    if (stats.max) |max| try tw.writeFieldString(5, max);
+    if (stats.min) |min| try tw.writeFieldString(6, min);
+}
+
+/// Whether a column's logical type makes its INT32/INT64 values sort
+/// unsigned, i.e. it is `INTEGER(_, false)`.
+pub fn isUnsigned(logical_type: ?types.LogicalType) bool {
+    const lt = logical_type orelse return false;
+    return switch (lt) {
+        .INTEGER => |int| !int.is_signed,
+        else => false,
+    };
+}
+
+/// Append the min then the max of the PLAIN values `plain` to `out`, in
+/// Parquet's sort order for `physical_type`: signed for integers (unsigned
+/// if `unsigned`, see `isUnsigned`), numeric for floats (NaN ignored, zero bounds widened to -0.0/+0.0), false <
+/// true for BOOLEAN, unsigned lexicographic for byte arrays. BOOLEAN values
+/// are one byte each, as buffered by ColumnWriter.
+/// Returns the two lengths, or null (nothing appended) if no value is
+/// orderable.
+pub fn appendMinMax(
+    physical_type: types.PhysicalType,
+    unsigned: bool,
+    type_length: ?i32,
+    plain: []const u8,
+    out: *std.ArrayList(u8),
+    gpa: Allocator,
+) !?[2]u32 {
+    switch (physical_type) {
+        .BOOLEAN => return appendFixed(u8, minMaxInt(u8, plain), out, gpa),
+        .INT32 => return if (unsigned)
+            appendFixed(u32, minMaxInt(u32, plain), out, gpa)
+        else
+            appendFixed(i32, minMaxInt(i32, plain), out, gpa),
+        .INT64 => return if (unsigned)
+            appendFixed(u64, minMaxInt(u64, plain), out, gpa)
+        else
+            appendFixed(i64, minMaxInt(i64, plain), out, gpa),
+        .FLOAT => return appendFixed(f32, minMaxFloat(f32, plain) orelse return null, out, gpa),
+        .DOUBLE => return appendFixed(f64, minMaxFloat(f64, plain) orelse return null, out, gpa),
+        .INT96 => return null,
+        .FIXED_LEN_BYTE_ARRAY, .BYTE_ARRAY => {
+            const width = dictionary.plainValueWidth(physical_type, type_length);
+            if (width == 0) return null;
+            var min: ?[]const u8 = null;
+            var max: ?[]const u8 = null;
+            var pos: usize = 0;
+            while (pos < plain.len) {
+                const value = if (width) |w| plain[pos..][0..w] else blk: {
+                    const len = std.mem.readInt(u32, plain[pos..][0..4], .little);
+                    pos += 4;
+                    break :blk plain[pos..][0..len];
+                };
+                pos += value.len;
+                if (min == null or std.mem.order(u8, value, min.?) == .lt) min = value;
+                if (max == null or std.mem.order(u8, value, max.?) == .gt) max = value;
+            }
+            const lo = min orelse return null;
+            try out.appendSlice(gpa, lo);
+            try out.appendSlice(gpa, max.?);
+            return .{ @intCast(lo.len), @intCast(max.?.len) };
+        },
+    }
+}
+
+fn appendFixed(comptime T: type, bounds: [2]T, out: *std.ArrayList(u8), gpa: Allocator) !?[2]u32 {
+    try out.appendSlice(gpa, std.mem.asBytes(&bounds[0]));
+    try out.appendSlice(gpa, std.mem.asBytes(&bounds[1]));
+    return .{ @sizeOf(T), @sizeOf(T) };
+}
+
+/// Values per vector step; 32 bytes fills an AVX2 register.
+fn lanesOf(comptime T: type) comptime_int {
+    return 32 / @sizeOf(T);
+}
+
+/// Min and max of the PLAIN integers in `plain` (at least one value),
+/// reduced a vector at a time.
+fn minMaxInt(comptime T: type, plain: []const u8) [2]T {
+    const lanes = lanesOf(T);
+    const V = @Vector(lanes, T);
+    const n = plain.len / @sizeOf(T);
+
+    var vmin: V = @splat(std.math.maxInt(T));
+    var vmax: V = @splat(std.math.minInt(T));
+    var i: usize = 0;
+    while (i + lanes <= n) : (i += lanes) {
+        const v: V = @bitCast(plain[i * @sizeOf(T) ..][0 .. lanes * @sizeOf(T)].*);
+        vmin = @min(vmin, v);
+        vmax = @max(vmax, v);
+    }
+    var lo = @reduce(.Min, vmin);
+    var hi = @reduce(.Max, vmax);
+    while (i < n) : (i += 1) {
+        const v = std.mem.bytesToValue(T, plain[i * @sizeOf(T) ..][0..@sizeOf(T)]);
+        lo = @min(lo, v);
+        hi = @max(hi, v);
+    }
+    return .{ lo, hi };
+}
+
+/// Min and max of the PLAIN floats in `plain`, ignoring NaN; null if every
+/// value is NaN. Per the Parquet spec a zero min is written as -0.0 and a
+/// zero max as +0.0.
+fn minMaxFloat(comptime T: type, plain: []const u8) ?[2]T {
+    const lanes = lanesOf(T);
+    const V = @Vector(lanes, T);
+    const n = plain.len / @sizeOf(T);
+    const inf = std.math.inf(T);
+
+    var vmin: V = @splat(inf);
+    var vmax: V = @splat(-inf);
+    var seen: @Vector(lanes, bool) = @splat(false);
+    var i: usize = 0;
+    while (i + lanes <= n) : (i += lanes) {
+        const v: V = @bitCast(plain[i * @sizeOf(T) ..][0 .. lanes * @sizeOf(T)].*);
+        const ordered = v == v;
+        vmin = @select(T, ordered, @min(vmin, v), vmin);
+        vmax = @select(T, ordered, @max(vmax, v), vmax);
+        seen = @select(bool, ordered, ordered, seen);
+    }
+    var lo = @reduce(.Min, vmin);
+    var hi = @reduce(.Max, vmax);
+    var any = @reduce(.Or, seen);
+    while (i < n) : (i += 1) {
+        const v = std.mem.bytesToValue(T, plain[i * @sizeOf(T) ..][0..@sizeOf(T)]);
+        if (std.math.isNan(v)) continue;
+        lo = @min(lo, v);
+        hi = @max(hi, v);
+        any = true;
+    }
+    if (!any) return null;
+    if (lo == 0) lo = -0.0;
+    if (hi == 0) hi = 0.0;
+    return .{ lo, hi };
+}
+
+/// Order of two min/max values of `physical_type` as stored by `appendMinMax`.
+pub fn compare(physical_type: types.PhysicalType, unsigned: bool, a: []const u8, b: []const u8) std.math.Order {
+    return switch (physical_type) {
+        .BOOLEAN => std.math.order(a[0], b[0]),
+        .INT32 => if (unsigned)
+            std.math.order(std.mem.bytesToValue(u32, a[0..4]), std.mem.bytesToValue(u32, b[0..4]))
+        else
+            std.math.order(std.mem.bytesToValue(i32, a[0..4]), std.mem.bytesToValue(i32, b[0..4])),
+        .INT64 => if (unsigned)
+            std.math.order(std.mem.bytesToValue(u64, a[0..8]), std.mem.bytesToValue(u64, b[0..8]))
+        else
+            std.math.order(std.mem.bytesToValue(i64, a[0..8]), std.mem.bytesToValue(i64, b[0..8])),
+        .FLOAT => std.math.order(std.mem.bytesToValue(f32, a[0..4]), std.mem.bytesToValue(f32, b[0..4])),
+        .DOUBLE => std.math.order(std.mem.bytesToValue(f64, a[0..8]), std.mem.bytesToValue(f64, b[0..8])),
+        .INT96, .FIXED_LEN_BYTE_ARRAY, .BYTE_ARRAY => std.mem.order(u8, a, b),
+    };
+}
+
+// ---- Tests ----
+
+fn plainOf(comptime T: type, comptime n: usize, values: [n]T) [n * @sizeOf(T)]u8 {
+    return @bitCast(values);
+}
+
+test "integer bounds span the vector and scalar tail" {
+    const allocator = std.testing.allocator;
+    var values: [21]i64 = undefined;
+    for (&values, 0..) |*v, i| v.* = @as(i64, @intCast(i)) * 7 - 50;
+    values[13] = -1000;
+    values[20] = 999;
+
+    var out: std.ArrayList(u8) = .empty;
+    defer out.deinit(allocator);
+    const lens = (try appendMinMax(.INT64, false, null, std.mem.sliceAsBytes(&values), &out, allocator)).?;
+    try std.testing.expectEqual([2]u32{ 8, 8 }, lens);
+    try std.testing.expectEqual(@as(i64, -1000), std.mem.bytesToValue(i64, out.items[0..8]));
+    try std.testing.expectEqual(@as(i64, 999), std.mem.bytesToValue(i64, out.items[8..16]));
+}
+
+test "unsigned integer bounds sort above the signed range" {
+    const allocator = std.testing.allocator;
+    const values = [_]u64{ 5, std.math.maxInt(u64) - 1, 1 << 63, 7, 3, 9, 11, 13, 2 };
+
+    var out: std.ArrayList(u8) = .empty;
+    defer out.deinit(allocator);
+    _ = (try appendMinMax(.INT64, true, null, std.mem.sliceAsBytes(&values), &out, allocator)).?;
+    try std.testing.expectEqual(@as(u64, 2), std.mem.bytesToValue(u64, out.items[0..8]));
+    try std.testing.expectEqual(@as(u64, std.math.maxInt(u64) - 1), std.mem.bytesToValue(u64, out.items[8..16]));
+    try std.testing.expectEqual(std.math.Order.gt, compare(.INT64, true, out.items[8..16], out.items[0..8]));
+    try std.testing.expectEqual(std.math.Order.lt, compare(.INT64, false, out.items[8..16], out.items[0..8]));
+    try std.testing.expect(isUnsigned(.{ .INTEGER = .{ .bit_width = 64, .is_signed = false } }));
+    try std.testing.expect(!isUnsigned(.{ .INTEGER = .{ .bit_width = 64, .is_signed = true } }));
+    try std.testing.expect(!isUnsigned(null));
+}
+
+test "float bounds skip NaN and widen zeros" {
+    const allocator = std.testing.allocator;
+    const nan = std.math.nan(f64);
+    const plain = plainOf(f64, 5, .{ nan, 0.0, 2.5, nan, 0.0 });
+
+    var out: std.ArrayList(u8) = .empty;
+    defer out.deinit(allocator);
+    _ = (try appendMinMax(.DOUBLE, false, null, &plain, &out, allocator)).?;
+    const lo = std.mem.bytesToValue(f64, out.items[0..8]);
+    try std.testing.expect(lo == 0 and std.math.signbit(lo));
+    try std.testing.expectEqual(@as(f64, 2.5), std.mem.bytesToValue(f64, out.items[8..16]));
+
+    // All NaN: no bounds
+    const all_nan = plainOf(f32, 2, .{ std.math.nan(f32), std.math.nan(f32) });
+    try std.testing.expectEqual(@as(?[2]u32, null), try appendMinMax(.FLOAT, false, null, &all_nan, &out, allocator));
+}
+
+test "page index merges chunk statistics and boundary order" {
+    const allocator = std.testing.allocator;
+    var index = PageIndex.init(allocator, .BYTE_ARRAY, false);
+    defer index.deinit();
+
+    var plain: std.ArrayList(u8) = .empty;
+    defer plain.deinit(allocator);
+    const encoding = @import("encoding.zig");
+
+    try encoding.encodePlainByteArray(&.{ "AAPL", "AMZN" }, &plain, allocator);
+    try index.addPage(0, 100, 0, 3, 1, plain.items, null);
+    try index.addPage(100, 20, 3, 2, 2, "", null);
+    plain.clearRetainingCapacity();
+    try encoding.encodePlainByteArray(&.{ "MSFT", "GOOG" }, &plain, allocator);
+    try index.addPage(120, 100, 5, 2, 0, plain.items, null);
+
+    const stats = index.statistics();
+    try std.testing.expectEqual(@as(i64, 3), stats.null_count);
+    try std.testing.expectEqualStrings("AAPL", stats.min.?);
+    try std.testing.expectEqualStrings("MSFT", stats.max.?);
+    try std.testing.expect(index.hasColumnIndex());
+    try std.testing.expectEqual(BoundaryOrder.ASCENDING, index.boundaryOrder());
+    try std.testing.expectEqual(@as(?Bounds, null), index.pages.items[1].bounds);
+}
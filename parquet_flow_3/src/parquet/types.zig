@@ -74,13 +74,16 @@ pub const CompressionCodec = enum(i32) {
     SNAPPY = 1,
     GZIP = 2,
     ZSTD = 6,
+    LZ4_RAW = 7,
 };
 
 /// Encoding types
 pub const Encoding = enum(i32) {
     PLAIN = 0,
     RLE = 3,
+    DELTA_BINARY_PACKED = 5,
     RLE_DICTIONARY = 8,
+    BYTE_STREAM_SPLIT = 9,
 };
 
 /// Page types
@@ -10,6 +10,16 @@ const ColumnDef = schema_mod.ColumnDef;
 const encoding = @import("encoding.zig");
 const compression = @import("compression.zig");
 const page_mod = @import("page.zig");
+const dictionary = @import("dictionary.zig");
+const DictEncoder = dictionary.DictEncoder;
+const statistics = @import("statistics.zig");
+const PageIndex = statistics.PageIndex;
+const bloom_filter = @import("bloom_filter.zig");
+const BloomFilter = bloom_filter.BloomFilter;
+const output_mod = @import("output.zig");
+const cycles = @import("../cycles.zig");
+const FileOutput = output_mod.FileOutput;
+pub const OutputOptions = output_mod.OutputOptions;
 
 // Re-export sub-modules
 pub const schema = schema_mod;
@@ -18,6 +28,12 @@ pub const parquet_thrift = thrift;
 pub const parquet_encoding = encoding;
 pub const parquet_compression = compression;
 pub const parquet_page = page_mod;
+pub const parquet_dictionary = dictionary;
+pub const parquet_statistics = statistics;
+pub const parquet_bloom_filter = bloom_filter;
+pub const parquet_output = output_mod;
+pub const EncoderPool = @import("encoder_pool.zig").EncoderPool;
+pub const Compressor = compression.Compressor;
 
 // Force compile-time evaluation of all transitive imports
 comptime {
@@ -27,17 +43,68 @@ comptime {
     _ = encoding;
     _ = compression;
     _ = page_mod;
+    _ = dictionary;
+    _ = statistics;
+    _ = bloom_filter;
+    _ = output_mod;
 }
 
 /// Metadata for a single column chunk.
 const ColumnChunkInfo = struct {
     physical_type: types.PhysicalType,
     path_in_schema: []const u8,
+    /// Leaf of a LIST column: the path continues through its groups.
+    list: bool,
     codec: types.CompressionCodec,
     num_values: i64,
     total_uncompressed_size: i64,
     total_compressed_size: i64,
     data_page_offset: i64,
+    dictionary_page_offset: ?i64,
+    encodings: EncodingSet,
+    /// File offset of the chunk's first page (dictionary or data).
+    file_offset: i64,
+    /// Owned; statistics and the page index are written from it.
+    page_index: PageIndex,
+    /// Page index locations, set by `FileWriter.close` before the footer.
+    column_index_offset: ?i64 = null,
+    column_index_length: i32 = 0,
+    offset_index_offset: ?i64 = null,
+    offset_index_length: i32 = 0,
+    /// The column writer's filter, borrowed until `FileWriter.closeRowGroup`
+    /// writes it after the row group.
+    bloom_filter: ?*const BloomFilter = null,
+    bloom_filter_offset: ?i64 = null,
+    bloom_filter_length: i32 = 0,
+
+    fn deinit(self: *ColumnChunkInfo) void {
+        self.page_index.deinit();
+    }
+};
+
+/// Encodings used by a column chunk, listed in its ColumnMetaData.
+const EncodingSet = std.EnumSet(types.Encoding);
+
+/// Default target size of a data page's values before encoding (as parquet-mr).
+pub const DEFAULT_PAGE_SIZE: usize = 1 << 20;
+
+/// Where a column chunk is split into data pages. A page ends at the first
+/// row that brings its PLAIN value bytes to `bytes`, or after `rows` rows.
+pub const PageLimits = struct {
+    bytes: usize = DEFAULT_PAGE_SIZE,
+    /// 0 = no row limit.
+    rows: u32 = 0,
+};
+
+/// Start of a page within a chunk's buffered values: row (level) index,
+/// non-null value index, and byte offset into `data_buf`. For LIST columns
+/// a row of levels is one element (or empty or null list), and `record`
+/// counts the rows of the table.
+const PagePos = struct {
+    row: usize = 0,
+    value: usize = 0,
+    byte: usize = 0,
+    record: usize = 0,
 };
 
 /// Writes data for a single column within a row group.
@@ -46,16 +113,39 @@ pub const ColumnWriter = struct {
     column_def: ColumnDef,
     col_index: usize,
     codec: types.CompressionCodec,
+    page_limits: PageLimits,
 
     data_buf: std.ArrayList(u8),
     def_levels_buf: std.ArrayList(u8),
+    /// LIST columns only: 0 where a row starts, 1 for its later elements.
+    rep_levels_buf: std.ArrayList(u8),
     num_values: i64,
     null_count: i64,
 
     pages_buf: std.ArrayList(u8),
     data_page_offset: ?i64,
+    dictionary_page_offset: ?i64,
+    /// Levels are always RLE; page value encodings are added as written.
+    encodings: EncodingSet,
     total_uncompressed_size: i64,
     total_compressed_size: i64,
+    /// Min/max and location of every data page written so far.
+    page_index: PageIndex,
+    /// Sized and filled by `flush` when `column_def.bloom_filter` is set.
+    /// Kept across chunks so an unchanged size reuses the bitset.
+    bloom_filter: ?BloomFilter,
+    /// Time the last `flush` took, and the part of it spent compressing.
+    flush_ns: u64,
+    compress_ns: u64,
+
+    // Scratch reused by every flush; like the data buffers above they keep
+    // their capacity across `reset()`, so a writer reused for each row group
+    // stops allocating once its buffers have grown to the batch size.
+    dict: DictEncoder,
+    levels_buf: std.ArrayList(u8),
+    rep_scratch_buf: std.ArrayList(u8),
+    values_buf: std.ArrayList(u8),
+    header_tw: CompactProtocolWriter,
 
     pub fn init(allocator: Allocator, col_def: ColumnDef, col_index: usize, codec: types.CompressionCodec) ColumnWriter {
         return .{
@@ -63,21 +153,59 @@ pub const ColumnWriter = struct {
             .column_def = col_def,
             .col_index = col_index,
             .codec = codec,
+            .page_limits = .{},
             .data_buf = .empty,
             .def_levels_buf = .empty,
+            .rep_levels_buf = .empty,
             .num_values = 0,
             .null_count = 0,
             .pages_buf = .empty,
             .data_page_offset = null,
+            .dictionary_page_offset = null,
+            .encodings = EncodingSet.initOne(.RLE),
             .total_uncompressed_size = 0,
             .total_compressed_size = 0,
+            .page_index = PageIndex.init(allocator, col_def.physical_type, statistics.isUnsigned(col_def.logical_type)),
+            .bloom_filter = null,
+            .flush_ns = 0,
+            .compress_ns = 0,
+            .dict = DictEncoder.init(allocator),
+            .levels_buf = .empty,
+            .rep_scratch_buf = .empty,
+            .values_buf = .empty,
+            .header_tw = CompactProtocolWriter.init(allocator),
         };
     }
 
     pub fn deinit(self: *ColumnWriter) void {
         self.data_buf.deinit(self.gpa);
         self.def_levels_buf.deinit(self.gpa);
+        self.rep_levels_buf.deinit(self.gpa);
         self.pages_buf.deinit(self.gpa);
+        self.page_index.deinit();
+        if (self.bloom_filter) |*bf| bf.deinit();
+        self.dict.deinit();
+        self.levels_buf.deinit(self.gpa);
+        self.rep_scratch_buf.deinit(self.gpa);
+        self.values_buf.deinit(self.gpa);
+        self.header_tw.deinit();
+    }
+
+    /// Start a new column chunk, keeping every buffer's capacity.
+    pub fn reset(self: *ColumnWriter) void {
+        self.data_buf.clearRetainingCapacity();
+        self.def_levels_buf.clearRetainingCapacity();
+        self.rep_levels_buf.clearRetainingCapacity();
+        self.num_values = 0;
+        self.null_count = 0;
+        self.pages_buf.clearRetainingCapacity();
+        self.data_page_offset = null;
+        self.dictionary_page_offset = null;
+        self.encodings = EncodingSet.initOne(.RLE);
+        self.total_uncompressed_size = 0;
+        self.total_compressed_size = 0;
+        self.page_index.deinit();
+        self.page_index = PageIndex.init(self.gpa, self.column_def.physical_type, statistics.isUnsigned(self.column_def.logical_type));
     }
 
     pub fn writeI32(self: *ColumnWriter, value: i32) !void {
@@ -135,68 +263,340 @@ pub const ColumnWriter = struct {
         self.num_values += 1;
     }
 
+    pub fn writeBool(self: *ColumnWriter, value: bool) !void {
+        try self.data_buf.append(self.gpa, @intFromBool(value));
+        if (self.column_def.repetition_type == .OPTIONAL) {
+            try self.def_levels_buf.append(self.gpa, 1);
+        }
+        self.num_values += 1;
+    }
+
+    /// Append `count` non-null values that are already in PLAIN layout.
+    /// BOOLEAN columns take one byte per value; they are bit-packed on flush.
+    /// LIST columns take their rows through `writeList` instead.
+    pub fn writePlainValues(self: *ColumnWriter, plain: []const u8, count: usize) !void {
+        std.debug.assert(!self.column_def.list);
+        try self.data_buf.appendSlice(self.gpa, plain);
+        if (self.column_def.repetition_type == .OPTIONAL) {
+            try self.def_levels_buf.appendNTimes(self.gpa, 1, count);
+        }
+        self.num_values += @intCast(count);
+    }
+
     pub fn writeNull(self: *ColumnWriter) !void {
         try self.def_levels_buf.append(self.gpa, 0);
+        if (self.column_def.list) try self.rep_levels_buf.append(self.gpa, 0);
         self.num_values += 1;
         self.null_count += 1;
     }
 
-    /// Flush accumulated values into a data page.
-    pub fn flush(self: *ColumnWriter, file_offset: i64) !void {
-        if (self.num_values == 0) return;
+    /// Append one row of a LIST column: `count` elements whose PLAIN values
+    /// are `plain` (BOOLEAN: one byte each). An empty list is a single level
+    /// without a value and, like a null list (`writeNull`), counts towards
+    /// `null_count`.
+    pub fn writeList(self: *ColumnWriter, plain: []const u8, count: usize) !void {
+        std.debug.assert(self.column_def.list);
+        const max_def = self.maxDefLevel();
+        if (count == 0) {
+            try self.def_levels_buf.append(self.gpa, max_def - 1);
+            try self.rep_levels_buf.append(self.gpa, 0);
+            self.num_values += 1;
+            self.null_count += 1;
+            return;
+        }
+        try self.data_buf.appendSlice(self.gpa, plain);
+        try self.def_levels_buf.appendNTimes(self.gpa, max_def, count);
+        try self.rep_levels_buf.append(self.gpa, 0);
+        try self.rep_levels_buf.appendNTimes(self.gpa, 1, count - 1);
+        self.num_values += @intCast(count);
+    }
 
-        // Encode definition levels if optional
-        var def_level_data: ?[]u8 = null;
-        defer if (def_level_data) |b| self.gpa.free(b);
+    /// Definition level of a present value: one for an OPTIONAL column,
+    /// plus one for the repeated group of a LIST.
+    fn maxDefLevel(self: *const ColumnWriter) u8 {
+        return @as(u8, @intFromBool(self.column_def.repetition_type == .OPTIONAL)) + @intFromBool(self.column_def.list);
+    }
 
-        if (self.column_def.repetition_type == .OPTIONAL) {
-            var dl_buf: std.ArrayList(u8) = .empty;
-            defer dl_buf.deinit(self.gpa);
-
-            try encoding.encodeDefinitionLevels(
-                self.def_levels_buf.items,
-                1,
-                &dl_buf,
-                self.gpa,
-            );
-            def_level_data = try dl_buf.toOwnedSlice(self.gpa);
+    /// Flush accumulated values into data pages split at `page_limits`,
+    /// encoding and compressing one page at a time so working buffers stay
+    /// page-sized. Page bytes are appended to `pages_buf`; file offsets are
+    /// assigned later by `takeChunkInfo`, so columns can be flushed in
+    /// parallel (see `EncoderPool`), each thread with its own `compressor`.
+    /// Dictionary-enabled columns build one dictionary over the whole chunk
+    /// and emit it ahead of the first data page. Each page's min/max is
+    /// taken from its PLAIN values while they are still cache-resident, and
+    /// so are its Bloom filter hashes (or once per distinct value from the
+    /// dictionary, which also sizes the filter).
+    pub fn flush(self: *ColumnWriter, compressor: *Compressor) !void {
+        self.flush_ns = 0;
+        self.compress_ns = 0;
+        if (self.num_values == 0) return;
+
+        const start_ns = cycles.monotonicNs();
+        const start_compress_ns = compressor.elapsed_ns;
+        defer {
+            self.flush_ns = cycles.monotonicNs() - start_ns;
+            self.compress_ns = compressor.elapsed_ns - start_compress_ns;
         }
 
-        var data_page = try page_mod.buildDataPage(
-            self.data_buf.items,
-            def_level_data,
-            null,
-            @intCast(self.num_values),
-            .PLAIN,
-            self.codec,
-            self.gpa,
-        );
-        defer data_page.deinit();
+        const num_rows: usize = @intCast(self.num_values);
+        const max_def = self.maxDefLevel();
+        const levels: ?[]const u8 = if (max_def > 0) self.def_levels_buf.items else null;
+
+        const dict = &self.dict;
+        dict.reset();
+        const first_flush = self.data_page_offset == null;
+
+        // Only a chunk's first page can be preceded by its dictionary
+        var value_encoding = self.valueEncoding();
+        if (self.usesDictionary() and first_flush and try self.buildDictionary(dict)) {
+            self.dictionary_page_offset = @intCast(self.pages_buf.items.len);
+            try self.appendPage(try page_mod.buildDictionaryPage(
+                dict.dict_plain.items,
+                @intCast(dict.numEntries()),
+                self.codec,
+                compressor,
+                &self.header_tw,
+            ));
+            self.encodings.insert(.PLAIN);
+            value_encoding = .RLE_DICTIONARY;
+        }
 
-        if (self.data_page_offset == null) {
-            self.data_page_offset = file_offset + @as(i64, @intCast(self.pages_buf.items.len));
+        if (first_flush) {
+            self.data_page_offset = @intCast(self.pages_buf.items.len);
         }
 
-        const page_total: i64 = @intCast(data_page.totalSize());
-        self.total_compressed_size += page_total;
-        self.total_uncompressed_size += page_total;
+        const pt = self.column_def.physical_type;
+        const type_length = self.column_def.type_length;
+        var bloom: ?*BloomFilter = null;
+        if (self.column_def.bloom_filter) {
+            const dict_encoded = value_encoding == .RLE_DICTIONARY;
+            if (first_flush) {
+                const ndv = if (dict_encoded) dict.numEntries() else num_rows - @as(usize, @intCast(self.null_count));
+                if (self.bloom_filter) |*bf| {
+                    try bf.reset(ndv, bloom_filter.DEFAULT_FPP);
+                } else {
+                    self.bloom_filter = try BloomFilter.init(self.gpa, ndv, bloom_filter.DEFAULT_FPP);
+                }
+            }
+            bloom = &self.bloom_filter.?;
+            if (dict_encoded) bloom.?.insertPlainValues(pt, type_length, dict.dict_plain.items);
+        }
 
-        try self.pages_buf.appendSlice(self.gpa, data_page.header_bytes);
-        try self.pages_buf.appendSlice(self.gpa, data_page.data_bytes);
+        const levels_buf = &self.levels_buf;
+        const rep_scratch_buf = &self.rep_scratch_buf;
+        const values_buf = &self.values_buf;
+
+        var start = PagePos{};
+        while (start.row < num_rows) {
+            const end = if (self.column_def.list)
+                self.nextListPageEnd(start, num_rows, levels.?)
+            else
+                self.nextPageEnd(start, num_rows, levels);
+
+            var def_level_data: ?[]const u8 = null;
+            if (levels) |l| {
+                levels_buf.clearRetainingCapacity();
+                try encoding.encodeDefinitionLevels(l[start.row..end.row], max_def, levels_buf, self.gpa);
+                def_level_data = levels_buf.items;
+            }
+            var rep_level_data: ?[]const u8 = null;
+            if (self.column_def.list) {
+                rep_scratch_buf.clearRetainingCapacity();
+                try encoding.encodeRepetitionLevels(self.rep_levels_buf.items[start.row..end.row], 1, rep_scratch_buf, self.gpa);
+                rep_level_data = rep_scratch_buf.items;
+            }
+
+            values_buf.clearRetainingCapacity();
+            const values = try self.encodePageValues(value_encoding, dict, start, end, values_buf);
+
+            const page_offset = self.pages_buf.items.len;
+            try self.appendPage(try page_mod.buildDataPage(
+                values,
+                def_level_data,
+                rep_level_data,
+                @intCast(end.row - start.row),
+                value_encoding,
+                self.codec,
+                compressor,
+                &self.header_tw,
+            ));
+            const page_plain = self.data_buf.items[start.byte..end.byte];
+            const page_rows = end.row - start.row;
+            try self.page_index.addPage(
+                @intCast(page_offset),
+                self.pages_buf.items.len - page_offset,
+                @intCast(if (self.column_def.list) start.record else start.row),
+                page_rows,
+                page_rows - (end.value - start.value),
+                page_plain,
+                type_length,
+            );
+            if (bloom) |bf| {
+                if (value_encoding != .RLE_DICTIONARY) bf.insertPlainValues(pt, type_length, page_plain);
+            }
+            start = end;
+        }
+        self.encodings.insert(value_encoding);
 
         self.data_buf.clearRetainingCapacity();
         self.def_levels_buf.clearRetainingCapacity();
+        self.rep_levels_buf.clearRetainingCapacity();
+    }
+
+    /// End of the page that starts at `start`: at least one row, at most
+    /// `page_limits.rows`, stopping once the page holds `page_limits.bytes`
+    /// of PLAIN values.
+    fn nextPageEnd(self: *const ColumnWriter, start: PagePos, num_rows: usize, levels: ?[]const u8) PagePos {
+        const limits = self.page_limits;
+        const rows_left = num_rows - start.row;
+        const max_rows = if (limits.rows == 0) rows_left else @min(limits.rows, rows_left);
+        const width = dictionary.plainValueWidth(self.column_def.physical_type, self.column_def.type_length);
+        const plain = self.data_buf.items;
+
+        // Required fixed-width values: rows map straight to bytes
+        if (levels == null) {
+            if (width) |w| {
+                const rows = std.math.clamp(limits.bytes / @max(w, 1), 1, max_rows);
+                return .{
+                    .row = start.row + rows,
+                    .value = start.value + rows,
+                    .byte = start.byte + rows * w,
+                };
+            }
+        }
+
+        var end = start;
+        while (end.row - start.row < max_rows) {
+            const present = if (levels) |l| l[end.row] != 0 else true;
+            end.row += 1;
+            if (!present) continue;
+            end.byte += width orelse 4 + std.mem.readInt(u32, plain[end.byte..][0..4], .little);
+            end.value += 1;
+            if (end.byte - start.byte >= limits.bytes) break;
+        }
+        return end;
+    }
+
+    /// `nextPageEnd` for LIST columns. Pages start at a row (repetition
+    /// level 0), as the page index requires, so a list is never split, and
+    /// `page_limits.rows` counts rows rather than elements.
+    fn nextListPageEnd(self: *const ColumnWriter, start: PagePos, num_levels: usize, def_levels: []const u8) PagePos {
+        const limits = self.page_limits;
+        const rep_levels = self.rep_levels_buf.items;
+        const max_def = self.maxDefLevel();
+        const width = dictionary.plainValueWidth(self.column_def.physical_type, self.column_def.type_length).?;
+
+        var end = start;
+        while (end.row < num_levels) : (end.row += 1) {
+            if (rep_levels[end.row] == 0) {
+                if (end.row > start.row) {
+                    if (end.byte - start.byte >= limits.bytes) break;
+                    if (limits.rows != 0 and end.record - start.record >= limits.rows) break;
+                }
+                end.record += 1;
+            }
+            if (def_levels[end.row] == max_def) {
+                end.value += 1;
+                end.byte += width;
+            }
+        }
+        return end;
+    }
+
+    /// Encode the values of one page with `value_encoding`. Returns the
+    /// encoded bytes: `out`, or the PLAIN slice of `data_buf` itself.
+    fn encodePageValues(
+        self: *const ColumnWriter,
+        value_encoding: types.Encoding,
+        dict: *const DictEncoder,
+        start: PagePos,
+        end: PagePos,
+        out: *std.ArrayList(u8),
+    ) ![]const u8 {
+        const plain = self.data_buf.items[start.byte..end.byte];
+        switch (value_encoding) {
+            .RLE_DICTIONARY => try dict.encodeIndices(dict.indices.items[start.value..end.value], out),
+            .PLAIN => {
+                if (self.column_def.physical_type != .BOOLEAN) return plain;
+                try encoding.encodePlainBoolBytes(plain, out, self.gpa);
+            },
+            .DELTA_BINARY_PACKED => switch (self.column_def.physical_type) {
+                .INT32 => try encoding.encodeDeltaBinaryPacked(i32, std.mem.bytesAsSlice(i32, plain), out, self.gpa),
+                .INT64 => try encoding.encodeDeltaBinaryPacked(i64, std.mem.bytesAsSlice(i64, plain), out, self.gpa),
+                else => unreachable,
+            },
+            .BYTE_STREAM_SPLIT => {
+                const width = dictionary.plainValueWidth(self.column_def.physical_type, self.column_def.type_length).?;
+                try encoding.encodeByteStreamSplit(plain, width, out, self.gpa);
+            },
+            .RLE => unreachable,
+        }
+        return out.items;
+    }
+
+    fn usesDictionary(self: *const ColumnWriter) bool {
+        return switch (self.column_def.physical_type) {
+            .BOOLEAN => false,
+            .BYTE_ARRAY, .FIXED_LEN_BYTE_ARRAY => self.column_def.dictionary orelse true,
+            else => self.column_def.dictionary orelse false,
+        };
+    }
+
+    /// The configured value encoding, or PLAIN if the type does not support it.
+    fn valueEncoding(self: *const ColumnWriter) types.Encoding {
+        const requested = self.column_def.encoding;
+        return if (encoding.supportsEncoding(self.column_def.physical_type, requested)) requested else .PLAIN;
     }
 
-    fn getChunkInfo(self: *const ColumnWriter) ColumnChunkInfo {
+    /// Dictionary-encode the buffered values. Returns false (write the
+    /// configured encoding instead) when the dictionary exceeds
+    /// `MAX_DICTIONARY_PAGE_SIZE`, or when it plus bit-packed indices would
+    /// not be smaller than PLAIN.
+    fn buildDictionary(self: *const ColumnWriter, dict: *DictEncoder) !bool {
+        const plain = self.data_buf.items;
+        const width = dictionary.plainValueWidth(self.column_def.physical_type, self.column_def.type_length);
+        if (!try dict.addPlainValues(plain, width, dictionary.MAX_DICTIONARY_PAGE_SIZE)) return false;
+
+        const indices_size = (dict.indices.items.len * dict.bitWidth() + 7) / 8;
+        return dict.dict_plain.items.len + indices_size < plain.len;
+    }
+
+    /// Append a built page to `pages_buf` and account for its size.
+    fn appendPage(self: *ColumnWriter, page: page_mod.DataPage) !void {
+        const header_len: i64 = @intCast(page.header_bytes.len);
+        self.total_compressed_size += @intCast(page.totalSize());
+        self.total_uncompressed_size += header_len + @as(i64, @intCast(page.uncompressed_size));
+
+        try self.pages_buf.appendSlice(self.gpa, page.header_bytes);
+        try self.pages_buf.appendSlice(self.gpa, page.data_bytes);
+    }
+
+    /// Metadata for this chunk once its pages are placed at `chunk_offset`.
+    /// The page index moves into the returned info; the Bloom filter is
+    /// only borrowed, until `closeRowGroup` has written it.
+    fn takeChunkInfo(self: *ColumnWriter, chunk_offset: i64) ColumnChunkInfo {
+        const page_index = self.page_index;
+        self.page_index = PageIndex.init(self.gpa, self.column_def.physical_type, statistics.isUnsigned(self.column_def.logical_type));
+        // A filter left from an earlier chunk is stale if this one is empty
+        const filter: ?*const BloomFilter = if (self.data_page_offset != null and self.bloom_filter != null)
+            &self.bloom_filter.?
+        else
+            null;
         return .{
             .physical_type = self.column_def.physical_type,
             .path_in_schema = self.column_def.name,
+            .list = self.column_def.list,
             .codec = self.codec,
             .num_values = self.num_values,
             .total_uncompressed_size = self.total_uncompressed_size,
             .total_compressed_size = self.total_compressed_size,
-            .data_page_offset = self.data_page_offset orelse 0,
+            .data_page_offset = chunk_offset + (self.data_page_offset orelse 0),
+            .dictionary_page_offset = if (self.dictionary_page_offset) |off| chunk_offset + off else null,
+            .encodings = self.encodings,
+            .file_offset = chunk_offset,
+            .page_index = page_index,
+            .bloom_filter = filter,
         };
     }
 };
@@ -230,6 +630,12 @@ pub const RowGroupWriter = struct {
         self.columns.deinit(self.gpa);
     }
 
+    /// Start the next row group with the same columns and buffers.
+    pub fn reset(self: *RowGroupWriter) void {
+        for (self.columns.items) |*col| col.reset();
+        self.num_rows = 0;
+    }
+
     pub fn column(self: *RowGroupWriter, index: usize) *ColumnWriter {
         return &self.columns.items[index];
     }
@@ -240,16 +646,48 @@ pub const RowGroupWriter = struct {
 };
 
 /// Top-level Parquet file writer.
-/// Builds the entire file in an ArrayList(u8) buffer.
+/// Builds the file in an ArrayList(u8) buffer. When opened with `initFile`,
+/// the buffer is drained to the file's `FileOutput` after every row group,
+/// so only the footer metadata is retained in memory.
 pub const FileWriter = struct {
     gpa: Allocator,
     output: std.ArrayList(u8),
+    file: ?FileOutput,
+    bytes_flushed: u64,
     column_defs: []const ColumnDef,
     schema_val: Schema,
     row_groups_meta: std.ArrayList(RowGroupMeta),
     total_num_rows: i64,
     codec: types.CompressionCodec,
     closed: bool,
+    /// Optional helper threads for encoding columns in parallel. Not owned.
+    encoder_pool: ?*EncoderPool,
+    /// Compression state for columns flushed on the calling thread. Set
+    /// `compressor.level` before the first row group to change the level.
+    compressor: Compressor,
+    /// Data page split applied to row groups created after it is set.
+    page_limits: PageLimits,
+    /// fsync the file in `close()` before closing it.
+    sync_on_close: bool,
+    /// Row group handed out by `rowGroup()`, kept so its column buffers
+    /// are reused by every row group of the file.
+    row_group: ?RowGroupWriter,
+    /// Scratch for Bloom filter headers.
+    scratch_tw: CompactProtocolWriter,
+    /// Cost and size of the last `closeRowGroup`.
+    last_row_group: RowGroupStats,
+
+    /// Encode and compress times are summed over columns, so with an
+    /// encoder pool they are CPU time across threads, not wall time.
+    pub const RowGroupStats = struct {
+        encode_ns: u64 = 0,
+        compress_ns: u64 = 0,
+        /// Handing the row group's bytes to the file output.
+        write_ns: u64 = 0,
+        /// Column chunk bytes before and after compression.
+        uncompressed_bytes: u64 = 0,
+        compressed_bytes: u64 = 0,
+    };
 
     const RowGroupMeta = struct {
         chunks: []ColumnChunkInfo,
@@ -269,48 +707,132 @@ pub const FileWriter = struct {
         return .{
             .gpa = allocator,
             .output = output,
+            .file = null,
+            .bytes_flushed = 0,
             .column_defs = column_defs,
             .schema_val = s,
             .row_groups_meta = .empty,
             .total_num_rows = 0,
             .codec = codec,
             .closed = false,
+            .encoder_pool = null,
+            .compressor = Compressor.init(allocator, 0),
+            .page_limits = .{},
+            .sync_on_close = false,
+            .row_group = null,
+            .scratch_tw = CompactProtocolWriter.init(allocator),
+            .last_row_group = .{},
         };
     }
 
+    /// Create `path` and stream the file to it as row groups are closed,
+    /// with blocking POSIX writes.
+    pub fn initFile(
+        allocator: Allocator,
+        column_defs: []const ColumnDef,
+        codec: types.CompressionCodec,
+        path: [*:0]const u8,
+    ) !FileWriter {
+        return initFileWith(allocator, column_defs, codec, path, .{});
+    }
+
+    /// `initFile` through the output backend chosen in `options`.
+    pub fn initFileWith(
+        allocator: Allocator,
+        column_defs: []const ColumnDef,
+        codec: types.CompressionCodec,
+        path: [*:0]const u8,
+        options: OutputOptions,
+    ) !FileWriter {
+        var self = try FileWriter.init(allocator, column_defs, codec);
+        errdefer self.deinit();
+
+        self.file = try FileOutput.open(allocator, path, options);
+
+        try self.flushOutput();
+        return self;
+    }
+
     pub fn deinit(self: *FileWriter) void {
+        if (self.file) |file| file.abandon();
         self.output.deinit(self.gpa);
+        self.compressor.deinit();
+        if (self.row_group) |*rg| rg.deinit();
+        self.scratch_tw.deinit();
         self.schema_val.deinit();
         for (self.row_groups_meta.items) |meta| {
+            for (meta.chunks) |*chunk| chunk.deinit();
             self.gpa.free(meta.chunks);
         }
         self.row_groups_meta.deinit(self.gpa);
     }
 
     pub fn newRowGroup(self: *FileWriter) !RowGroupWriter {
-        return RowGroupWriter.init(self.gpa, self.column_defs, self.codec);
+        var rg = try RowGroupWriter.init(self.gpa, self.column_defs, self.codec);
+        for (rg.columns.items) |*col| col.page_limits = self.page_limits;
+        return rg;
     }
 
-    pub fn closeRowGroup(self: *FileWriter, rg: *RowGroupWriter) !void {
-        const base_offset: i64 = @intCast(self.output.items.len);
+    /// The writer's own row group, emptied for the next `closeRowGroup`.
+    /// Unlike `newRowGroup`, its value, level, page and scratch buffers keep
+    /// their capacity from one row group to the next, so once they have
+    /// grown to the batch size, filling and closing a row group allocates
+    /// only the footer metadata it leaves behind. Owned by the FileWriter.
+    pub fn rowGroup(self: *FileWriter) !*RowGroupWriter {
+        if (self.row_group) |*rg| {
+            rg.reset();
+        } else {
+            self.row_group = try self.newRowGroup();
+        }
+        const rg = &self.row_group.?;
+        for (rg.columns.items) |*col| col.page_limits = self.page_limits;
+        return rg;
+    }
 
-        var accumulated_offset: i64 = 0;
-        for (rg.columns.items) |*col| {
-            try col.flush(base_offset + accumulated_offset);
-            accumulated_offset += @intCast(col.pages_buf.items.len);
+    /// Absolute file offset of the next byte to be written.
+    pub fn position(self: *const FileWriter) i64 {
+        return @intCast(self.bytes_flushed + self.output.items.len);
+    }
+
+    pub fn closeRowGroup(self: *FileWriter, rg: *RowGroupWriter) !void {
+        if (self.encoder_pool) |pool| {
+            try pool.flushColumns(rg.columns.items, &self.compressor);
+        } else {
+            for (rg.columns.items) |*col| try col.flush(&self.compressor);
         }
 
+        // Chunks are laid out back to back in column order
         var chunks = try self.gpa.alloc(ColumnChunkInfo, rg.columns.items.len);
+        var num_taken: usize = 0;
+        errdefer {
+            for (chunks[0..num_taken]) |*chunk| chunk.deinit();
+            self.gpa.free(chunks);
+        }
         var total_byte_size: i64 = 0;
+        var rg_stats = RowGroupStats{};
 
+        var chunk_offset = self.position();
         for (rg.columns.items, 0..) |*col, i| {
-            chunks[i] = col.getChunkInfo();
+            chunks[i] = col.takeChunkInfo(chunk_offset);
+            num_taken += 1;
+            chunk_offset += @intCast(col.pages_buf.items.len);
             total_byte_size += col.total_compressed_size;
+            rg_stats.encode_ns += col.flush_ns - col.compress_ns;
+            rg_stats.compress_ns += col.compress_ns;
+            rg_stats.uncompressed_bytes += @intCast(col.total_uncompressed_size);
+            rg_stats.compressed_bytes += @intCast(col.total_compressed_size);
         }
 
+        // Streaming writers send each chunk straight to the file output so
+        // the row group is never copied into `output`.
+        const write_start_ns = cycles.monotonicNs();
+        try self.flushOutput();
         for (rg.columns.items) |*col| {
-            try self.output.appendSlice(self.gpa, col.pages_buf.items);
+            try self.emit(col.pages_buf.items);
         }
+        try self.writeBloomFilters(chunks);
+        rg_stats.write_ns = cycles.monotonicNs() - write_start_ns;
+        self.last_row_group = rg_stats;
 
         try self.row_groups_meta.append(self.gpa, .{
             .chunks = chunks,
@@ -321,16 +843,53 @@ pub const FileWriter = struct {
         self.total_num_rows += rg.num_rows;
     }
 
-    /// Finalize and return the complete file bytes.
+    /// Write the Bloom filters of a row group right after its chunks and
+    /// drop the borrowed references, so no filter outlives its row group.
+    fn writeBloomFilters(self: *FileWriter, chunks: []ColumnChunkInfo) !void {
+        const tw = &self.scratch_tw;
+        for (chunks) |*chunk| {
+            const filter = chunk.bloom_filter orelse continue;
+            chunk.bloom_filter = null;
+            tw.reset();
+            try filter.writeHeader(tw);
+            chunk.bloom_filter_offset = self.position();
+            chunk.bloom_filter_length = @intCast(tw.getWritten().len + filter.bitset().len);
+            try self.emit(tw.getWritten());
+            try self.emit(filter.bitset());
+        }
+    }
+
+    fn emit(self: *FileWriter, bytes: []const u8) !void {
+        if (self.file) |file| {
+            try file.write(bytes);
+            self.bytes_flushed += bytes.len;
+        } else {
+            try self.output.appendSlice(self.gpa, bytes);
+        }
+    }
+
+    /// Write buffered bytes to the file output (no-op for in-memory writers).
+    fn flushOutput(self: *FileWriter) !void {
+        const file = self.file orelse return;
+        try file.write(self.output.items);
+        self.bytes_flushed += self.output.items.len;
+        self.output.clearRetainingCapacity();
+    }
+
+    /// Finalize and return the complete file bytes. For writers opened with
+    /// `initFile` the footer is written and the file closed; the
+    /// returned slice is then empty because everything is already on disk.
     pub fn close(self: *FileWriter) ![]const u8 {
         if (self.closed) return self.output.items;
         self.closed = true;
 
-        const footer_offset = self.output.items.len;
-
         var tw = CompactProtocolWriter.init(self.gpa);
         defer tw.deinit();
 
+        try self.writePageIndex(&tw);
+
+        const footer_offset = self.output.items.len;
+
         try tw.writeFieldI32(1, types.FORMAT_VERSION);
 
         try tw.writeFieldList(2, .STRUCT, @intCast(self.schema_val.elements.items.len));
@@ -362,22 +921,53 @@ pub const FileWriter = struct {
 
         try self.output.appendSlice(self.gpa, types.MAGIC);
 
+        if (self.file) |file| {
+            try self.flushOutput();
+            self.file = null;
+            try file.close(self.sync_on_close);
+        }
+
         return self.output.items;
     }
 
+    /// Write every chunk's ColumnIndex, then every OffsetIndex, ahead of the
+    /// footer, and record where each landed for the footer's ColumnChunks.
+    fn writePageIndex(self: *FileWriter, tw: *CompactProtocolWriter) !void {
+        for (self.row_groups_meta.items) |rg_meta| {
+            for (rg_meta.chunks) |*chunk| {
+                if (!chunk.page_index.hasColumnIndex()) continue;
+                tw.reset();
+                try chunk.page_index.writeColumnIndex(tw);
+                try tw.writeFieldStop();
+                chunk.column_index_offset = self.position();
+                chunk.column_index_length = @intCast(tw.getWritten().len);
+                try self.output.appendSlice(self.gpa, tw.getWritten());
+            }
+        }
+        for (self.row_groups_meta.items) |rg_meta| {
+            for (rg_meta.chunks) |*chunk| {
+                if (chunk.page_index.pages.items.len == 0) continue;
+                tw.reset();
+                try chunk.page_index.writeOffsetIndex(tw, chunk.file_offset);
+                try tw.writeFieldStop();
+                chunk.offset_index_offset = self.position();
+                chunk.offset_index_length = @intCast(tw.getWritten().len);
+                try self.output.appendSlice(self.gpa, tw.getWritten());
+            }
+        }
+        tw.reset();
+    }
+
     /// Write the finalized file to disk.
     pub fn writeToFile(self: *FileWriter, path: [*:0]const u8) !void {
         const file_bytes = try self.close();
 
-        const fp = std.c.fopen(path, "wb") orelse return error.FileOpenFailed;
-        defer _ = std.c.fclose(fp);
-
-        var written: usize = 0;
-        while (written < file_bytes.len) {
-            const n = std.c.fwrite(file_bytes[written..].ptr, 1, file_bytes.len - written, fp);
-            if (n == 0) return error.FileWriteFailed;
-            written += n;
-        }
+        const file = try FileOutput.open(self.gpa, path, .{});
+        file.write(file_bytes) catch |err| {
+            file.abandon();
+            return err;
+        };
+        try file.close(false);
     }
 };
 
@@ -391,7 +981,6 @@ fn writeRowGroup(tw: *CompactProtocolWriter, meta: FileWriter.RowGroupMeta) !voi
 
     try tw.writeFieldI64(2, meta.total_byte_size);
     try tw.writeFieldI64(3, meta.num_rows);
-    try tw.writeFieldStop();
 }
 
 fn writeColumnChunk(tw: *CompactProtocolWriter, chunk: ColumnChunkInfo) !void {
@@ -402,18 +991,32 @@ fn writeColumnChunk(tw: *CompactProtocolWriter, chunk: ColumnChunkInfo) !void {
     try writeColumnMetaData(tw, chunk);
     try tw.writeStructEnd();
 
-    try tw.writeFieldStop();
+    if (chunk.offset_index_offset) |off| {
+        try tw.writeFieldI64(4, off);
+        try tw.writeFieldI32(5, chunk.offset_index_length);
+    }
+    if (chunk.column_index_offset) |off| {
+        try tw.writeFieldI64(6, off);
+        try tw.writeFieldI32(7, chunk.column_index_length);
+    }
 }
 
 fn writeColumnMetaData(tw: *CompactProtocolWriter, chunk: ColumnChunkInfo) !void {
     try tw.writeFieldI32(1, @intFromEnum(chunk.physical_type));
 
-    try tw.writeFieldList(2, .I32, 2);
-    try tw.writeI32(@intFromEnum(types.Encoding.PLAIN));
-    try tw.writeI32(@intFromEnum(types.Encoding.RLE));
-
-    try tw.writeFieldList(3, .BINARY, 1);
-    try tw.writeString(chunk.path_in_schema);
+    try tw.writeFieldList(2, .I32, @intCast(chunk.encodings.count()));
+    var it = chunk.encodings.iterator();
+    while (it.next()) |e| try tw.writeI32(@intFromEnum(e));
+
+    if (chunk.list) {
+        try tw.writeFieldList(3, .BINARY, 3);
+        try tw.writeString(chunk.path_in_schema);
+        try tw.writeString(schema_mod.LIST_GROUP_NAME);
+        try tw.writeString(schema_mod.LIST_ELEMENT_NAME);
+    } else {
+        try tw.writeFieldList(3, .BINARY, 1);
+        try tw.writeString(chunk.path_in_schema);
+    }
 
     try tw.writeFieldI32(4, @intFromEnum(chunk.codec));
 
@@ -421,8 +1024,17 @@ fn writeColumnMetaData(tw: *CompactProtocolWriter, chunk: ColumnChunkInfo) !void
     try tw.writeFieldI64(6, chunk.total_uncompressed_size);
     try tw.writeFieldI64(7, chunk.total_compressed_size);
     try tw.writeFieldI64(9, chunk.data_page_offset);
+    if (chunk.dictionary_page_offset) |off| try tw.writeFieldI64(11, off);
 
-    try tw.writeFieldStop();
+    try tw.writeFieldStruct(12);
+    try tw.writeStructBegin();
+    try statistics.writeStatistics(tw, chunk.page_index.statistics());
+    try tw.writeStructEnd();
+
+    if (chunk.bloom_filter_offset) |off| {
+        try tw.writeFieldI64(14, off);
+        try tw.writeFieldI32(15, chunk.bloom_filter_length);
+    }
 }
 
 // ---- Tests ----
@@ -572,3 +1184,348 @@ test "write parquet file with optional column" {
     try testing_alloc.expectEqualSlices(u8, "PAR1", file_bytes[file_bytes.len - 4 ..]);
     try testing_alloc.expect(file_bytes.len > 20);
 }
+
+fn fillTestRowGroup(rg: *RowGroupWriter, g: usize) !void {
+    for (0..100) |i| {
+        const v: i64 = @intCast(g * 100 + i);
+        try rg.column(0).writeI64(v);
+        try rg.column(1).writeF64(@floatFromInt(v));
+        try rg.column(2).writeI32(@intCast(i));
+        try rg.column(3).writeByteArray("abc");
+    }
+    rg.setNumRows(100);
+}
+
+fn writeTestRowGroups(fw: *FileWriter) !void {
+    for (0..3) |g| {
+        var rg = try fw.newRowGroup();
+        defer rg.deinit();
+        try fillTestRowGroup(&rg, g);
+        try fw.closeRowGroup(&rg);
+    }
+}
+
+test "encoder pool output matches serial encoding" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "a", .physical_type = .INT64, .repetition_type = .REQUIRED },
+        .{ .name = "b", .physical_type = .DOUBLE, .repetition_type = .REQUIRED },
+        .{ .name = "c", .physical_type = .INT32, .repetition_type = .REQUIRED },
+        .{ .name = "d", .physical_type = .BYTE_ARRAY, .repetition_type = .REQUIRED },
+    };
+
+    const pool = try EncoderPool.init(allocator, 3, .{});
+    defer pool.deinit();
+
+    for ([_]types.CompressionCodec{ .UNCOMPRESSED, .ZSTD, .LZ4_RAW }) |codec| {
+        var serial = try FileWriter.init(allocator, &columns, codec);
+        defer serial.deinit();
+        try writeTestRowGroups(&serial);
+        const expected = try serial.close();
+
+        var parallel = try FileWriter.init(allocator, &columns, codec);
+        defer parallel.deinit();
+        parallel.encoder_pool = pool;
+        try writeTestRowGroups(&parallel);
+        const actual = try parallel.close();
+
+        try testing_alloc.expectEqualSlices(u8, expected, actual);
+    }
+}
+
+test "reused row group matches fresh row groups and keeps its buffers" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "a", .physical_type = .INT64, .repetition_type = .REQUIRED, .bloom_filter = true },
+        .{ .name = "b", .physical_type = .DOUBLE, .repetition_type = .REQUIRED },
+        .{ .name = "c", .physical_type = .INT32, .repetition_type = .REQUIRED },
+        .{ .name = "d", .physical_type = .BYTE_ARRAY, .repetition_type = .REQUIRED },
+    };
+
+    var fresh = try FileWriter.init(allocator, &columns, .ZSTD);
+    defer fresh.deinit();
+    try writeTestRowGroups(&fresh);
+    const expected = try fresh.close();
+
+    var reused = try FileWriter.init(allocator, &columns, .ZSTD);
+    defer reused.deinit();
+    var data_ptr: ?[*]u8 = null;
+    var pages_ptr: ?[*]u8 = null;
+    for (0..3) |g| {
+        const rg = try reused.rowGroup();
+        try fillTestRowGroup(rg, g);
+        try reused.closeRowGroup(rg);
+
+        // Same-sized row groups fit the buffers the first one grew
+        const col = rg.column(3);
+        if (data_ptr) |p| try testing_alloc.expectEqual(p, col.data_buf.items.ptr);
+        if (pages_ptr) |p| try testing_alloc.expectEqual(p, col.pages_buf.items.ptr);
+        data_ptr = col.data_buf.items.ptr;
+        pages_ptr = col.pages_buf.items.ptr;
+    }
+    const actual = try reused.close();
+
+    try testing_alloc.expectEqualSlices(u8, expected, actual);
+}
+
+test "compressed chunks track uncompressed size" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "a", .physical_type = .INT64, .repetition_type = .REQUIRED },
+    };
+
+    var fw = try FileWriter.init(allocator, &columns, .ZSTD);
+    defer fw.deinit();
+
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    for (0..1000) |_| try rg.column(0).writeI64(7);
+    rg.setNumRows(1000);
+    try fw.closeRowGroup(&rg);
+
+    const chunk = fw.row_groups_meta.items[0].chunks[0];
+    try testing_alloc.expect(chunk.total_uncompressed_size > 8000);
+    try testing_alloc.expect(chunk.total_compressed_size < chunk.total_uncompressed_size);
+    _ = try fw.close();
+}
+
+fn writeSymbolRowGroup(fw: *FileWriter) !void {
+    const symbols = [_][]const u8{ "AAPL", "MSFT", "GOOG", "AMZN" };
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    for (0..1000) |i| {
+        try rg.column(0).writeByteArray(symbols[i % symbols.len]);
+        try rg.column(1).writeI64(@intCast(i));
+    }
+    rg.setNumRows(1000);
+    try fw.closeRowGroup(&rg);
+}
+
+test "byte array columns are dictionary encoded" {
+    const allocator = testing_alloc.allocator;
+    const dict_columns = [_]ColumnDef{
+        .{ .name = "symbol", .physical_type = .BYTE_ARRAY },
+        .{ .name = "id", .physical_type = .INT64 },
+    };
+    const plain_columns = [_]ColumnDef{
+        .{ .name = "symbol", .physical_type = .BYTE_ARRAY, .dictionary = false },
+        .{ .name = "id", .physical_type = .INT64 },
+    };
+
+    var dict_fw = try FileWriter.init(allocator, &dict_columns, .UNCOMPRESSED);
+    defer dict_fw.deinit();
+    try writeSymbolRowGroup(&dict_fw);
+
+    var plain_fw = try FileWriter.init(allocator, &plain_columns, .UNCOMPRESSED);
+    defer plain_fw.deinit();
+    try writeSymbolRowGroup(&plain_fw);
+
+    const dict_chunks = dict_fw.row_groups_meta.items[0].chunks;
+    const plain_chunks = plain_fw.row_groups_meta.items[0].chunks;
+
+    // The dictionary page comes first; the data page follows it
+    const dict_off = dict_chunks[0].dictionary_page_offset orelse return error.TestExpectedDictionary;
+    try testing_alloc.expect(dict_chunks[0].data_page_offset > dict_off);
+    try testing_alloc.expect(dict_chunks[0].total_compressed_size < plain_chunks[0].total_compressed_size);
+
+    // Numeric columns stay PLAIN by default
+    try testing_alloc.expectEqual(@as(?i64, null), dict_chunks[1].dictionary_page_offset);
+    try testing_alloc.expectEqual(@as(?i64, null), plain_chunks[0].dictionary_page_offset);
+
+    _ = try dict_fw.close();
+    _ = try plain_fw.close();
+}
+
+fn writeSequenceRowGroup(fw: *FileWriter, num_rows: usize) !void {
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    for (0..num_rows) |i| try rg.column(0).writeI64(@intCast(i));
+    rg.setNumRows(@intCast(num_rows));
+    try fw.closeRowGroup(&rg);
+}
+
+test "column chunks split into pages at the page limits" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "a", .physical_type = .INT64, .repetition_type = .REQUIRED },
+    };
+
+    var single = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer single.deinit();
+    try writeSequenceRowGroup(&single, 1000);
+
+    // 800 bytes of INT64 values per page: ten pages of 100 rows
+    var paged = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer paged.deinit();
+    paged.page_limits = .{ .bytes = 800 };
+    try writeSequenceRowGroup(&paged, 1000);
+
+    // Same values, and every header encodes the same varint widths
+    const single_overhead = single.row_groups_meta.items[0].chunks[0].total_compressed_size - 8000;
+    const paged_overhead = paged.row_groups_meta.items[0].chunks[0].total_compressed_size - 8000;
+    try testing_alloc.expectEqual(10 * single_overhead, paged_overhead);
+
+    // A row limit splits as well
+    var by_rows = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer by_rows.deinit();
+    by_rows.page_limits = .{ .rows = 250 };
+    try writeSequenceRowGroup(&by_rows, 1000);
+    const by_rows_overhead = by_rows.row_groups_meta.items[0].chunks[0].total_compressed_size - 8000;
+    try testing_alloc.expectEqual(4 * single_overhead, by_rows_overhead);
+
+    _ = try single.close();
+    _ = try paged.close();
+    _ = try by_rows.close();
+}
+
+test "optional and dictionary columns split into pages" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "symbol", .physical_type = .BYTE_ARRAY },
+        .{ .name = "qty", .physical_type = .INT32, .repetition_type = .OPTIONAL },
+    };
+
+    var fw = try FileWriter.init(allocator, &columns, .ZSTD);
+    defer fw.deinit();
+    fw.page_limits = .{ .bytes = 256, .rows = 100 };
+
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    const symbols = [_][]const u8{ "AAPL", "MSFT", "GOOG" };
+    for (0..1000) |i| {
+        try rg.column(0).writeByteArray(symbols[i % symbols.len]);
+        if (i % 4 == 0) try rg.column(1).writeNull() else try rg.column(1).writeI32(@intCast(i));
+    }
+    rg.setNumRows(1000);
+    try fw.closeRowGroup(&rg);
+
+    const chunks = fw.row_groups_meta.items[0].chunks;
+    try testing_alloc.expect(chunks[0].dictionary_page_offset != null);
+    try testing_alloc.expectEqual(@as(i64, 1000), chunks[0].num_values);
+    try testing_alloc.expectEqual(@as(i64, 1000), chunks[1].num_values);
+    _ = try fw.close();
+}
+
+test "chunks carry statistics and a page index" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "a", .physical_type = .INT64, .repetition_type = .REQUIRED },
+    };
+
+    var fw = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer fw.deinit();
+    fw.page_limits = .{ .bytes = 800 };
+    try writeSequenceRowGroup(&fw, 1000);
+
+    const chunk = &fw.row_groups_meta.items[0].chunks[0];
+    const index = &chunk.page_index;
+    try testing_alloc.expectEqual(@as(usize, 10), index.pages.items.len);
+    try testing_alloc.expectEqual(@as(i64, 0), index.pages.items[0].offset);
+    try testing_alloc.expectEqual(@as(i64, 900), index.pages.items[9].first_row_index);
+
+    const stats = index.statistics();
+    try testing_alloc.expectEqual(@as(i64, 0), stats.null_count);
+    try testing_alloc.expectEqual(@as(i64, 0), std.mem.bytesToValue(i64, stats.min.?[0..8]));
+    try testing_alloc.expectEqual(@as(i64, 999), std.mem.bytesToValue(i64, stats.max.?[0..8]));
+
+    // The column index comes right after the row group, the offset index
+    // after it, and the footer after both
+    const file_bytes = try fw.close();
+    const chunk_end = chunk.file_offset + chunk.total_compressed_size;
+    try testing_alloc.expectEqual(@as(?i64, chunk_end), chunk.column_index_offset);
+    try testing_alloc.expectEqual(@as(?i64, chunk_end + chunk.column_index_length), chunk.offset_index_offset);
+
+    const meta_len = std.mem.readInt(u32, file_bytes[file_bytes.len - 8 ..][0..4], .little);
+    const footer_start: i64 = @intCast(file_bytes.len - 8 - meta_len);
+    try testing_alloc.expectEqual(footer_start, chunk.offset_index_offset.? + chunk.offset_index_length);
+}
+
+test "list columns write repetition levels and pages of whole rows" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "bid_px", .physical_type = .INT64, .repetition_type = .OPTIONAL, .list = true },
+    };
+
+    var s = try Schema.buildFromColumns(allocator, &columns);
+    defer s.deinit();
+    try testing_alloc.expectEqual(@as(usize, 4), s.elements.items.len);
+    try testing_alloc.expectEqual(@as(?types.FieldRepetitionType, .REPEATED), s.elements.items[2].repetition_type);
+    try testing_alloc.expectEqual(@as(?types.PhysicalType, .INT64), s.elements.items[3].physical_type);
+
+    var fw = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer fw.deinit();
+    fw.page_limits = .{ .rows = 30 };
+
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    // Row i holds i % 5 book levels (none: an empty list); rows 7, 57, ... are null
+    var book: [4]i64 = undefined;
+    for (0..200) |i| {
+        if (i % 50 == 7) {
+            try rg.column(0).writeNull();
+            continue;
+        }
+        const n = i % 5;
+        for (book[0..n], 0..) |*px, k| px.* = @intCast(i * 10 + k);
+        try rg.column(0).writeList(std.mem.sliceAsBytes(book[0..n]), n);
+    }
+    rg.setNumRows(200);
+    try fw.closeRowGroup(&rg);
+
+    const chunk = &fw.row_groups_meta.items[0].chunks[0];
+    try testing_alloc.expectEqual(@as(i64, 436), chunk.num_values);
+    const pages = chunk.page_index.pages.items;
+    try testing_alloc.expectEqual(@as(usize, 7), pages.len);
+    for (pages, 0..) |page, k| {
+        try testing_alloc.expectEqual(@as(i64, @intCast(k * 30)), page.first_row_index);
+    }
+    const stats = chunk.page_index.statistics();
+    try testing_alloc.expectEqual(@as(i64, 44), stats.null_count);
+    try testing_alloc.expectEqual(@as(i64, 10), std.mem.bytesToValue(i64, stats.min.?[0..8]));
+    try testing_alloc.expectEqual(@as(i64, 1993), std.mem.bytesToValue(i64, stats.max.?[0..8]));
+    _ = try fw.close();
+}
+
+test "bloom filter columns write a filter after each row group" {
+    const allocator = testing_alloc.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "order_id", .physical_type = .INT64, .bloom_filter = true },
+        .{ .name = "symbol", .physical_type = .BYTE_ARRAY, .bloom_filter = true },
+        .{ .name = "qty", .physical_type = .INT32 },
+    };
+
+    var fw = try FileWriter.init(allocator, &columns, .UNCOMPRESSED);
+    defer fw.deinit();
+    fw.page_limits = .{ .rows = 300 };
+
+    const symbols = [_][]const u8{ "AAPL", "MSFT", "GOOG" };
+    var rg = try fw.newRowGroup();
+    defer rg.deinit();
+    for (0..1000) |i| {
+        try rg.column(0).writeI64(@intCast(i * 7919));
+        try rg.column(1).writeByteArray(symbols[i % symbols.len]);
+        try rg.column(2).writeI32(@intCast(i));
+    }
+    rg.setNumRows(1000);
+    try fw.closeRowGroup(&rg);
+
+    const chunks = fw.row_groups_meta.items[0].chunks;
+    try testing_alloc.expectEqual(@as(?i64, null), chunks[2].bloom_filter_offset);
+    const last = chunks[2].file_offset + chunks[2].total_compressed_size;
+    try testing_alloc.expectEqual(@as(?i64, last), chunks[0].bloom_filter_offset);
+
+    // The bitset ends each filter and matches one built from the values
+    var expected = try BloomFilter.init(allocator, 1000, bloom_filter.DEFAULT_FPP);
+    defer expected.deinit();
+    for (0..1000) |i| {
+        const v: i64 = @intCast(i * 7919);
+        expected.insert(std.mem.asBytes(&v));
+    }
+    const end: usize = @intCast(chunks[0].bloom_filter_offset.? + chunks[0].bloom_filter_length);
+    try testing_alloc.expectEqualSlices(u8, expected.bitset(), fw.output.items[end - expected.bitset().len .. end]);
+
+    // Dictionary chunks are sized by their distinct values
+    try testing_alloc.expectEqual(@as(?i64, @intCast(end)), chunks[1].bloom_filter_offset);
+    try testing_alloc.expect(chunks[1].bloom_filter_length < 64);
+    _ = try fw.close();
+}
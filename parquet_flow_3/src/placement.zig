@@ -0,0 +1,229 @@
+const std = @import("std");
+const linux = std.os.linux;
+
+/// CPUs a `CpuSet` can name, matching glibc's cpu_set_t.
+pub const MAX_CPUS = 1024;
+const WORD_BITS = @bitSizeOf(usize);
+
+// <linux/mempolicy.h>
+const MPOL_DEFAULT = 0;
+const MPOL_BIND = 2;
+const MPOL_MF_MOVE = 1 << 1;
+/// Node mask bits passed to the kernel, plus the one it historically drops.
+const MAX_NODE_BITS = @bitSizeOf(u64) + 1;
+
+const HUGE_PAGE_SIZE = 2 << 20;
+
+/// A set of CPUs for `sched_setaffinity`, parsed from a Linux CPU list such
+/// as "3" or "0-3,8,10-11" (the format of `taskset -c` and /sys).
+pub const CpuSet = struct {
+    words: [MAX_CPUS / WORD_BITS]usize,
+
+    pub const empty: CpuSet = .{ .words = @splat(0) };
+
+    pub fn parse(list: []const u8) !CpuSet {
+        var set = empty;
+        var items = std.mem.tokenizeScalar(u8, list, ',');
+        while (items.next()) |raw| {
+            const item = std.mem.trim(u8, raw, " ");
+            const dash = std.mem.indexOfScalar(u8, item, '-');
+            const first_text = if (dash) |d| item[0..d] else item;
+            const last_text = if (dash) |d| item[d + 1 ..] else item;
+            const first = std.fmt.parseInt(u16, first_text, 10) catch return error.InvalidCpuList;
+            const last = std.fmt.parseInt(u16, last_text, 10) catch return error.InvalidCpuList;
+            if (last < first or last >= MAX_CPUS) return error.InvalidCpuList;
+            for (first..last + 1) |cpu| set.add(@intCast(cpu));
+        }
+        if (set.count() == 0) return error.InvalidCpuList;
+        return set;
+    }
+
+    pub fn single(cpu: u16) CpuSet {
+        var set = empty;
+        set.add(cpu);
+        return set;
+    }
+
+    pub fn add(self: *CpuSet, cpu: u16) void {
+        self.words[cpu / WORD_BITS] |= @as(usize, 1) << @intCast(cpu % WORD_BITS);
+    }
+
+    pub fn contains(self: *const CpuSet, cpu: u16) bool {
+        return self.words[cpu / WORD_BITS] & (@as(usize, 1) << @intCast(cpu % WORD_BITS)) != 0;
+    }
+
+    pub fn count(self: *const CpuSet) u32 {
+        var n: u32 = 0;
+        for (self.words) |w| n += @popCount(w);
+        return n;
+    }
+
+    /// The `k`-th CPU of the set, in ascending order, wrapping around.
+    pub fn nth(self: *const CpuSet, k: u32) u16 {
+        var left = k % self.count();
+        for (0..MAX_CPUS) |cpu| {
+            if (!self.contains(@intCast(cpu))) continue;
+            if (left == 0) return @intCast(cpu);
+            left -= 1;
+        }
+        unreachable;
+    }
+};
+
+/// Where one background thread runs and allocates. Applied by the thread
+/// itself as it starts; a kernel that refuses (cgroup cpuset, no NUMA)
+/// leaves the thread where it was rather than failing the sink.
+pub const ThreadPlacement = struct {
+    /// Empty leaves the thread unpinned.
+    cpus: CpuSet = .empty,
+    /// Bit n binds the thread's allocations to NUMA node n; 0 leaves the
+    /// default first-touch policy.
+    numa_nodes: u64 = 0,
+
+    pub fn apply(self: *const ThreadPlacement) void {
+        if (self.cpus.count() > 0) _ = pinCurrentThread(&self.cpus);
+        if (self.numa_nodes != 0) _ = setThreadNodes(self.numa_nodes);
+    }
+
+    /// Placement of helper `k` of a pool: one CPU of the set each, round
+    /// robin, so helpers never migrate between the cores they were given.
+    pub fn forWorker(self: ThreadPlacement, k: u32) ThreadPlacement {
+        var out = self;
+        if (self.cpus.count() > 0) out.cpus = CpuSet.single(self.cpus.nth(k));
+        return out;
+    }
+};
+
+/// Restrict the calling thread to `set`. Returns false if the kernel refused.
+pub fn pinCurrentThread(set: *const CpuSet) bool {
+    const rc = linux.syscall3(.sched_setaffinity, 0, @sizeOf(CpuSet), @intFromPtr(&set.words));
+    return linux.errno(rc) == .SUCCESS;
+}
+
+/// Bind the calling thread's future page allocations to `nodes` (bit n =
+/// node n). Returns false if the kernel refused.
+pub fn setThreadNodes(nodes: u64) bool {
+    const rc = linux.syscall3(.set_mempolicy, MPOL_BIND, @intFromPtr(&nodes), MAX_NODE_BITS);
+    return linux.errno(rc) == .SUCCESS;
+}
+
+/// The calling thread's memory policy, to put back after allocating on
+/// behalf of threads bound elsewhere.
+pub const SavedPolicy = struct {
+    mode: i32 = MPOL_DEFAULT,
+    nodes: u64 = 0,
+
+    pub fn save() SavedPolicy {
+        var out = SavedPolicy{};
+        const rc = linux.syscall5(.get_mempolicy, @intFromPtr(&out.mode), @intFromPtr(&out.nodes), MAX_NODE_BITS, 0, 0);
+        if (linux.errno(rc) != .SUCCESS) return .{};
+        return out;
+    }
+
+    pub fn restore(self: *const SavedPolicy) void {
+        const mask: usize = if (self.mode == MPOL_DEFAULT) 0 else @intFromPtr(&self.nodes);
+        _ = linux.syscall3(.set_mempolicy, @as(u32, @bitCast(self.mode)), mask, MAX_NODE_BITS);
+    }
+};
+
+/// Bind the pages of `memory` to `nodes`, moving any already faulted in.
+/// Returns false if the kernel refused.
+pub fn bindMemory(memory: []align(std.heap.page_size_min) u8, nodes: u64) bool {
+    const rc = linux.syscall6(.mbind, @intFromPtr(memory.ptr), memory.len, MPOL_BIND, @intFromPtr(&nodes), MAX_NODE_BITS, MPOL_MF_MOVE);
+    return linux.errno(rc) == .SUCCESS;
+}
+
+/// Write one byte per page so every page of `memory` is faulted in now
+/// instead of on first use.
+pub fn prefault(memory: []u8) void {
+    var i: usize = 0;
+    while (i < memory.len) : (i += std.heap.page_size_min) {
+        @as(*volatile u8, &memory[i]).* = 0;
+    }
+}
+
+/// Page size backing a `Region`.
+pub const PagePolicy = enum(i32) {
+    /// Regular pages.
+    default = 0,
+    /// Transparent huge pages: a 2 MiB-aligned mapping with MADV_HUGEPAGE.
+    transparent = 1,
+    /// MAP_HUGETLB from the reserved pool (vm.nr_hugepages); falls back to
+    /// `.transparent` when the pool cannot satisfy the mapping.
+    hugetlb = 2,
+};
+
+/// Anonymous memory mapped directly rather than taken from an allocator,
+/// so its page size, NUMA node and residency can be chosen.
+pub const Region = struct {
+    /// The `len` bytes asked for, page aligned (2 MiB aligned for huge pages).
+    memory: []align(std.heap.page_size_min) u8,
+    mapping: []align(std.heap.page_size_min) u8,
+
+    pub fn alloc(len: usize, pages: PagePolicy, numa_nodes: u64, populate: bool) !Region {
+        var region: Region = switch (pages) {
+            .default => try map(std.mem.alignForward(usize, len, std.heap.page_size_min), false),
+            .transparent => try mapTransparent(len),
+            .hugetlb => map(std.mem.alignForward(usize, len, HUGE_PAGE_SIZE), true) catch try mapTransparent(len),
+        };
+        region.memory = region.memory[0..len];
+
+        // Policy first, so the pages fault in on the right node
+        if (numa_nodes != 0) _ = bindMemory(region.mapping, numa_nodes);
+        if (populate) prefault(region.memory);
+        return region;
+    }
+
+    pub fn free(self: Region) void {
+        _ = linux.munmap(self.mapping.ptr, self.mapping.len);
+    }
+
+    fn map(len: usize, hugetlb: bool) !Region {
+        const addr = linux.mmap(null, len, linux.PROT.READ | linux.PROT.WRITE, .{ .TYPE = .PRIVATE, .ANONYMOUS = true, .HUGETLB = hugetlb }, -1, 0);
+        if (linux.errno(addr) != .SUCCESS) return error.OutOfMemory;
+        const mapping = @as([*]align(std.heap.page_size_min) u8, @ptrFromInt(addr))[0..len];
+        return .{ .memory = mapping, .mapping = mapping };
+    }
+
+    /// Over-map by one huge page so a 2 MiB-aligned range fits, which THP
+    /// needs to back it with huge pages.
+    fn mapTransparent(len: usize) !Region {
+        const huge_len = std.mem.alignForward(usize, len, HUGE_PAGE_SIZE);
+        const region = try map(huge_len + HUGE_PAGE_SIZE, false);
+        const start = std.mem.alignForward(usize, @intFromPtr(region.mapping.ptr), HUGE_PAGE_SIZE);
+        const memory = @as([*]align(std.heap.page_size_min) u8, @ptrFromInt(start))[0..huge_len];
+        _ = linux.madvise(memory.ptr, memory.len, linux.MADV.HUGEPAGE);
+        return .{ .memory = memory, .mapping = region.mapping };
+    }
+};
+
+// ---- Tests ----
+
+test "cpu lists" {
+    const set = try CpuSet.parse("0-3, 8,130-131");
+    try std.testing.expectEqual(@as(u32, 7), set.count());
+    try std.testing.expect(set.contains(2) and set.contains(8) and set.contains(131));
+    try std.testing.expect(!set.contains(4));
+    try std.testing.expectEqual(@as(u16, 8), set.nth(4));
+    try std.testing.expectEqual(@as(u16, 130), set.nth(5));
+    try std.testing.expectEqual(@as(u16, 0), set.nth(7));
+
+    const worker = (ThreadPlacement{ .cpus = set }).forWorker(5);
+    try std.testing.expectEqual(@as(u32, 1), worker.cpus.count());
+    try std.testing.expect(worker.cpus.contains(130));
+
+    try std.testing.expectError(error.InvalidCpuList, CpuSet.parse("3-1"));
+    try std.testing.expectError(error.InvalidCpuList, CpuSet.parse("x"));
+    try std.testing.expectError(error.InvalidCpuList, CpuSet.parse(""));
+    try std.testing.expectError(error.InvalidCpuList, CpuSet.parse("1024"));
+}
+
+test "regions of every page policy are usable" {
+    for ([_]PagePolicy{ .default, .transparent, .hugetlb }) |pages| {
+        const region = try Region.alloc(1 << 16, pages, 0, true);
+        defer region.free();
+        try std.testing.expectEqual(@as(usize, 1 << 16), region.memory.len);
+        try std.testing.expect(std.mem.isAligned(@intFromPtr(region.memory.ptr), std.heap.page_size_min));
+        region.memory[region.memory.len - 1] = 1;
+    }
+}
@@ -0,0 +1,608 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const Io = std.Io;
+const parzig = @import("parzig");
+const futex = @import("futex.zig");
+
+/// Decodes the pages; the vendored parzig (deps/parzig).
+const ParquetFile = parzig.parquet.File;
+/// One decoded column chunk: a slice of optional values per physical type.
+/// parzig does not export its `dynamic.Values` union by name.
+const ColumnValues = @typeInfo(@typeInfo(@TypeOf(ParquetFile.RowGroup.readColumnDynamic)).@"fn".return_type.?).error_union.payload;
+const PhysicalType = @typeInfo(@FieldType(@FieldType(ParquetFile.SchemaInfo, "elem"), "type")).optional.child;
+
+/// Most decode threads one scan runs.
+pub const MAX_READ_THREADS = 64;
+
+/// Row groups decoded ahead of the one being delivered, per thread.
+const READ_AHEAD = 2;
+
+/// Buffer of each `std.Io.File.Reader` parzig pulls pages through.
+const READ_BUFFER_SIZE = 64 * 1024;
+
+/// Upper bound on a single futex sleep; waits re-check.
+const WAIT_SLICE_NS: u64 = 100 * std.time.ns_per_ms;
+
+/// Skip row groups whose footer statistics put `column` (INT32/INT64) wholly
+/// outside `min..max`, e.g. a time window of a capture.
+pub const RangeFilter = struct {
+    column: u32,
+    min: i64,
+    max: i64,
+};
+
+pub const ReadOptions = struct {
+    /// Row groups to read, in the order given; null = every one.
+    row_groups: ?[]const u32 = null,
+    /// Leaf columns to decode, by file index, in the order given; null =
+    /// every flat column. Records are laid out for these columns only.
+    columns: ?[]const u32 = null,
+    filter: ?RangeFilter = null,
+    /// Decode threads, each decoding whole row groups; 0 = one per CPU.
+    /// More than one requires a thread-safe allocator.
+    num_threads: u32 = 0,
+};
+
+pub const ScanResult = struct {
+    row_groups: u32 = 0,
+    /// Row groups the filter ruled out from their statistics.
+    row_groups_skipped: u32 = 0,
+    rows: u64 = 0,
+};
+
+/// A leaf column of the file.
+pub const Column = struct {
+    name: []const u8,
+    physical_type: PhysicalType,
+    type_length: u32,
+    nullable: bool,
+    /// Inside a group (a LIST): listed, but cannot be decoded into records.
+    nested: bool,
+    /// INT32/INT64 annotated UINT_32/UINT_64, whose statistics sort unsigned.
+    unsigned: bool,
+};
+
+/// Where one selected column goes in a rebuilt record. The layout is the
+/// sink's: a null bitmap over the nullable columns, fixed slots in column
+/// order, BYTE_ARRAY bytes after the slots (the slot holds their length).
+const Field = struct {
+    column: u32,
+    physical_type: PhysicalType,
+    nullable: bool,
+    null_bit: u32,
+    offset: u32,
+};
+
+const Layout = struct {
+    fields: []Field,
+    record_size: u32,
+};
+
+/// Reads back files the sink wrote: decodes selected columns of selected
+/// row groups on a pool of threads and hands every row, rebuilt in the
+/// sink's record layout, to a callback in file order -- to verify a file
+/// end to end, or to replay a capture into a sink or a backtest.
+pub const Reader = struct {
+    allocator: Allocator,
+    threaded: Io.Threaded,
+    path: [:0]u8,
+    read_buffer: [READ_BUFFER_SIZE]u8,
+    file_reader: Io.File.Reader,
+    /// Holds the footer, parsed once: scans plan from it, and every decode
+    /// thread's `Cursor` shares its metadata.
+    file: ParquetFile,
+    columns: []Column,
+
+    pub fn open(allocator: Allocator, path: []const u8) !*Reader {
+        const self = try allocator.create(Reader);
+        errdefer allocator.destroy(self);
+        self.allocator = allocator;
+        self.threaded = .init(allocator, .{});
+        errdefer self.threaded.deinit();
+        self.path = try allocator.dupeZ(u8, path);
+        errdefer allocator.free(self.path);
+
+        const io = self.threaded.io();
+        const handle = try Io.Dir.cwd().openFile(io, self.path, .{ .mode = .read_only });
+        self.file_reader = handle.reader(io, &self.read_buffer);
+        self.file = ParquetFile.read(allocator, &self.file_reader) catch |err| {
+            handle.close(io);
+            return err;
+        };
+        errdefer self.file.deinit();
+        self.columns = try leafColumns(allocator, self.file.metadata.schema);
+        return self;
+    }
+
+    pub fn close(self: *Reader) void {
+        const allocator = self.allocator;
+        allocator.free(self.columns);
+        self.file.deinit();
+        allocator.free(self.path);
+        self.threaded.deinit();
+        allocator.destroy(self);
+    }
+
+    pub fn numRowGroups(self: *const Reader) u32 {
+        return @intCast(self.file.metadata.row_groups.len);
+    }
+
+    pub fn numRows(self: *const Reader) u64 {
+        return @intCast(self.file.metadata.num_rows);
+    }
+
+    pub fn rowGroupRows(self: *const Reader, row_group: u32) u64 {
+        return @intCast(self.file.metadata.row_groups[row_group].num_rows);
+    }
+
+    /// Min and max of an INT32/INT64 column in a row group, from the footer
+    /// statistics; null when the chunk has none. Unsigned INT64 bounds past
+    /// maxInt(i64) are clamped to it, which keeps range checks conservative.
+    pub fn columnRange(self: *const Reader, row_group: u32, column: u32) ?[2]i64 {
+        const chunk = self.file.metadata.row_groups[row_group].columns[column];
+        const stats = (chunk.meta_data orelse return null).statistics orelse return null;
+        const min = stats.min_value orelse return null;
+        const max = stats.max_value orelse return null;
+        const unsigned = self.columns[column].unsigned;
+        return switch (self.columns[column].physical_type) {
+            .INT32 => if (min.len != 4 or max.len != 4) null else if (unsigned) .{
+                std.mem.readInt(u32, min[0..4], .little),
+                std.mem.readInt(u32, max[0..4], .little),
+            } else .{
+                std.mem.readInt(i32, min[0..4], .little),
+                std.mem.readInt(i32, max[0..4], .little),
+            },
+            .INT64 => if (min.len != 8 or max.len != 8) null else if (unsigned) .{
+                @intCast(@min(std.mem.readInt(u64, min[0..8], .little), std.math.maxInt(i64))),
+                @intCast(@min(std.mem.readInt(u64, max[0..8], .little), std.math.maxInt(i64))),
+            } else .{
+                std.mem.readInt(i64, min[0..8], .little),
+                std.mem.readInt(i64, max[0..8], .little),
+            },
+            else => null,
+        };
+    }
+
+    /// Decode the selected row groups and call `onRow(context, record)` with
+    /// every row, in order; it returns false to stop the scan early. Row
+    /// groups are decoded in parallel, a bounded number ahead of the one
+    /// being delivered. A null `onRow` only decodes and checks every column
+    /// against its row group's row count, which verifies the file.
+    pub fn scan(
+        self: *Reader,
+        options: ReadOptions,
+        context: anytype,
+        comptime onRow: ?fn (@TypeOf(context), []const u8) bool,
+    ) !ScanResult {
+        const allocator = self.allocator;
+        var result = ScanResult{};
+        const layout = try self.recordLayout(options.columns);
+        defer allocator.free(layout.fields);
+        const row_groups = try self.plan(options, &result);
+        defer allocator.free(row_groups);
+        if (row_groups.len == 0) return result;
+
+        const pending = try allocator.alloc(Pending, row_groups.len);
+        defer allocator.free(pending);
+        @memset(pending, .{});
+
+        const cpus: u32 = @intCast(std.Thread.getCpuCount() catch 1);
+        const requested = if (options.num_threads != 0) options.num_threads else cpus;
+        const num_threads: u32 = @intCast(@min(requested, MAX_READ_THREADS, row_groups.len));
+        var state = Scan{
+            .reader = self,
+            .layout = layout,
+            .row_groups = row_groups,
+            .pending = pending,
+            .build = onRow != null,
+            .window = num_threads * READ_AHEAD,
+        };
+
+        var threads: [MAX_READ_THREADS]std.Thread = undefined;
+        var num_spawned: u32 = 0;
+        defer {
+            state.finish();
+            for (threads[0..num_spawned]) |t| t.join();
+            for (pending) |*p| p.free(allocator);
+        }
+        while (num_spawned < num_threads) : (num_spawned += 1) {
+            threads[num_spawned] = try std.Thread.spawn(.{}, Scan.worker, .{&state});
+        }
+
+        for (pending, 0..) |*p, i| {
+            while (p.ready.load(.acquire) == 0) futex.wait(&p.ready, 0, WAIT_SLICE_NS);
+            if (p.err) |err| return err;
+            result.row_groups += 1;
+            result.rows += p.rows;
+            if (onRow) |f| {
+                var start: u32 = 0;
+                for (p.ends) |end| {
+                    if (!f(context, p.bytes[start..end])) return result;
+                    start = end;
+                }
+            }
+            p.free(allocator);
+            state.deliver(@intCast(i + 1));
+        }
+        return result;
+    }
+
+    /// Decode every flat column of every row group and check the row
+    /// counts, on `num_threads` threads (0 = one per CPU).
+    pub fn verify(self: *Reader, num_threads: u32) !ScanResult {
+        const result = try self.scan(.{ .num_threads = num_threads }, {}, null);
+        if (result.rows != self.numRows()) return error.RowCountMismatch;
+        return result;
+    }
+
+    /// Layout of the records `scan` rebuilds for `columns` (see
+    /// `ReadOptions.columns`).
+    fn recordLayout(self: *const Reader, columns: ?[]const u32) !Layout {
+        const allocator = self.allocator;
+        var selected: std.ArrayList(u32) = .empty;
+        defer selected.deinit(allocator);
+        if (columns) |list| {
+            for (list) |c| {
+                if (c >= self.columns.len or self.columns[c].nested) return error.UnsupportedColumn;
+            }
+            try selected.appendSlice(allocator, list);
+        } else {
+            for (self.columns, 0..) |col, c| {
+                if (!col.nested) try selected.append(allocator, @intCast(c));
+            }
+        }
+
+        const fields = try allocator.alloc(Field, selected.items.len);
+        var num_nullable: u32 = 0;
+        for (selected.items) |c| num_nullable += @intFromBool(self.columns[c].nullable);
+        var offset: u32 = (num_nullable + 7) / 8;
+        var null_bit: u32 = 0;
+        for (selected.items, fields) |c, *f| {
+            const col = self.columns[c];
+            f.* = .{ .column = c, .physical_type = col.physical_type, .nullable = col.nullable, .null_bit = null_bit, .offset = offset };
+            null_bit += @intFromBool(col.nullable);
+            offset += slotSize(col);
+        }
+        return .{ .fields = fields, .record_size = offset };
+    }
+
+    /// The row groups a scan reads, after the filter.
+    fn plan(self: *const Reader, options: ReadOptions, result: *ScanResult) ![]u32 {
+        const allocator = self.allocator;
+        var out: std.ArrayList(u32) = .empty;
+        errdefer out.deinit(allocator);
+        if (options.row_groups) |list| {
+            for (list) |rg| {
+                if (rg >= self.numRowGroups()) return error.InvalidRowGroup;
+            }
+            try out.appendSlice(allocator, list);
+        } else {
+            for (0..self.numRowGroups()) |rg| try out.append(allocator, @intCast(rg));
+        }
+
+        const filter = options.filter orelse return out.toOwnedSlice(allocator);
+        if (filter.column >= self.columns.len) return error.InvalidFilter;
+        switch (self.columns[filter.column].physical_type) {
+            .INT32, .INT64 => {},
+            else => return error.InvalidFilter,
+        }
+        var kept: usize = 0;
+        for (out.items) |rg| {
+            if (self.columnRange(rg, filter.column)) |range| {
+                if (range[1] < filter.min or range[0] > filter.max) {
+                    result.row_groups_skipped += 1;
+                    continue;
+                }
+            }
+            out.items[kept] = rg;
+            kept += 1;
+        }
+        out.shrinkRetainingCapacity(kept);
+        return out.toOwnedSlice(allocator);
+    }
+
+    /// Decode row group `row_group` through `cursor` into `out`: just the
+    /// row count unless `build`, else every row as a record.
+    fn decode(self: *Reader, cursor: *Cursor, row_group: u32, layout: Layout, build: bool, out: *Pending) !void {
+        const allocator = self.allocator;
+        // The decoded pages live in the cursor's arena until the records
+        // are built; its memory is kept for the next row group
+        defer _ = cursor.file.arena.reset(.retain_capacity);
+
+        var rg = cursor.file.rowGroup(row_group);
+        const num_rows: usize = @intCast(rg.rg.num_rows);
+        const values = try allocator.alloc(ColumnValues, layout.fields.len);
+        defer allocator.free(values);
+        for (layout.fields, values) |f, *v| {
+            v.* = try rg.readColumnDynamic(f.column);
+            const len = switch (v.*) {
+                inline else => |data| data.len,
+            };
+            if (len != num_rows) return error.RowCountMismatch;
+        }
+        out.rows = num_rows;
+        if (!build) return;
+
+        // Record ends: the slots, then each row's BYTE_ARRAY bytes
+        const ends = try allocator.alloc(u32, num_rows);
+        errdefer allocator.free(ends);
+        @memset(ends, layout.record_size);
+        for (values) |v| {
+            if (v != .byte_array) continue;
+            for (v.byte_array, ends) |value, *end| {
+                if (value) |bytes| end.* += @intCast(bytes.len);
+            }
+        }
+        var total: u32 = 0;
+        for (ends) |*end| {
+            total += end.*;
+            end.* = total;
+        }
+        const bytes = try allocator.alloc(u8, total);
+        errdefer allocator.free(bytes);
+        @memset(bytes, 0);
+
+        // Where the next BYTE_ARRAY value of each record goes
+        const tails = try allocator.alloc(u32, num_rows);
+        defer allocator.free(tails);
+        var start: u32 = 0;
+        for (ends, tails) |end, *tail| {
+            tail.* = start + layout.record_size;
+            start = end;
+        }
+
+        for (layout.fields, values) |f, v| {
+            switch (v) {
+                inline else => |data| fillColumn(data, f, bytes, ends, tails),
+            }
+        }
+        out.ends = ends;
+        out.bytes = bytes;
+    }
+};
+
+/// A decode thread's handle on the file: its own descriptor and buffered
+/// reader, which parzig seeks to each column chunk, and its own page arena,
+/// over the metadata `Reader.open` parsed. Refers to itself; init in place.
+const Cursor = struct {
+    buffer: [READ_BUFFER_SIZE]u8,
+    file_reader: Io.File.Reader,
+    file: ParquetFile,
+
+    fn init(self: *Cursor, reader: *Reader) !void {
+        const io = reader.threaded.io();
+        const handle = try Io.Dir.cwd().openFile(io, reader.path, .{ .mode = .read_only });
+        self.file_reader = handle.reader(io, &self.buffer);
+        self.file = .{
+            .io = io,
+            .arena = std.heap.ArenaAllocator.init(reader.allocator),
+            .file_reader = &self.file_reader,
+            .metadata = reader.file.metadata,
+        };
+    }
+
+    /// Closes the descriptor and frees the pages; the metadata stays with
+    /// the `Reader`.
+    fn deinit(self: *Cursor) void {
+        self.file.deinit();
+    }
+};
+
+/// One row group of a scan, decoded by a worker and delivered (then freed)
+/// by the scanning thread.
+const Pending = struct {
+    ready: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+    err: ?anyerror = null,
+    rows: u64 = 0,
+    /// Records back to back; record i ends at `ends[i]`.
+    bytes: []u8 = &.{},
+    ends: []u32 = &.{},
+
+    fn free(self: *Pending, allocator: Allocator) void {
+        allocator.free(self.bytes);
+        allocator.free(self.ends);
+        self.bytes = &.{};
+        self.ends = &.{};
+    }
+};
+
+const Scan = struct {
+    reader: *Reader,
+    layout: Layout,
+    row_groups: []const u32,
+    pending: []Pending,
+    build: bool,
+    /// How far past the last delivered row group workers may decode.
+    window: u32,
+    next: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+    /// Row groups delivered so far; the futex word waiting workers sleep on.
+    delivered: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+    stopped: std.atomic.Value(bool) = std.atomic.Value(bool).init(false),
+
+    fn worker(self: *Scan) void {
+        var cursor: Cursor = undefined;
+        const opened: anyerror!void = cursor.init(self.reader);
+        defer if (opened) |_| cursor.deinit() else |_| {};
+        while (!self.stopped.load(.acquire)) {
+            const i = self.next.fetchAdd(1, .monotonic);
+            if (i >= self.row_groups.len) return;
+            while (true) {
+                const delivered = self.delivered.load(.acquire);
+                if (i < delivered +| self.window or self.stopped.load(.acquire)) break;
+                futex.wait(&self.delivered, delivered, WAIT_SLICE_NS);
+            }
+            const p = &self.pending[i];
+            if (!self.stopped.load(.acquire)) {
+                if (opened) |_| {
+                    self.reader.decode(&cursor, self.row_groups[i], self.layout, self.build, p) catch |err| {
+                        p.err = err;
+                    };
+                } else |err| p.err = err;
+            }
+            p.ready.store(1, .release);
+            futex.wake(&p.ready, 1);
+        }
+    }
+
+    fn deliver(self: *Scan, count: u32) void {
+        self.delivered.store(count, .release);
+        futex.wake(&self.delivered, std.math.maxInt(i32));
+    }
+
+    /// Release every waiting worker; the rest of the row groups are skipped.
+    fn finish(self: *Scan) void {
+        self.stopped.store(true, .release);
+        self.deliver(std.math.maxInt(u32));
+    }
+};
+
+/// The file's leaf columns in order. Leaves of a group are `nested`.
+fn leafColumns(allocator: Allocator, schema: anytype) ![]Column {
+    var out: std.ArrayList(Column) = .empty;
+    errdefer out.deinit(allocator);
+    var i: usize = 1;
+    while (i < schema.len) {
+        const top = schema[i];
+        i += 1;
+        var remaining: i64 = top.num_children orelse {
+            try out.append(allocator, leaf(top, false));
+            continue;
+        };
+        while (remaining > 0 and i < schema.len) : (i += 1) {
+            remaining -= 1;
+            if (schema[i].num_children) |n| {
+                remaining += n;
+            } else {
+                try out.append(allocator, leaf(schema[i], true));
+            }
+        }
+    }
+    return out.toOwnedSlice(allocator);
+}
+
+fn leaf(elem: anytype, nested: bool) Column {
+    return .{
+        .name = elem.name,
+        .physical_type = elem.type orelse .BYTE_ARRAY,
+        .type_length = if (elem.type_length) |n| @intCast(n) else 0,
+        .nullable = elem.repetition_type != null and elem.repetition_type.? == .OPTIONAL,
+        .nested = nested,
+        // parzig's LogicalType is an untagged union; the sink writes both
+        .unsigned = if (elem.converted_type) |ct| ct == .UINT_32 or ct == .UINT_64 else false,
+    };
+}
+
+/// Bytes of a column's slot in a record.
+fn slotSize(col: Column) u32 {
+    return switch (col.physical_type) {
+        .BOOLEAN => 1,
+        .INT32, .FLOAT, .BYTE_ARRAY => 4,
+        .INT64, .DOUBLE => 8,
+        .INT96 => 12,
+        .FIXED_LEN_BYTE_ARRAY => col.type_length,
+    };
+}
+
+/// Write one decoded column into the slots of every record.
+fn fillColumn(data: anytype, f: Field, bytes: []u8, ends: []const u32, tails: []u32) void {
+    const T = @typeInfo(@typeInfo(@TypeOf(data)).pointer.child).optional.child;
+    var start: u32 = 0;
+    for (data, ends, tails) |value, end, *tail| {
+        defer start = end;
+        const record = bytes[start..end];
+        const v = value orelse {
+            if (f.nullable) record[f.null_bit / 8] |= @as(u8, 1) << @intCast(f.null_bit % 8);
+            continue;
+        };
+        const slot = record[f.offset..];
+        switch (T) {
+            bool => slot[0] = @intFromBool(v),
+            i32, i64, i96 => std.mem.writeInt(T, slot[0 .. @bitSizeOf(T) / 8], v, .little),
+            f32 => std.mem.writeInt(u32, slot[0..4], @bitCast(v), .little),
+            f64 => std.mem.writeInt(u64, slot[0..8], @bitCast(v), .little),
+            []u8 => {
+                std.mem.writeInt(u32, slot[0..4], @intCast(v.len), .little);
+                @memcpy(bytes[tail.*..][0..v.len], v);
+                tail.* += @intCast(v.len);
+            },
+            else => @memcpy(slot[0..v.len], &v),
+        }
+    }
+}
+
+// ---- Tests ----
+
+test "scan rebuilds sink records and skips row groups by statistics" {
+    const allocator = std.testing.allocator;
+    const writer = @import("parquet/writer.zig");
+    const ColumnDef = writer.schema.ColumnDef;
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try @import("testing.zig").tmpPath(allocator, &tmp, "reader.parquet");
+    defer allocator.free(path);
+
+    const columns = [_]ColumnDef{
+        .{ .name = "ts", .physical_type = .INT64, .repetition_type = .REQUIRED },
+        .{ .name = "px", .physical_type = .DOUBLE, .repetition_type = .OPTIONAL },
+        .{ .name = "sym", .physical_type = .BYTE_ARRAY, .repetition_type = .REQUIRED },
+    };
+    {
+        var fw = try writer.FileWriter.initFile(allocator, &columns, .UNCOMPRESSED, path);
+        defer fw.deinit();
+        // Two row groups of three rows: ts 0..2 and 10..12, px null on odd ts
+        for ([_]i64{ 0, 10 }) |base| {
+            const rg = try fw.rowGroup();
+            for (0..3) |i| {
+                const ts = base + @as(i64, @intCast(i));
+                try rg.column(0).writeI64(ts);
+                if (i % 2 == 1) {
+                    try rg.column(1).writeNull();
+                } else {
+                    try rg.column(1).writeF64(@floatFromInt(ts));
+                }
+                try rg.column(2).writeByteArray(if (i == 0) "AB" else "XYZ");
+            }
+            rg.setNumRows(3);
+            try fw.closeRowGroup(rg);
+        }
+        _ = try fw.close();
+    }
+
+    const reader = try Reader.open(allocator, path);
+    defer reader.close();
+    try std.testing.expectEqual(@as(u32, 2), reader.numRowGroups());
+    try std.testing.expectEqual(@as(u64, 6), reader.numRows());
+    try std.testing.expectEqual([2]i64{ 10, 12 }, reader.columnRange(1, 0).?);
+
+    const Collect = struct {
+        records: std.ArrayList(u8) = .empty,
+        count: u32 = 0,
+
+        fn onRow(self: *@This(), record: []const u8) bool {
+            self.records.appendSlice(std.testing.allocator, record) catch return false;
+            self.count += 1;
+            return true;
+        }
+    };
+    var rows = Collect{};
+    defer rows.records.deinit(allocator);
+    const result = try reader.scan(.{ .filter = .{ .column = 0, .min = 5, .max = 20 }, .num_threads = 2 }, &rows, Collect.onRow);
+    try std.testing.expectEqual(@as(u32, 1), result.row_groups);
+    try std.testing.expectEqual(@as(u32, 1), result.row_groups_skipped);
+    try std.testing.expectEqual(@as(u32, 3), rows.count);
+
+    // bitmap(1) ts(8) px(8) sym len(4) + "AB"; then ts 11 with a null px
+    const r = rows.records.items;
+    try std.testing.expectEqual(@as(usize, 23), r.len - 2 * 24);
+    try std.testing.expectEqual(@as(u8, 0), r[0]);
+    try std.testing.expectEqual(@as(i64, 10), std.mem.readInt(i64, r[1..9], .little));
+    try std.testing.expectEqual(@as(f64, 10), @as(f64, @bitCast(std.mem.readInt(u64, r[9..17], .little))));
+    try std.testing.expectEqualStrings("AB", r[21..23]);
+    try std.testing.expectEqual(@as(u8, 1), r[23]);
+    try std.testing.expectEqual(@as(i64, 11), std.mem.readInt(i64, r[24..32], .little));
+    try std.testing.expectEqualStrings("XYZ", r[44..47]);
+
+    const verified = try reader.verify(0);
+    try std.testing.expectEqual(@as(u64, 6), verified.rows);
+    try std.testing.expectError(error.UnsupportedColumn, reader.scan(.{ .columns = &.{7} }, {}, null));
+}
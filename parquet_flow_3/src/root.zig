@@ -1,3 +1,5 @@
+const std = @import("std");
+
 // Parquet modules
 pub const parquet = @import("parquet/writer.zig");
 pub const types = @import("parquet/types.zig");
@@ -11,6 +13,20 @@ pub const page = @import("parquet/page.zig");
 pub const log_sink = @import("sink/log_sink.zig");
 pub const ring_buffer = @import("sink/ring_buffer.zig");
 pub const batch = @import("sink/batch.zig");
+pub const wait = @import("sink/wait.zig");
+pub const typed_sink = @import("sink/typed_sink.zig");
+pub const stats = @import("sink/stats.zig");
+pub const Sink = typed_sink.Sink;
+
+// Reading files back: verification and replay
+pub const reader = @import("reader.zig");
+
+// Measurement
+pub const histogram = @import("histogram.zig");
+pub const cycles = @import("cycles.zig");
+
+// CPU affinity, NUMA policy and huge-page memory
+pub const placement = @import("placement.zig");
 
 // C API
 pub const c_api = @import("c_api.zig");
@@ -19,3 +35,18 @@ pub const c_api = @import("c_api.zig");
 comptime {
     _ = c_api;
 }
+
+// `zig build test` roots the in-file tests here: every module above, plus
+// the ones only imported internally.
+test {
+    std.testing.refAllDecls(@This());
+    _ = @import("futex.zig");
+    _ = @import("parquet/statistics.zig");
+    _ = @import("parquet/bloom_filter.zig");
+    _ = @import("parquet/dictionary.zig");
+    _ = @import("parquet/output.zig");
+    _ = @import("parquet/encoder_pool.zig");
+    _ = @import("sink/column_batch.zig");
+    _ = @import("sink/ring_file.zig");
+    _ = @import("sink/spill.zig");
+}
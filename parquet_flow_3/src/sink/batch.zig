@@ -1,4 +1,5 @@
 const std = @import("std");
+const placement = @import("../placement.zig");
 const Allocator = std.mem.Allocator;
 
 /// Physical types (mirrors parquet/types.zig -- kept local to avoid cross-directory import
@@ -14,6 +15,20 @@ pub const PhysicalType = enum(i32) {
     FIXED_LEN_BYTE_ARRAY = 7,
 };
 
+/// How a column's values are encoded in the Parquet file (mirrors
+/// pqflow_encoding).
+pub const ColumnEncoding = enum(i32) {
+    /// Dictionary for BYTE_ARRAY/FIXED_LEN_BYTE_ARRAY, PLAIN otherwise.
+    default = 0,
+    plain = 1,
+    /// RLE_DICTIONARY with PLAIN fallback.
+    dictionary = 2,
+    /// INT32/INT64 only.
+    delta_binary_packed = 3,
+    /// FLOAT/DOUBLE only.
+    byte_stream_split = 4,
+};
+
 /// Describes a single column within a record.
 pub const ColumnDef = struct {
     name: []const u8,
@@ -24,8 +39,44 @@ pub const ColumnDef = struct {
     offset: u32,
     /// Byte size of this column's value within a record
     size: u32,
+    encoding: ColumnEncoding = .default,
+    bloom_filter: bool = false,
+    /// A LIST of fixed-width `physical_type` elements (not BYTE_ARRAY), e.g.
+    /// the price levels of a book snapshot. Like a BYTE_ARRAY column, its
+    /// 4-byte slot holds a LE element count and the packed elements follow
+    /// the fixed portion of the record, in column order.
+    repeated: bool = false,
+    /// INT32/INT64 holding unsigned values: annotated `INTEGER(bits, false)`
+    /// in the file, so readers and the statistics order them unsigned.
+    unsigned: bool = false,
+
+    /// Whether the column's data lives in the record's variable-length tail.
+    pub fn inTail(self: ColumnDef) bool {
+        return self.repeated or self.physical_type == .BYTE_ARRAY;
+    }
+
+    /// Byte width of one element of a repeated column.
+    pub fn elementSize(self: ColumnDef) u32 {
+        return switch (self.physical_type) {
+            .BOOLEAN => 1,
+            .INT32, .FLOAT => 4,
+            .INT64, .DOUBLE => 8,
+            .INT96 => 12,
+            .FIXED_LEN_BYTE_ARRAY => self.type_length,
+            .BYTE_ARRAY => unreachable,
+        };
+    }
+
+    /// Tail bytes of a value whose slot holds `slot_value`.
+    fn tailBytes(self: ColumnDef, slot_value: u32) usize {
+        return if (self.repeated) @as(usize, slot_value) * self.elementSize() else slot_value;
+    }
 };
 
+/// Columnarizes `count` records spaced `stride` bytes apart straight into
+/// the accumulator's column buffers, whose capacity is already reserved.
+pub const TransposeFn = *const fn (acc: *BatchAccumulator, records: []const u8, stride: usize, count: u32) void;
+
 /// Schema information for splitting flat records into columns.
 pub const SchemaInfo = struct {
     columns: []const ColumnDef,
@@ -35,6 +86,10 @@ pub const SchemaInfo = struct {
     nullable_count: u32,
     /// Byte size of the null bitmap at the start of each record
     null_bitmap_bytes: u32,
+    /// Schema-specific kernel generated at comptime (see typed_sink.zig);
+    /// replaces the interpreted per-column loop in `addRecords()`. Only set
+    /// for fixed-width schemas without nullable columns.
+    transpose: ?TransposeFn = null,
 };
 
 /// Accumulates raw records and splits them into per-column buffers
@@ -45,7 +100,12 @@ pub const BatchAccumulator = struct {
     schema: SchemaInfo,
     row_count: u32,
     max_rows: u32,
+    /// No BYTE_ARRAY or repeated columns: every record is `record_size` bytes of
+    /// fixed slots, so `addRecords()` can transpose whole runs at once.
+    fixed_width: bool,
     allocator: Allocator,
+    /// Output of a partitioned sink the rows belong to; set by its owner.
+    partition: u32 = 0,
 
     pub fn init(allocator: Allocator, schema: SchemaInfo, max_rows: u32) !BatchAccumulator {
         const num_cols = schema.columns.len;
@@ -60,14 +120,37 @@ pub const BatchAccumulator = struct {
             buf.* = .empty;
         }
 
-        return BatchAccumulator{
+        var self = BatchAccumulator{
             .column_buffers = column_buffers,
             .null_bitmaps = null_bitmaps,
             .schema = schema,
             .row_count = 0,
             .max_rows = max_rows,
+            .fixed_width = true,
             .allocator = allocator,
         };
+        errdefer self.deinit();
+
+        // Size fixed-width columns for a full batch up front so steady-state
+        // appends never reallocate.
+        for (schema.columns, 0..) |col, i| {
+            if (col.nullable) {
+                try null_bitmaps[i].ensureTotalCapacity(allocator, (max_rows + 7) / 8);
+            }
+            if (col.inTail()) {
+                self.fixed_width = false;
+                continue;
+            }
+            try column_buffers[i].ensureTotalCapacity(allocator, @as(usize, max_rows) * col.size);
+        }
+        return self;
+    }
+
+    /// Touch every page of the reserved column and bitmap capacity, so the
+    /// first batch does not take page faults while columnarizing.
+    pub fn prefault(self: *BatchAccumulator) void {
+        for (self.column_buffers) |*buf| placement.prefault(buf.allocatedSlice());
+        for (self.null_bitmaps) |*buf| placement.prefault(buf.allocatedSlice());
     }
 
     pub fn deinit(self: *BatchAccumulator) void {
@@ -82,11 +165,27 @@ pub const BatchAccumulator = struct {
         self.allocator.free(self.null_bitmaps);
     }
 
-    /// Add a raw fixed-size record. Splits it into per-column values
-    /// based on the schema's column offsets and sizes.
+    /// Add a raw record. Splits it into per-column values based on the
+    /// schema's column offsets and sizes.
+    ///
+    /// BYTE_ARRAY columns hold a 4-byte LE length in their fixed slot; the
+    /// bytes themselves follow the fixed portion of the record, in column
+    /// order. Their column buffers store PLAIN-encoded (length-prefixed)
+    /// values of non-null rows only. Repeated columns are stored the same
+    /// way, prefixed with their element count.
     pub fn addRecord(self: *BatchAccumulator, record: []const u8) !void {
         if (record.len < self.schema.record_size) return error.RecordTooShort;
 
+        // Validate the variable-length tail before touching any buffers
+        var tail: usize = self.schema.record_size;
+        for (self.schema.columns) |col| {
+            if (col.inTail()) {
+                tail += col.tailBytes(std.mem.readInt(u32, record[col.offset..][0..4], .little));
+            }
+        }
+        if (tail > record.len) return error.RecordTooShort;
+        tail = self.schema.record_size;
+
         // Parse null bitmap from start of record (if any nullable columns)
         const null_bitmap = record[0..self.schema.null_bitmap_bytes];
 
@@ -96,31 +195,21 @@ pub const BatchAccumulator = struct {
             const end = start + col.size;
             const value = record[start..end];
 
+            var is_null = false;
             if (col.nullable) {
                 // Check null bit
                 const byte_idx = nullable_idx / 8;
                 const bit_idx: u3 = @intCast(nullable_idx % 8);
-                const is_null = if (byte_idx < null_bitmap.len)
+                is_null = if (byte_idx < null_bitmap.len)
                     (null_bitmap[byte_idx] >> bit_idx) & 1 == 1
                 else
                     false;
 
-                if (is_null) {
-                    // Append zeros for null value (placeholder)
-                    for (0..col.size) |_| {
-                        try self.column_buffers[i].append(self.allocator, 0);
-                    }
-                } else {
-                    try self.column_buffers[i].appendSlice(self.allocator, value);
-                }
-
-                // Track null in per-column bitmap
+                // Track null in per-column bitmap; it holds ceil(row_count / 8) bytes
                 const row = self.row_count;
                 const bm_byte = row / 8;
                 const bm_bit: u3 = @intCast(row % 8);
-
-                // Extend bitmap if needed
-                while (self.null_bitmaps[i].items.len <= bm_byte) {
+                if (bm_bit == 0) {
                     try self.null_bitmaps[i].append(self.allocator, 0);
                 }
                 if (is_null) {
@@ -128,6 +217,18 @@ pub const BatchAccumulator = struct {
                 }
 
                 nullable_idx += 1;
+            }
+
+            if (col.inTail()) {
+                const len = col.tailBytes(std.mem.readInt(u32, value[0..4], .little));
+                if (!is_null) {
+                    try self.column_buffers[i].appendSlice(self.allocator, value[0..4]);
+                    try self.column_buffers[i].appendSlice(self.allocator, record[tail..][0..len]);
+                }
+                tail += len;
+            } else if (is_null) {
+                // Append zeros for null value (placeholder)
+                try self.column_buffers[i].appendNTimes(self.allocator, 0, col.size);
             } else {
                 try self.column_buffers[i].appendSlice(self.allocator, value);
             }
@@ -136,6 +237,159 @@ pub const BatchAccumulator = struct {
         self.row_count += 1;
     }
 
+    /// Add `count` records of `record_len` bytes each, the first at
+    /// `records[0]` and each `stride` bytes after the previous -- e.g. a run
+    /// of same-size frames in a producer ring.
+    ///
+    /// Fixed-width schemas are transposed column by column in one pass per
+    /// column: 4- and 8-byte fields go through a comptime-specialized
+    /// strided gather, and null bits are collected 64 rows per word. A
+    /// comptime `SchemaInfo.transpose` kernel replaces that loop when set.
+    /// Other schemas fall back to `addRecord()` per record and stop at the
+    /// first invalid one.
+    pub fn addRecords(self: *BatchAccumulator, records: []const u8, record_len: usize, stride: usize, count: u32) !void {
+        if (count == 0) return;
+        std.debug.assert(records.len >= (count - 1) * stride + record_len);
+
+        if (!self.fixed_width) {
+            for (0..count) |r| {
+                try self.addRecord(records[r * stride ..][0..record_len]);
+            }
+            return;
+        }
+        if (record_len < self.schema.record_size) return error.RecordTooShort;
+
+        // Reserve everything first so a failure leaves the batch untouched
+        const bitmap_bytes = (@as(usize, self.row_count) + count + 7) / 8;
+        for (self.schema.columns, 0..) |col, i| {
+            try self.column_buffers[i].ensureUnusedCapacity(self.allocator, @as(usize, count) * col.size);
+            if (col.nullable) {
+                try self.null_bitmaps[i].ensureTotalCapacity(self.allocator, bitmap_bytes);
+            }
+        }
+
+        if (self.schema.transpose) |kernel| {
+            kernel(self, records, stride, count);
+            self.row_count += count;
+            return;
+        }
+
+        var nullable_idx: u32 = 0;
+        for (self.schema.columns, 0..) |col, i| {
+            const dst = self.column_buffers[i].addManyAsSliceAssumeCapacity(@as(usize, count) * col.size);
+            switch (col.size) {
+                inline 4, 8 => |size| gatherField(size, dst, records, stride, col.offset, count),
+                else => gatherBytes(dst, records, stride, col.offset, col.size, count),
+            }
+
+            if (col.nullable) {
+                self.addNullBits(i, col.size, dst, records, stride, nullable_idx, count);
+                nullable_idx += 1;
+            }
+        }
+
+        self.row_count += count;
+    }
+
+    /// Extend column `col_index`'s null bitmap by `count` rows, taking bit
+    /// `nullable_idx` of each record's null bitmap, and zero the values of
+    /// null rows in `dst` as `addRecord()` does.
+    fn addNullBits(
+        self: *BatchAccumulator,
+        col_index: usize,
+        size: u32,
+        dst: []u8,
+        records: []const u8,
+        stride: usize,
+        nullable_idx: u32,
+        count: u32,
+    ) void {
+        const bitmap = &self.null_bitmaps[col_index];
+        const total_bytes = (@as(usize, self.row_count) + count + 7) / 8;
+        bitmap.appendNTimesAssumeCapacity(0, total_bytes - bitmap.items.len);
+
+        // Null bits past the record's bitmap read as not null
+        const byte_idx = nullable_idx / 8;
+        if (byte_idx >= self.schema.null_bitmap_bytes) return;
+        const bit_idx: u3 = @intCast(nullable_idx % 8);
+
+        var r: usize = 0;
+        while (r < count) {
+            const n: usize = @min(64, count - r);
+            var word: u64 = 0;
+            for (0..n) |j| {
+                const bit = (records[(r + j) * stride + byte_idx] >> bit_idx) & 1;
+                word |= @as(u64, bit) << @intCast(j);
+            }
+            orBits(bitmap.items, self.row_count + r, word);
+
+            var nulls = word;
+            while (nulls != 0) : (nulls &= nulls - 1) {
+                const row = r + @ctz(nulls);
+                @memset(dst[row * size ..][0..size], 0);
+            }
+            r += n;
+        }
+    }
+
+    /// Returns true if row `row` of nullable column `col_index` is null.
+    pub fn isNull(self: *const BatchAccumulator, col_index: usize, row: u32) bool {
+        const bitmap = self.null_bitmaps[col_index].items;
+        const bit_idx: u3 = @intCast(row % 8);
+        return (bitmap[row / 8] >> bit_idx) & 1 == 1;
+    }
+
+    /// Feed column `col_index` into a Parquet column writer: anything with
+    /// `writePlainValues(bytes, count)` and `writeNull()`, plus
+    /// `writeList(bytes, count)` for repeated columns. The zero
+    /// placeholders of null fixed-width values are skipped.
+    pub fn writeColumnTo(self: *const BatchAccumulator, col_index: usize, writer: anytype) !void {
+        const col = self.schema.columns[col_index];
+        const data = self.column_buffers[col_index].items;
+
+        if (col.repeated) {
+            var pos: usize = 0;
+            for (0..self.row_count) |row| {
+                if (col.nullable and self.isNull(col_index, @intCast(row))) {
+                    try writer.writeNull();
+                    continue;
+                }
+                const count = std.mem.readInt(u32, data[pos..][0..4], .little);
+                const len = col.tailBytes(count);
+                try writer.writeList(data[pos + 4 ..][0..len], count);
+                pos += 4 + len;
+            }
+            return;
+        }
+
+        if (!col.nullable) {
+            return writer.writePlainValues(data, self.row_count);
+        }
+
+        var pos: usize = 0;
+        for (0..self.row_count) |row| {
+            const is_null = self.isNull(col_index, @intCast(row));
+            if (col.physical_type == .BYTE_ARRAY) {
+                if (is_null) {
+                    try writer.writeNull();
+                    continue;
+                }
+                const len = std.mem.readInt(u32, data[pos..][0..4], .little);
+                const end = pos + 4 + len;
+                try writer.writePlainValues(data[pos..end], 1);
+                pos = end;
+            } else {
+                const end = pos + col.size;
+                if (is_null) {
+                    try writer.writeNull();
+                } else {
+                    try writer.writePlainValues(data[pos..end], 1);
+                }
+                pos = end;
+            }
+        }
+    }
+
     /// Returns true if the batch has reached max_rows.
     pub fn isFull(self: *const BatchAccumulator) bool {
         return self.row_count >= self.max_rows;
@@ -153,6 +407,46 @@ pub const BatchAccumulator = struct {
     }
 };
 
+/// Copy the `size`-byte field at `offset` of `count` records spaced `stride`
+/// bytes apart into `dst`. Each group of rows is packed into one 32-byte
+/// `@Vector` and written with a single store; the lane inserts lower to
+/// shuffles on SIMD targets. Inline, so strides and offsets known at
+/// comptime (typed_sink.zig) fold into the loads.
+pub inline fn gatherField(comptime size: usize, dst: []u8, records: []const u8, stride: usize, offset: usize, count: usize) void {
+    const Word = std.meta.Int(.unsigned, size * 8);
+    const lanes = 32 / size;
+    const V = @Vector(lanes, Word);
+
+    var r: usize = 0;
+    while (r + lanes <= count) : (r += lanes) {
+        var v: V = undefined;
+        inline for (0..lanes) |l| {
+            v[l] = std.mem.bytesToValue(Word, records[(r + l) * stride + offset ..][0..size]);
+        }
+        dst[r * size ..][0 .. lanes * size].* = @bitCast(v);
+    }
+    while (r < count) : (r += 1) {
+        dst[r * size ..][0..size].* = records[r * stride + offset ..][0..size].*;
+    }
+}
+
+/// `gatherField()` for field sizes without a specialization.
+pub inline fn gatherBytes(dst: []u8, records: []const u8, stride: usize, offset: usize, size: usize, count: usize) void {
+    for (0..count) |r| {
+        @memcpy(dst[r * size ..][0..size], records[r * stride + offset ..][0..size]);
+    }
+}
+
+/// OR the low bits of `word` into `bitmap` starting at bit `bit_pos`.
+fn orBits(bitmap: []u8, bit_pos: usize, word: u64) void {
+    if (word == 0) return;
+    const shifted = @as(u128, word) << @intCast(bit_pos % 8);
+    const used_bytes = (128 - @clz(shifted) + 7) / 8;
+    for (0..used_bytes) |k| {
+        bitmap[bit_pos / 8 + k] |= @truncate(shifted >> @intCast(k * 8));
+    }
+}
+
 test "BatchAccumulator basic" {
     const allocator = std.testing.allocator;
 
@@ -193,3 +487,162 @@ test "BatchAccumulator basic" {
     try std.testing.expectEqual(@as(u32, 0), batch.row_count);
     try std.testing.expect(!batch.isFull());
 }
+
+test "BatchAccumulator nullable and byte array columns" {
+    const allocator = std.testing.allocator;
+
+    // Layout: [null bitmap:1][id:i32 @1][name len:u32 @5] then name bytes
+    const columns = [_]ColumnDef{
+        .{ .name = "id", .physical_type = .INT32, .type_length = 0, .nullable = true, .offset = 1, .size = 4 },
+        .{ .name = "name", .physical_type = .BYTE_ARRAY, .type_length = 0, .nullable = false, .offset = 5, .size = 4 },
+    };
+    const schema = SchemaInfo{
+        .columns = &columns,
+        .record_size = 9,
+        .nullable_count = 1,
+        .null_bitmap_bytes = 1,
+    };
+
+    var batch = try BatchAccumulator.init(allocator, schema, 4);
+    defer batch.deinit();
+
+    const rec1 = [_]u8{ 0, 7, 0, 0, 0, 2, 0, 0, 0, 'h', 'i' };
+    const rec2 = [_]u8{ 1, 0, 0, 0, 0, 3, 0, 0, 0, 'a', 'b', 'c' };
+    try batch.addRecord(&rec1);
+    try batch.addRecord(&rec2);
+
+    // Truncated tail is rejected
+    const bad = [_]u8{ 0, 0, 0, 0, 0, 5, 0, 0, 0, 'x' };
+    try std.testing.expectError(error.RecordTooShort, batch.addRecord(&bad));
+
+    const Collector = struct {
+        values: u32 = 0,
+        nulls: u32 = 0,
+        bytes: usize = 0,
+
+        pub fn writePlainValues(self: *@This(), plain: []const u8, count: usize) !void {
+            self.values += @intCast(count);
+            self.bytes += plain.len;
+        }
+
+        pub fn writeNull(self: *@This()) !void {
+            self.nulls += 1;
+        }
+    };
+
+    var ids = Collector{};
+    try batch.writeColumnTo(0, &ids);
+    try std.testing.expectEqual(@as(u32, 1), ids.values);
+    try std.testing.expectEqual(@as(u32, 1), ids.nulls);
+    try std.testing.expectEqual(@as(usize, 4), ids.bytes);
+
+    var names = Collector{};
+    try batch.writeColumnTo(1, &names);
+    try std.testing.expectEqual(@as(u32, 2), names.values);
+    try std.testing.expectEqual(@as(usize, 4 + 2 + 4 + 3), names.bytes);
+}
+
+test "BatchAccumulator repeated columns" {
+    const allocator = std.testing.allocator;
+
+    // Layout: [null bitmap:1][ts:i64 @1][bid_px count:u32 @9] then the prices
+    const columns = [_]ColumnDef{
+        .{ .name = "ts", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 1, .size = 8 },
+        .{ .name = "bid_px", .physical_type = .INT32, .type_length = 0, .nullable = true, .offset = 9, .size = 4, .repeated = true },
+    };
+    const schema = SchemaInfo{
+        .columns = &columns,
+        .record_size = 13,
+        .nullable_count = 1,
+        .null_bitmap_bytes = 1,
+    };
+
+    var batch = try BatchAccumulator.init(allocator, schema, 4);
+    defer batch.deinit();
+    try std.testing.expect(!batch.fixed_width);
+
+    const two = [_]u8{ 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 10, 0, 0, 0, 11, 0, 0, 0 };
+    const empty = [_]u8{ 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const null_list = [_]u8{ 1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    try batch.addRecord(&two);
+    try batch.addRecord(&empty);
+    try batch.addRecord(&null_list);
+
+    // Two declared elements, one present
+    const bad = [_]u8{ 0, 4, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 10, 0, 0, 0 };
+    try std.testing.expectError(error.RecordTooShort, batch.addRecord(&bad));
+
+    const Collector = struct {
+        lists: u32 = 0,
+        elements: usize = 0,
+        nulls: u32 = 0,
+
+        pub fn writeList(self: *@This(), plain: []const u8, count: usize) !void {
+            try std.testing.expectEqual(count * 4, plain.len);
+            self.lists += 1;
+            self.elements += count;
+        }
+
+        pub fn writePlainValues(_: *@This(), _: []const u8, _: usize) !void {
+            return error.NotAList;
+        }
+
+        pub fn writeNull(self: *@This()) !void {
+            self.nulls += 1;
+        }
+    };
+
+    var book = Collector{};
+    try batch.writeColumnTo(1, &book);
+    try std.testing.expectEqual(@as(u32, 2), book.lists);
+    try std.testing.expectEqual(@as(usize, 2), book.elements);
+    try std.testing.expectEqual(@as(u32, 1), book.nulls);
+}
+
+test "BatchAccumulator addRecords matches addRecord" {
+    const allocator = std.testing.allocator;
+
+    // Layout: [null bitmap:1][ts:i64 @1][qty:i32 @9][side:u8 @13], padded to a 16-byte stride
+    const columns = [_]ColumnDef{
+        .{ .name = "ts", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 1, .size = 8 },
+        .{ .name = "qty", .physical_type = .INT32, .type_length = 0, .nullable = true, .offset = 9, .size = 4 },
+        .{ .name = "side", .physical_type = .FIXED_LEN_BYTE_ARRAY, .type_length = 1, .nullable = false, .offset = 13, .size = 1 },
+    };
+    const schema = SchemaInfo{
+        .columns = &columns,
+        .record_size = 14,
+        .nullable_count = 1,
+        .null_bitmap_bytes = 1,
+    };
+    const stride = 16;
+    const num_rows = 100;
+
+    var records: [num_rows * stride]u8 = undefined;
+    for (0..num_rows) |r| {
+        const rec = records[r * stride ..][0..stride];
+        @memset(rec, 0);
+        rec[0] = if (r % 3 == 0) 1 else 0;
+        std.mem.writeInt(i64, rec[1..9], @intCast(r * 1000), .little);
+        std.mem.writeInt(i32, rec[9..13], @intCast(r), .little);
+        rec[13] = @intCast(r % 2);
+    }
+
+    var expected = try BatchAccumulator.init(allocator, schema, num_rows);
+    defer expected.deinit();
+    for (0..num_rows) |r| try expected.addRecord(records[r * stride ..][0..14]);
+
+    // Split into runs so the second starts mid-byte of the null bitmap
+    var batch = try BatchAccumulator.init(allocator, schema, num_rows);
+    defer batch.deinit();
+    try std.testing.expect(batch.fixed_width);
+    try batch.addRecords(&records, 14, stride, 5);
+    try batch.addRecords(records[5 * stride ..], 14, stride, num_rows - 5);
+
+    try std.testing.expectEqual(expected.row_count, batch.row_count);
+    for (0..columns.len) |i| {
+        try std.testing.expectEqualSlices(u8, expected.column_buffers[i].items, batch.column_buffers[i].items);
+        try std.testing.expectEqualSlices(u8, expected.null_bitmaps[i].items, batch.null_bitmaps[i].items);
+    }
+
+    try std.testing.expectError(error.RecordTooShort, batch.addRecords(&records, 13, stride, 2));
+}
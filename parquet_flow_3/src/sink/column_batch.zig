@@ -0,0 +1,225 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const batch_mod = @import("batch.zig");
+const ColumnDef = batch_mod.ColumnDef;
+const SchemaInfo = batch_mod.SchemaInfo;
+
+/// Called once the sink is done reading a batch's arrays (mirrors
+/// pqflow_release_fn).
+pub const ReleaseFn = *const fn (user_data: ?*anyopaque) callconv(.c) void;
+
+/// One column of a `ColumnBatch`, in Arrow layout.
+pub const ColumnData = struct {
+    /// `num_rows` values of the column's size back to back (BOOLEAN: one
+    /// byte each), null rows included with any content. BYTE_ARRAY: the
+    /// bytes of every value, concatenated. Repeated: the elements of every
+    /// list, concatenated.
+    values: []const u8,
+    /// BYTE_ARRAY and repeated columns only: `num_rows + 1` offsets into
+    /// `values`, in bytes or elements; row i is `offsets[i]..offsets[i + 1]`.
+    offsets: ?[]const i32 = null,
+    /// Nullable columns only: bit i (LSB first) set when row i is present.
+    /// Null means no row is null.
+    validity: ?[]const u8 = null,
+
+    fn isNull(self: ColumnData, row: usize) bool {
+        const v = self.validity orelse return false;
+        return (v[row / 8] >> @intCast(row % 8)) & 1 == 0;
+    }
+};
+
+/// Rows already laid out column by column, for `LogSink.logColumns()`.
+pub const ColumnBatch = struct {
+    /// One per schema column, in schema order.
+    columns: []const ColumnData,
+    num_rows: u32,
+    /// With a release callback the sink reads the caller's arrays in place
+    /// and calls it from the flush thread once the rows are in a row group
+    /// (or failed to be). Without one, `logColumns()` copies the arrays
+    /// before returning.
+    release: ?ReleaseFn = null,
+    user_data: ?*anyopaque = null,
+
+    pub fn validate(self: ColumnBatch, schema: SchemaInfo) error{InvalidColumns}!void {
+        if (self.columns.len != schema.columns.len) return error.InvalidColumns;
+        const n: usize = self.num_rows;
+        for (schema.columns, self.columns) |col, data| {
+            if (data.validity) |v| {
+                if (!col.nullable or v.len < (n + 7) / 8) return error.InvalidColumns;
+            }
+            if (col.inTail()) {
+                const offsets = data.offsets orelse return error.InvalidColumns;
+                if (offsets.len != n + 1 or offsets[0] < 0) return error.InvalidColumns;
+                for (offsets[0..n], offsets[1..]) |lo, hi| {
+                    if (hi < lo) return error.InvalidColumns;
+                }
+                const unit: usize = if (col.repeated) col.elementSize() else 1;
+                if (@as(usize, @intCast(offsets[n])) * unit > data.values.len) return error.InvalidColumns;
+            } else if (data.offsets != null or data.values.len < n * col.size) {
+                return error.InvalidColumns;
+            }
+        }
+    }
+};
+
+/// A batch queued for the flush thread. `storage` holds what must outlive
+/// the `logColumns()` call: the column descriptors, and the arrays too
+/// unless the caller keeps them alive until `release`.
+pub const PendingColumns = struct {
+    next: ?*PendingColumns = null,
+    batch: ColumnBatch,
+    storage: []align(8) u8,
+
+    pub fn create(allocator: Allocator, batch: ColumnBatch) !*PendingColumns {
+        const copy = batch.release == null;
+        var size = batch.columns.len * @sizeOf(ColumnData);
+        if (copy) {
+            for (batch.columns) |c| {
+                size += padded(c.values.len);
+                if (c.offsets) |o| size += padded(o.len * @sizeOf(i32));
+                if (c.validity) |v| size += padded(v.len);
+            }
+        }
+
+        const self = try allocator.create(PendingColumns);
+        errdefer allocator.destroy(self);
+        const storage = try allocator.alignedAlloc(u8, .fromByteUnits(8), size);
+
+        const columns = @as([*]ColumnData, @ptrCast(storage.ptr))[0..batch.columns.len];
+        var pos = batch.columns.len * @sizeOf(ColumnData);
+        for (batch.columns, columns) |src, *dst| {
+            dst.* = src;
+            if (!copy) continue;
+            dst.values = take(storage, &pos, src.values);
+            if (src.offsets) |o| dst.offsets = @alignCast(std.mem.bytesAsSlice(i32, take(storage, &pos, std.mem.sliceAsBytes(o))));
+            if (src.validity) |v| dst.validity = take(storage, &pos, v);
+        }
+
+        self.* = .{ .batch = batch, .storage = storage };
+        self.batch.columns = columns;
+        return self;
+    }
+
+    /// Hand the arrays back to the caller, then free the queue entry.
+    pub fn destroy(self: *PendingColumns, allocator: Allocator) void {
+        if (self.batch.release) |release| release(self.batch.user_data);
+        allocator.free(self.storage);
+        allocator.destroy(self);
+    }
+
+    fn padded(n: usize) usize {
+        return std.mem.alignForward(usize, n, 8);
+    }
+
+    fn take(storage: []align(8) u8, pos: *usize, bytes: []const u8) []u8 {
+        const dst = storage[pos.*..][0..bytes.len];
+        @memcpy(dst, bytes);
+        pos.* += padded(bytes.len);
+        return dst;
+    }
+};
+
+/// Append rows `start..end` of `data`, a column of type `col`, to `writer`
+/// (a ColumnWriter). Runs of present fixed-width values go in one call.
+pub fn writeColumnRange(col: ColumnDef, data: ColumnData, start: usize, end: usize, writer: anytype) !void {
+    if (col.repeated) {
+        const offsets = data.offsets.?;
+        const width = col.elementSize();
+        for (start..end) |row| {
+            if (data.isNull(row)) {
+                try writer.writeNull();
+                continue;
+            }
+            const lo: usize = @intCast(offsets[row]);
+            const hi: usize = @intCast(offsets[row + 1]);
+            try writer.writeList(data.values[lo * width .. hi * width], hi - lo);
+        }
+        return;
+    }
+    if (col.physical_type == .BYTE_ARRAY) {
+        const offsets = data.offsets.?;
+        for (start..end) |row| {
+            if (data.isNull(row)) {
+                try writer.writeNull();
+                continue;
+            }
+            const lo: usize = @intCast(offsets[row]);
+            const hi: usize = @intCast(offsets[row + 1]);
+            try writer.writeByteArray(data.values[lo..hi]);
+        }
+        return;
+    }
+
+    const size = col.size;
+    if (data.validity == null) {
+        return writer.writePlainValues(data.values[start * size .. end * size], end - start);
+    }
+    var row = start;
+    while (row < end) {
+        if (data.isNull(row)) {
+            try writer.writeNull();
+            row += 1;
+            continue;
+        }
+        var run_end = row + 1;
+        while (run_end < end and !data.isNull(run_end)) run_end += 1;
+        try writer.writePlainValues(data.values[row * size .. run_end * size], run_end - row);
+        row = run_end;
+    }
+}
+
+// ---- Tests ----
+
+test "column batches validate against the schema and copy what they keep" {
+    const allocator = std.testing.allocator;
+    const columns = [_]ColumnDef{
+        .{ .name = "px", .physical_type = .INT64, .type_length = 0, .nullable = true, .offset = 0, .size = 8 },
+        .{ .name = "sym", .physical_type = .BYTE_ARRAY, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    };
+    const schema = SchemaInfo{ .columns = &columns, .record_size = 12, .nullable_count = 1, .null_bitmap_bytes = 1 };
+
+    const px = [_]i64{ 10, 0, 30 };
+    const validity = [_]u8{0b101};
+    const offsets = [_]i32{ 0, 3, 3, 7 };
+    var data = [_]ColumnData{
+        .{ .values = std.mem.sliceAsBytes(&px), .validity = &validity },
+        .{ .values = "abcwxyz", .offsets = &offsets },
+    };
+    const batch = ColumnBatch{ .columns = &data, .num_rows = 3 };
+    try batch.validate(schema);
+
+    const pending = try PendingColumns.create(allocator, batch);
+    defer pending.destroy(allocator);
+    // Copied: the caller's arrays may change once logColumns returns
+    data[1].values = "-------";
+    try std.testing.expectEqualStrings("abcwxyz", pending.batch.columns[1].values);
+    try std.testing.expect(pending.batch.columns[0].isNull(1));
+    try std.testing.expectEqualSlices(i32, &offsets, pending.batch.columns[1].offsets.?);
+
+    const Recorder = struct {
+        nulls: u32 = 0,
+        values: u32 = 0,
+        calls: u32 = 0,
+
+        pub fn writeNull(self: *@This()) !void {
+            self.nulls += 1;
+        }
+        pub fn writePlainValues(self: *@This(), _: []const u8, count: usize) !void {
+            self.values += @intCast(count);
+            self.calls += 1;
+        }
+        pub fn writeByteArray(self: *@This(), _: []const u8) !void {
+            self.values += 1;
+            self.calls += 1;
+        }
+    };
+    var rec = Recorder{};
+    try writeColumnRange(columns[0], pending.batch.columns[0], 0, 3, &rec);
+    try std.testing.expectEqual(@as(u32, 1), rec.nulls);
+    try std.testing.expectEqual(@as(u32, 2), rec.values);
+
+    const bad_offsets = [_]i32{ 0, 3, 2, 7 };
+    const bad = [_]ColumnData{ data[0], .{ .values = "abcwxyz", .offsets = &bad_offsets } };
+    try std.testing.expectError(error.InvalidColumns, (ColumnBatch{ .columns = &bad, .num_rows = 3 }).validate(schema));
+    try std.testing.expectError(error.InvalidColumns, (ColumnBatch{ .columns = data[0..1], .num_rows = 3 }).validate(schema));
+}
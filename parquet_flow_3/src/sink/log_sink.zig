@@ -1,30 +1,213 @@
 const std = @import("std");
 const Allocator = std.mem.Allocator;
-const RingBuffer = @import("ring_buffer.zig").RingBuffer;
+const ring_buffer = @import("ring_buffer.zig");
+const RingBuffer = ring_buffer.RingBuffer;
+const ByteRing = ring_buffer.ByteRing;
+const wait = @import("wait.zig");
+const futex = @import("../futex.zig");
+pub const WaitStrategy = wait.WaitStrategy;
 const batch_mod = @import("batch.zig");
 const BatchAccumulator = batch_mod.BatchAccumulator;
 const SchemaInfo = batch_mod.SchemaInfo;
+const column_batch = @import("column_batch.zig");
+pub const ColumnBatch = column_batch.ColumnBatch;
+pub const ColumnData = column_batch.ColumnData;
+pub const ReleaseFn = column_batch.ReleaseFn;
+const PendingColumns = column_batch.PendingColumns;
+const parquet = @import("../parquet/writer.zig");
+const FileWriter = parquet.FileWriter;
+const EncoderPool = parquet.EncoderPool;
+const Compressor = parquet.Compressor;
+const ParquetColumnDef = parquet.schema.ColumnDef;
+const CompressionCodec = parquet.parquet_types.CompressionCodec;
+pub const OutputBackend = parquet.parquet_output.OutputBackend;
+const stats_mod = @import("stats.zig");
+const spill = @import("spill.zig");
+const SpillJournal = spill.SpillJournal;
+const RingFile = @import("ring_file.zig").RingFile;
+const placement = @import("../placement.zig");
+const ThreadPlacement = placement.ThreadPlacement;
+const Region = placement.Region;
+pub const PagePolicy = placement.PagePolicy;
+const Counter = stats_mod.Counter;
+const StageTimes = stats_mod.StageTimes;
+pub const SinkStats = stats_mod.SinkStats;
+pub const Stage = stats_mod.Stage;
 const linux = std.os.linux;
 
-/// Maximum record size in bytes that can be pushed into the ring buffer.
-pub const MAX_RECORD_SIZE = 256;
+/// Default ring buffer capacity in bytes (must be power of 2). Records are
+/// stored length-prefixed and packed, so a 48-byte record costs 56 bytes.
+pub const RING_CAPACITY: u32 = 1 << 22; // 4 MiB
 
-/// A fixed-size record slot for the ring buffer. No heap allocation needed.
-pub const Record = struct {
-    data: [MAX_RECORD_SIZE]u8 = undefined,
-    len: u32 = 0,
+/// Default spill journal bytes per producer under the `.spill` policy.
+pub const DEFAULT_SPILL_CAPACITY: u32 = spill.DEFAULT_SPILL_CAPACITY;
+
+/// Default target data page size in bytes.
+pub const PAGE_SIZE: u32 = parquet.DEFAULT_PAGE_SIZE;
+
+/// Maximum number of records moved from the ring per drain call.
+const DRAIN_CHUNK: u32 = 256;
+
+/// Upper bound on a parked writer's sleep when no rows are pending.
+const IDLE_PARK_NS: u64 = std.time.ns_per_s;
+
+/// Maximum number of producer handles per sink, including the default one.
+pub const MAX_PRODUCERS = 64;
+
+/// Maximum number of batch accumulators per sink.
+pub const MAX_BATCH_BUFFERS = 8;
+
+/// Maximum number of `logColumns()` batches queued for the flush thread.
+pub const MAX_PENDING_COLUMN_BATCHES = 16;
+
+/// Maximum number of outputs of a partitioned sink.
+pub const MAX_PARTITIONS = 24;
+
+/// Upper bound on a single futex sleep in the batch handoff; waits re-check.
+const WAIT_SLICE_NS: u64 = 100 * std.time.ns_per_ms;
+
+/// Longest a `.block` producer waits for ring space by default.
+pub const DEFAULT_BLOCK_TIMEOUT_NS: u64 = std.time.ns_per_ms;
+
+const CACHE_LINE = 64;
+
+/// What a producer does with a record its ring has no room for (mirrors
+/// pqflow_overflow_policy).
+pub const OverflowPolicy = enum(i32) {
+    /// Refuse the new record with BufferFull.
+    drop_newest = 0,
+    /// Spin, waking the writer, until there is room or `block_timeout_ns`
+    /// passes, then refuse it with BufferFull.
+    block = 1,
+    /// Discard the oldest records in the ring until the new one fits.
+    drop_oldest = 2,
+    /// Append it to the producer's mmap'd spill journal, which the writer
+    /// thread replays in order once it has caught up with the ring.
+    spill = 3,
 };
 
-/// Ring buffer capacity (must be power of 2).
-pub const RING_CAPACITY: u32 = 1 << 16; // 65536 slots
+/// Suffix a rotating sink's file carries until its footer is written and
+/// synced; readers never see a half-written `<stem>.<seq>.<ext>`.
+pub const INPROGRESS_SUFFIX = ".inprogress";
+
+/// Rotated files that can wait for the finalizer thread. Past this the
+/// flush thread parks until the finalizer frees a slot, so files are still
+/// finalized in rotation order.
+const MAX_SEALED_FILES = 16;
+
+/// `rotation_mark` value when no rotation is requested.
+const NO_ROTATION = std.math.maxInt(u64);
 
 pub const SinkConfig = struct {
     /// Maximum rows per batch before flushing.
     batch_size: u32 = 65536,
     /// Flush timeout in nanoseconds. If no full batch within this time, flush partial.
     flush_timeout_ns: u64 = 100 * std.time.ns_per_ms, // 100ms default
-    /// Output file path (for future parquet writer integration).
-    file_path: ?[]const u8 = null,
+    /// Output file path. When null, batches are columnarized and discarded.
+    file_path: ?[:0]const u8 = null,
+    /// Compression codec applied to every data page.
+    codec: CompressionCodec = .UNCOMPRESSED,
+    /// ZSTD/GZIP level; 0 selects the codec's default.
+    compression_level: i32 = 0,
+    /// Target PLAIN value bytes per data page; column chunks are split into
+    /// pages of about this size.
+    page_size: u32 = PAGE_SIZE,
+    /// Maximum rows per data page; 0 = no limit.
+    page_row_limit: u32 = 0,
+    /// Ring buffer capacity in bytes (power of 2). Records up to half this
+    /// size are accepted.
+    ring_capacity: u32 = RING_CAPACITY,
+    /// How the writer thread waits when every ring is empty.
+    wait_strategy: WaitStrategy = .sleep,
+    /// Helper threads that encode/compress a row group's columns in parallel
+    /// with the writer thread. 0 encodes serially on the writer thread.
+    /// Requires a thread-safe allocator.
+    num_encoder_threads: u32 = 0,
+    /// Batch accumulators cycled between the writer and flush threads,
+    /// clamped to 2..MAX_BATCH_BUFFERS. The writer keeps draining rings into
+    /// a fresh accumulator while earlier batches are encoded and written;
+    /// each one costs `batch_size` rows of column buffers.
+    num_batch_buffers: u32 = 2,
+    /// Start a new file before a batch would take the current one past this
+    /// many rows (a single larger batch still gets its own file); 0 = unlimited.
+    max_rows_per_file: u64 = 0,
+    /// Start a new file once the current one reaches this many bytes;
+    /// 0 = unlimited.
+    max_bytes_per_file: u64 = 0,
+    /// Start a new file at every multiple of this wall-clock interval since
+    /// the Unix epoch, e.g. 5 minutes rotates at :00, :05, ...; 0 = never.
+    rotate_interval_ns: u64 = 0,
+    /// How files reach disk. `.io_uring` writes O_DIRECT from aligned
+    /// buffers, keeping capture out of the page cache, and falls back to
+    /// `.posix` where the kernel or filesystem does not support it.
+    output_backend: OutputBackend = .posix,
+    /// io_uring writes in flight, each of `DIRECT_BUFFER_SIZE` (1 MiB);
+    /// 0 selects the default of 4.
+    io_queue_depth: u32 = 0,
+    /// What `log()`/`reserve()` do when the producer's ring is full.
+    overflow_policy: OverflowPolicy = .drop_newest,
+    /// `.block` only: longest a producer waits for room; 0 selects
+    /// `DEFAULT_BLOCK_TIMEOUT_NS`.
+    block_timeout_ns: u64 = 0,
+    /// `.spill` only: journal path prefix, producer `i` spilling to
+    /// `<spill_path>.<i>`. Null uses `<file_path>.spill`.
+    spill_path: ?[:0]const u8 = null,
+    /// `.spill` only: journal bytes per producer (power of 2, at least
+    /// `ring_capacity`). Once a journal is full too, records are refused.
+    spill_capacity: u32 = DEFAULT_SPILL_CAPACITY,
+    /// Back producer `i`'s ring with the file `<ring_path>.<i>`, mapped
+    /// shared, instead of heap memory; put it on tmpfs (/dev/shm) or a DAX
+    /// mount. Committed records then outlive a crash of the process: `init`
+    /// reopens files left with the same capacity and schema and drains
+    /// their records first. Not fsynced, so a machine crash still loses the
+    /// rings unless the mount is persistent memory.
+    ring_path: ?[:0]const u8 = null,
+    /// Page size of heap rings: `.transparent` (THP) or `.hugetlb` (the
+    /// reserved pool, falling back to THP), so a burst across a multi-MiB
+    /// ring costs a handful of TLB entries. `ring_path` rings keep the
+    /// mount's pages.
+    ring_pages: PagePolicy = .default,
+    /// Bit n selects NUMA node n for the rings, the batch buffers and every
+    /// allocation of the sink's threads; 0 keeps the first-touch default.
+    /// Pick the node of the cores in `writer_cpus` and the producers.
+    numa_nodes: u64 = 0,
+    /// Fault in every ring and batch buffer page in `init`, so the first
+    /// burst after startup takes no page faults.
+    prefault: bool = false,
+    /// Linux CPU lists ("2", "4-7,12") to pin the writer thread, the flush
+    /// and finalizer threads, and the encoder helpers (one CPU of the list
+    /// each, round robin) to; null leaves them unpinned.
+    writer_cpus: ?[]const u8 = null,
+    flush_cpus: ?[]const u8 = null,
+    encoder_cpus: ?[]const u8 = null,
+    /// Route every record by this column to one of `num_partitions`
+    /// outputs, each with its own batches, file and rotation, written as a
+    /// Hive-style dataset: `<dir>/<column>_bucket=<k>/<name>` for a
+    /// `file_path` of `<dir>/<name>`. The key must be a required fixed-width
+    /// column. By default it is an INT32/INT64/BOOLEAN whose value, modulo
+    /// `num_partitions`, is `k` (e.g. an exchange id); with `partition_hash`
+    /// any such column is hashed instead (e.g. a symbol). `k` is a bucket,
+    /// not the key, so the directory never claims a column value the rows
+    /// do not hold. Null = one output.
+    partition_column: ?[]const u8 = null,
+    /// 1..MAX_PARTITIONS when `partition_column` is set. Each partition
+    /// keeps a batch of `batch_size` rows of column buffers filling, on top
+    /// of `num_batch_buffers`.
+    num_partitions: u32 = 0,
+    partition_hash: bool = false,
+
+    /// Whether any rotation limit is set. A rotating sink writes
+    /// `<stem>.<seq>.<ext>` (000000, 000001, ...) for a `file_path` of
+    /// `<stem>.<ext>`, each under an `INPROGRESS_SUFFIX` name until a
+    /// background thread has written its footer, fsynced and renamed it.
+    pub fn rotates(self: SinkConfig) bool {
+        return self.max_rows_per_file > 0 or self.max_bytes_per_file > 0 or self.rotate_interval_ns > 0;
+    }
+
+    /// Whether heap rings are mapped as `Region`s instead of allocated.
+    pub fn mapsRings(self: SinkConfig) bool {
+        return self.ring_pages != .default or self.numa_nodes != 0 or self.prefault;
+    }
 };
 
 pub const LogError = error{
@@ -32,8 +215,488 @@ pub const LogError = error{
     RecordTooLarge,
 };
 
+pub const CommitError = error{
+    /// No `reserve()` is pending: the last one failed, or its record was
+    /// already committed.
+    NoReservation,
+};
+
+pub const ColumnError = error{
+    BufferFull,
+    /// The batch does not match the schema (see `ColumnBatch.validate`).
+    InvalidColumns,
+    OutOfMemory,
+};
+
+/// One producer thread's private SPSC ring. Each hot thread registers its own
+/// producer, so pushes never contend or CAS; the writer thread is the single
+/// consumer of every ring. A full ring is handled by `policy`, off the fast
+/// path.
+pub const Producer = struct {
+    ring: ByteRing,
+    /// Set for futex-based wait strategies: wakes the writer if it is parked.
+    parker: ?*wait.Parker,
+    counters: stats_mod.ProducerCounters,
+    policy: OverflowPolicy,
+    block_timeout_ns: u64,
+    /// `.spill` only: the overflow journal, whether records currently go to
+    /// it (from the first full ring until the writer has replayed it all),
+    /// and whether the open reservation is in it.
+    journal: ?*SpillJournal,
+    spilling: bool,
+    pending_spill: bool,
+    /// The last `reserve()` succeeded and its record is not committed yet.
+    reserved: bool,
+
+    // `.drop_oldest` only: Dekker-style exclusion between the producer
+    // evicting from the read end and the writer thread draining the ring.
+    // Each side raises its flag (seq_cst), then backs off if the other's
+    // is up, so at most one of them ever moves `read_pos`.
+    evicting: std.atomic.Value(bool) align(CACHE_LINE),
+    draining: std.atomic.Value(bool) align(CACHE_LINE),
+
+    /// `ring_path` only: the mapped file this producer itself lives in.
+    ring_file: ?RingFile,
+    /// The ring's memory when `SinkConfig.mapsRings()`.
+    ring_region: ?Region,
+
+    /// Copies record data into this producer's ring. Non-blocking except
+    /// under the `.block` policy, which waits at most `block_timeout_ns`.
+    pub fn log(self: *Producer, record: []const u8) LogError!void {
+        const dest = try self.reserve(record.len);
+        @memcpy(dest, record);
+        self.commit() catch unreachable;
+    }
+
+    /// Like `log()`, but waits as long as it takes for ring room instead of
+    /// applying the overflow policy: the record never evicts, spills or
+    /// counts as dropped. For bulk loads such as replaying a capture, not
+    /// for hot threads.
+    pub fn logWait(self: *Producer, record: []const u8) LogError!void {
+        self.reserved = false;
+        if (record.len > self.ring.maxRecordLen()) {
+            self.counters.dropped_too_large.add(1);
+            return LogError.RecordTooLarge;
+        }
+        if (self.parker) |parker| parker.wake();
+        while (true) {
+            // Back on the ring only once the writer has replayed the
+            // journal, as in `reserveSpill`, so records keep their order
+            if (self.spilling and self.journal.?.ring.isEmpty()) self.spilling = false;
+            if (!self.spilling) {
+                if (self.ring.reserve(record.len)) |dest| {
+                    @memcpy(dest, record);
+                    self.counters.pending_len = record.len;
+                    self.pending_spill = false;
+                    self.reserved = true;
+                    self.commit() catch unreachable;
+                    return;
+                }
+            }
+            std.Thread.yield() catch {};
+        }
+    }
+
+    /// Non-blocking. Claims `len` bytes of ring memory so the caller can build
+    /// the record in place; it becomes visible to the writer thread on
+    /// `commit()`. Removes the copy `log()` performs. A failed reserve
+    /// abandons any earlier, uncommitted one.
+    pub fn reserve(self: *Producer, len: usize) LogError![]u8 {
+        self.reserved = false;
+        const dest = try self.claim(len);
+        self.reserved = true;
+        return dest;
+    }
+
+    fn claim(self: *Producer, len: usize) LogError![]u8 {
+        if (len > self.ring.maxRecordLen()) {
+            self.counters.dropped_too_large.add(1);
+            return LogError.RecordTooLarge;
+        }
+        self.counters.pending_len = len;
+        if (!self.spilling) {
+            if (self.ring.reserve(len)) |dest| {
+                self.pending_spill = false;
+                return dest;
+            }
+        }
+        return self.reserveOverflow(len);
+    }
+
+    /// Publishes the record claimed by the last `reserve()`. NoReservation,
+    /// publishing and counting nothing, after a failed `reserve()` or a
+    /// second commit of the same record.
+    pub fn commit(self: *Producer) CommitError!void {
+        if (!self.reserved) return CommitError.NoReservation;
+        self.reserved = false;
+        self.counters.logged.add(1);
+        self.counters.logged_bytes.add(self.counters.pending_len);
+        const ring = if (self.pending_spill) &self.journal.?.ring else &self.ring;
+        if (self.pending_spill) self.counters.spilled.add(1);
+        if (self.parker) |parker| {
+            const published = ring.commitSeqCst();
+            std.debug.assert(published);
+            parker.wake();
+        } else {
+            const published = ring.commit();
+            std.debug.assert(published);
+        }
+    }
+
+    /// The ring is full (or records are going to the journal): apply the
+    /// overflow policy.
+    fn reserveOverflow(self: *Producer, len: usize) LogError![]u8 {
+        const dest = switch (self.policy) {
+            .drop_newest => null,
+            .block => self.reserveBlocking(len),
+            .drop_oldest => self.reserveEvicting(len),
+            .spill => return self.reserveSpill(len),
+        } orelse {
+            self.counters.dropped_full.add(1);
+            return LogError.BufferFull;
+        };
+        self.pending_spill = false;
+        return dest;
+    }
+
+    fn reserveBlocking(self: *Producer, len: usize) ?[]u8 {
+        if (self.parker) |parker| parker.wake();
+        const deadline = monotonicNs() + self.block_timeout_ns;
+        while (true) {
+            for (0..BLOCK_SPINS_PER_CHECK) |_| {
+                std.atomic.spinLoopHint();
+                if (self.ring.reserve(len)) |dest| return dest;
+            }
+            if (monotonicNs() >= deadline) return null;
+        }
+    }
+
+    /// Evict the oldest records until `len` bytes fit. Gives up (and the
+    /// new record is dropped instead) if the writer is draining this ring
+    /// right now, since that is about to free space anyway.
+    fn reserveEvicting(self: *Producer, len: usize) ?[]u8 {
+        self.evicting.store(true, .seq_cst);
+        defer self.evicting.store(false, .release);
+        if (self.draining.load(.seq_cst)) return null;
+        while (true) {
+            if (self.ring.reserve(len)) |dest| return dest;
+            if (!self.ring.evictOldest()) return null;
+            self.counters.dropped_oldest.add(1);
+        }
+    }
+
+    /// Append to the journal, or go back to the ring once the writer has
+    /// replayed every spilled record. The writer only reads the journal
+    /// when the ring is empty, so records keep their order.
+    fn reserveSpill(self: *Producer, len: usize) LogError![]u8 {
+        const journal = &self.journal.?.ring;
+        if (self.spilling and journal.isEmpty()) {
+            self.spilling = false;
+            if (self.ring.reserve(len)) |dest| {
+                self.pending_spill = false;
+                return dest;
+            }
+        }
+        self.spilling = true;
+        const dest = journal.reserve(len) orelse {
+            self.counters.dropped_full.add(1);
+            return LogError.BufferFull;
+        };
+        self.pending_spill = true;
+        return dest;
+    }
+};
+
+/// `.block` producers re-check the clock after this many failed reserves.
+const BLOCK_SPINS_PER_CHECK = 64;
+
+/// Changes whenever a build lays out `Producer` differently, so a ring file
+/// is only reopened by a build that finds its positions where they were.
+const PRODUCER_LAYOUT_HASH: u64 = blk: {
+    @setEvalBranchQuota(10_000);
+    const layout = [_]u64{
+        @sizeOf(Producer),
+        @offsetOf(Producer, "ring"),
+        @offsetOf(ByteRing, "write_pos"),
+        @offsetOf(ByteRing, "read_pos"),
+        ByteRing.HEADER_SIZE,
+        ByteRing.RECORD_ALIGN,
+    };
+    break :blk std.hash.Wyhash.hash(0, std.mem.sliceAsBytes(&layout));
+};
+
+fn threadPlacement(cpus: ?[]const u8, numa_nodes: u64) !ThreadPlacement {
+    return .{
+        .cpus = if (cpus) |list| try placement.CpuSet.parse(list) else .empty,
+        .numa_nodes = numa_nodes,
+    };
+}
+
+/// Identifies the record layout, so a ring file is never drained with a
+/// schema other than the one that filled it.
+fn schemaHash(schema: SchemaInfo) u64 {
+    var h = std.hash.Wyhash.init(0);
+    h.update(std.mem.asBytes(&schema.record_size));
+    for (schema.columns) |col| {
+        h.update(col.name);
+        const fields = [_]u32{ @bitCast(@intFromEnum(col.physical_type)), col.type_length, @intFromBool(col.nullable), col.offset, col.size, @intFromBool(col.repeated) };
+        h.update(std.mem.sliceAsBytes(&fields));
+    }
+    return h.final();
+}
+
+/// SPSC handoff of `T`s between two threads, with a blocking pop.
+fn Handoff(comptime T: type, comptime capacity: u32) type {
+    return struct {
+        const Self = @This();
+
+        ring: RingBuffer(T, capacity) = .{},
+        /// Bumped by every push and by `close()`; the futex word `popWait`
+        /// sleeps on, so a push between its check and its sleep is never missed.
+        seq: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+        closed: std.atomic.Value(bool) = std.atomic.Value(bool).init(false),
+        /// Bumped by every pop; the futex word `pushWait` sleeps on, woken
+        /// only while `push_waiting` is up so pops stay syscall-free.
+        freed: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+        push_waiting: std.atomic.Value(bool) = std.atomic.Value(bool).init(false),
+
+        fn push(self: *Self, item: T) void {
+            const pushed = self.tryPush(item);
+            std.debug.assert(pushed);
+        }
+
+        /// Push, parking until a pop frees a slot if the queue is full.
+        fn pushWait(self: *Self, item: T) void {
+            while (true) {
+                const freed = self.freed.load(.seq_cst);
+                if (self.tryPush(item)) return;
+                self.push_waiting.store(true, .seq_cst);
+                futex.wait(&self.freed, freed, WAIT_SLICE_NS);
+                self.push_waiting.store(false, .monotonic);
+            }
+        }
+
+        fn pop(self: *Self) ?T {
+            const item = self.ring.tryPop() orelse return null;
+            _ = self.freed.fetchAdd(1, .seq_cst);
+            if (self.push_waiting.load(.seq_cst)) futex.wake(&self.freed, 1);
+            return item;
+        }
+
+        fn tryPush(self: *Self, item: T) bool {
+            if (!self.ring.tryPush(item)) return false;
+            self.signal();
+            return true;
+        }
+
+        /// No more pushes follow; `popWait` returns null once the queue is empty.
+        fn close(self: *Self) void {
+            self.closed.store(true, .release);
+            self.signal();
+        }
+
+        /// Wake a waiting consumer without pushing.
+        fn signal(self: *Self) void {
+            _ = self.seq.fetchAdd(1, .release);
+            futex.wake(&self.seq, 1);
+        }
+
+        fn popWait(self: *Self) ?T {
+            while (true) {
+                const seq = self.seq.load(.acquire);
+                const closed = self.closed.load(.acquire);
+                if (self.pop()) |item| return item;
+                if (closed) return null;
+                futex.wait(&self.seq, seq, WAIT_SLICE_NS);
+            }
+        }
+
+        /// Like `popWait`, but sleeps at most once, for up to `timeout_ns`.
+        /// error.Timeout when that sleep ends (or a `signal()` cuts it
+        /// short) with the queue still empty.
+        fn popWaitFor(self: *Self, timeout_ns: u64) error{Timeout}!?T {
+            return self.popWaitForAfter(self.observe(), timeout_ns);
+        }
+
+        /// The signal count, for a consumer that checks other work before
+        /// `popWaitForAfter`: a `signal()` for that work after this load
+        /// keeps the wait from sleeping.
+        fn observe(self: *const Self) u32 {
+            return self.seq.load(.acquire);
+        }
+
+        fn popWaitForAfter(self: *Self, seq: u32, timeout_ns: u64) error{Timeout}!?T {
+            const closed = self.closed.load(.acquire);
+            if (self.pop()) |item| return item;
+            if (closed) return null;
+            futex.wait(&self.seq, seq, timeout_ns);
+            return self.pop() orelse error.Timeout;
+        }
+    };
+}
+
+/// Accumulators between the writer and flush threads. Holds at most
+/// MAX_BATCH_BUFFERS + MAX_PARTITIONS entries, so pushes never fail.
+const BatchQueue = Handoff(*BatchAccumulator, 2 * (MAX_BATCH_BUFFERS + MAX_PARTITIONS));
+
+/// Routes the records of a partitioned sink to its outputs by one
+/// fixed-width column (see `SinkConfig.partition_column`).
+const Partitioner = struct {
+    column: batch_mod.ColumnDef,
+    count: u32,
+    hash: bool,
+
+    /// Null for a sink with a single output.
+    fn init(config: SinkConfig, schema: SchemaInfo) !?Partitioner {
+        const name = config.partition_column orelse return null;
+        if (config.num_partitions == 0 or config.num_partitions > MAX_PARTITIONS) return error.InvalidPartitions;
+        for (schema.columns) |col| {
+            if (!std.mem.eql(u8, col.name, name)) continue;
+            if (col.nullable or col.inTail()) return error.InvalidPartitionColumn;
+            if (!config.partition_hash) switch (col.physical_type) {
+                .BOOLEAN, .INT32, .INT64 => {},
+                else => return error.InvalidPartitionColumn,
+            };
+            return .{ .column = col, .count = config.num_partitions, .hash = config.partition_hash };
+        }
+        return error.InvalidPartitionColumn;
+    }
+
+    /// Output of `record`. A record too short to hold the key goes to
+    /// output 0, whose accumulator rejects it.
+    fn of(self: Partitioner, record: []const u8) u32 {
+        const col = self.column;
+        if (record.len < col.offset + col.size) return 0;
+        const slot = record[col.offset..][0..col.size];
+        if (self.hash) return @intCast(std.hash.Wyhash.hash(0, slot) % self.count);
+        const key: i64 = switch (col.physical_type) {
+            .BOOLEAN => slot[0],
+            .INT32 => std.mem.readInt(i32, slot[0..4], .little),
+            .INT64 => std.mem.readInt(i64, slot[0..8], .little),
+            else => unreachable,
+        };
+        return @intCast(@mod(key, @as(i64, self.count)));
+    }
+
+    /// `file_path` moved into the directory of output `k`, which is
+    /// created if missing. Named `<column>_bucket=<k>` in both modes: `k`
+    /// is a key modulo the count (or a hash), which a Hive reader must not
+    /// take for the column's value.
+    fn outputPath(self: Partitioner, allocator: Allocator, file_path: []const u8, k: u32) ![:0]u8 {
+        const name_start = if (std.mem.lastIndexOfScalar(u8, file_path, '/')) |i| i + 1 else 0;
+        const dir = try std.fmt.allocPrintSentinel(allocator, "{s}{s}_bucket={d}", .{ file_path[0..name_start], self.column.name, k }, 0);
+        defer allocator.free(dir);
+        switch (linux.errno(linux.mkdir(dir, 0o755))) {
+            .SUCCESS, .EXIST => {},
+            else => return error.FileOpenFailed,
+        }
+        return std.fmt.allocPrintSentinel(allocator, "{s}/{s}", .{ dir, file_path[name_start..] }, 0);
+    }
+};
+
+/// Paths of one file of a rotating sink.
+const FilePaths = struct {
+    /// Where the file is written until it is finalized.
+    inprogress: [:0]u8,
+    final: [:0]u8,
+
+    /// Paths of file `seq` for a sink `file_path` of `<stem>.<ext>`.
+    fn init(allocator: Allocator, file_path: []const u8, seq: u32) !FilePaths {
+        const name_start = if (std.mem.lastIndexOfScalar(u8, file_path, '/')) |i| i + 1 else 0;
+        var stem_len = file_path.len;
+        if (std.mem.lastIndexOfScalar(u8, file_path[name_start..], '.')) |dot| {
+            // A leading dot is part of the name, not an extension
+            if (dot > 0) stem_len = name_start + dot;
+        }
+
+        const final = try std.fmt.allocPrintSentinel(
+            allocator,
+            "{s}.{d:0>6}{s}",
+            .{ file_path[0..stem_len], seq, file_path[stem_len..] },
+            0,
+        );
+        errdefer allocator.free(final);
+        const inprogress = try std.fmt.allocPrintSentinel(allocator, "{s}" ++ INPROGRESS_SUFFIX, .{final}, 0);
+        return .{ .inprogress = inprogress, .final = final };
+    }
+
+    fn deinit(self: FilePaths, allocator: Allocator) void {
+        allocator.free(self.inprogress);
+        allocator.free(self.final);
+    }
+};
+
+/// A file, or the series of files of a rotating sink. A partitioned sink
+/// has one per partition; owned by the flush thread once it is running.
+const Output = struct {
+    /// `file_path`, or for a partitioned sink this output's copy of it
+    /// inside its partition directory (allocated).
+    path: ?[:0]const u8,
+    writer: ?FileWriter,
+    /// Rotating sinks only: paths and sequence number of the open file.
+    paths: ?FilePaths,
+    seq: u32,
+
+    fn open(
+        allocator: Allocator,
+        config: SinkConfig,
+        columns: []const ParquetColumnDef,
+        encoder_pool: ?*EncoderPool,
+        partitioner: ?Partitioner,
+        k: u32,
+    ) !Output {
+        var out = Output{ .path = config.file_path, .writer = null, .paths = null, .seq = 0 };
+        const file_path = config.file_path orelse return out;
+        if (partitioner) |p| out.path = try p.outputPath(allocator, file_path, k);
+        errdefer if (partitioner != null) allocator.free(out.path.?);
+        if (config.rotates()) out.paths = try FilePaths.init(allocator, out.path.?, 0);
+        errdefer if (out.paths) |paths| paths.deinit(allocator);
+        const open_path = if (out.paths) |paths| paths.inprogress else out.path.?;
+        out.writer = try openWriter(allocator, config, columns, open_path, encoder_pool);
+        return out;
+    }
+
+    /// Free what `open` allocated. A writer still open is dropped without
+    /// its footer.
+    fn deinit(self: *Output, allocator: Allocator, owns_path: bool) void {
+        if (self.writer) |*fw| fw.deinit();
+        if (self.paths) |paths| paths.deinit(allocator);
+        if (owns_path) {
+            if (self.path) |path| allocator.free(path);
+        }
+    }
+};
+
+/// A rotated-out file: every row group is written, the footer is not.
+const SealedFile = struct {
+    writer: FileWriter,
+    paths: FilePaths,
+};
+
+const SealedQueue = Handoff(*SealedFile, MAX_SEALED_FILES);
+
+/// Open `path` as a new output file with the sink's writer settings.
+fn openWriter(
+    allocator: Allocator,
+    config: SinkConfig,
+    columns: []const ParquetColumnDef,
+    path: [*:0]const u8,
+    encoder_pool: ?*EncoderPool,
+) !FileWriter {
+    var fw = try FileWriter.initFileWith(allocator, columns, config.codec, path, .{
+        .backend = config.output_backend,
+        .queue_depth = config.io_queue_depth,
+    });
+    fw.compressor.level = config.compression_level;
+    fw.page_limits = .{ .bytes = config.page_size, .rows = config.page_row_limit };
+    fw.encoder_pool = encoder_pool;
+    // A rotated file is only renamed into place once it is durable
+    fw.sync_on_close = config.rotates();
+    return fw;
+}
+
 /// Sleep for the given number of nanoseconds using the Linux nanosleep syscall.
-fn nanosleep(ns: u64) void {
+pub fn nanosleep(ns: u64) void {
     const secs = ns / std.time.ns_per_s;
     const nsecs = ns % std.time.ns_per_s;
     var req = linux.timespec{
@@ -48,6 +711,18 @@ fn nanosleep(ns: u64) void {
     }
 }
 
+/// Wall-clock time in nanoseconds since the Unix epoch.
+fn realtimeNs() u64 {
+    var ts: linux.timespec = undefined;
+    _ = linux.clock_gettime(.REALTIME, &ts);
+    return @as(u64, @intCast(ts.sec)) * std.time.ns_per_s + @as(u64, @intCast(ts.nsec));
+}
+
+/// First multiple of `interval_ns` after `now_ns`.
+fn nextBoundary(now_ns: u64, interval_ns: u64) u64 {
+    return (now_ns / interval_ns + 1) * interval_ns;
+}
+
 /// Get current monotonic time in nanoseconds.
 fn monotonicNs() u64 {
     var ts: linux.timespec = undefined;
@@ -55,117 +730,942 @@ fn monotonicNs() u64 {
     return @as(u64, @intCast(ts.sec)) * std.time.ns_per_s + @as(u64, @intCast(ts.nsec));
 }
 
-/// Top-level log sink. Combines a lock-free ring buffer with a background
-/// writer thread that drains records into a batch accumulator.
+/// Top-level log sink. Combines per-producer lock-free ring buffers with a
+/// background writer thread that drains them round-robin into a batch
+/// accumulator. Every full (or timed-out) batch is handed to a flush thread
+/// that writes it as one Parquet row group, while the writer carries on
+/// draining into the next free accumulator. Rotating sinks hand finished
+/// files to a finalizer thread, so neither thread waits on a footer, fsync
+/// or rename.
 pub const LogSink = struct {
-    ring: *RingBuffer(Record, RING_CAPACITY),
+    /// Producer used by `log()`/`reserve()`/`commit()` on the sink itself.
+    default_producer: *Producer,
+    /// Registered producers; slots below `producer_count` are claimed, and a
+    /// claimed slot reads null until its ring is ready.
+    producers: [MAX_PRODUCERS]std.atomic.Value(?*Producer),
+    producer_count: std.atomic.Value(u32),
+    /// Index the next `registerProducer()` claims. Ahead of `producer_count`
+    /// only while rings recovered by `init` wait for their producers.
+    next_producer: std.atomic.Value(u32),
+    /// `ring_path` only: see `schemaHash()`.
+    schema_hash: u64,
+    /// Unconsumed records found in reopened ring files.
+    records_recovered: std.atomic.Value(u64),
+    /// Reopened ring files whose positions or frames did not check out.
+    rings_discarded: std.atomic.Value(u64),
+    /// Applied by the writer thread, and by the flush and finalizer threads.
+    writer_placement: ThreadPlacement,
+    flush_placement: ThreadPlacement,
+    /// Writer-thread-only: ring the next drain pass starts from.
+    drain_cursor: u32,
+    /// Where the writer thread parks under futex-based wait strategies.
+    parker: wait.Parker,
     writer_thread: ?std.Thread,
+    flush_thread: ?std.Thread,
+    finalizer_thread: ?std.Thread,
     running: std.atomic.Value(bool),
     config: SinkConfig,
     schema: SchemaInfo,
     allocator: Allocator,
 
+    /// Accumulators cycled between the writer and flush threads.
+    batch_buffers: []BatchAccumulator,
+    /// Empty accumulators returned by the flush thread.
+    free_batches: BatchQueue,
+    /// Full (or timed-out) accumulators waiting to be written.
+    full_batches: BatchQueue,
+
+    /// Set for a partitioned sink; `outputs` has one entry per partition.
+    partitioner: ?Partitioner,
+    /// Writer-thread-only: the accumulator filling for each output.
+    current_batches: []*BatchAccumulator,
+
+    // Owned by the flush thread once it is running.
+    outputs: []Output,
+    encoder_pool: ?*EncoderPool,
+    parquet_columns: []ParquetColumnDef,
+    /// Wall-clock deadline of the next `rotate_interval_ns` rotation.
+    next_rotation_ns: u64,
+    /// Batches written so far.
+    batches_taken: u64,
+    /// `logColumns()` batches for the flush thread, newest first.
+    pending_columns: std.atomic.Value(?*PendingColumns),
+    pending_column_count: std.atomic.Value(u32),
+
+    /// Writer-thread-only: batches handed to the flush thread so far.
+    batches_handed_off: u64,
+    /// Set by `rotate()` for the writer thread.
+    rotate_pending: std.atomic.Value(bool),
+    /// Batch count after which the flush thread starts a new file, or
+    /// NO_ROTATION; set by the writer thread once it has handed off every
+    /// record logged before a `rotate()`.
+    rotation_mark: std.atomic.Value(u64),
+    /// Rotated files waiting for their footer, fsync and rename.
+    sealed_files: SealedQueue,
+
     // Stats
     records_written: std.atomic.Value(u64),
+    /// Drained records the batches rejected; not in `records_written`.
+    records_rejected: std.atomic.Value(u64),
     batches_flushed: std.atomic.Value(u64),
+    write_errors: std.atomic.Value(u64),
+    files_finalized: std.atomic.Value(u64),
+    // Flush thread only (see `stats()`)
+    bytes_uncompressed: Counter,
+    bytes_compressed: Counter,
+    bytes_written: Counter,
+    column_rows_written: Counter,
+    stage_times: *StageTimes,
 
     pub fn init(config: SinkConfig, schema: SchemaInfo, allocator: Allocator) !*LogSink {
-        const ring = try allocator.create(RingBuffer(Record, RING_CAPACITY));
-        ring.* = RingBuffer(Record, RING_CAPACITY).init();
+        if (config.overflow_policy == .spill) {
+            if (config.spill_path == null and config.file_path == null) return error.SpillPathRequired;
+            if (config.spill_capacity < config.ring_capacity) return error.InvalidCapacity;
+        }
+        const partitioner = try Partitioner.init(config, schema);
+        const writer_placement = try threadPlacement(config.writer_cpus, config.numa_nodes);
+        const flush_placement = try threadPlacement(config.flush_cpus, config.numa_nodes);
+        const encoder_placement = try threadPlacement(config.encoder_cpus, config.numa_nodes);
+
+        // Buffers allocated here are the threads' to use; fault them in on
+        // their node
+        const saved_policy: ?placement.SavedPolicy = if (config.numa_nodes != 0) placement.SavedPolicy.save() else null;
+        if (saved_policy != null) _ = placement.setThreadNodes(config.numa_nodes);
+        defer if (saved_policy) |policy| policy.restore();
+
+        const parquet_columns = try allocator.alloc(ParquetColumnDef, schema.columns.len);
+        errdefer allocator.free(parquet_columns);
+        for (schema.columns, parquet_columns) |col, *pc| {
+            pc.* = .{
+                .name = col.name,
+                .physical_type = @enumFromInt(@intFromEnum(col.physical_type)),
+                .type_length = if (col.physical_type == .FIXED_LEN_BYTE_ARRAY) @as(i32, @intCast(col.type_length)) else null,
+                .repetition_type = if (col.nullable) .OPTIONAL else .REQUIRED,
+                .dictionary = switch (col.encoding) {
+                    .default => null,
+                    .dictionary => true,
+                    else => false,
+                },
+                .encoding = switch (col.encoding) {
+                    .delta_binary_packed => .DELTA_BINARY_PACKED,
+                    .byte_stream_split => .BYTE_STREAM_SPLIT,
+                    else => .PLAIN,
+                },
+                .bloom_filter = col.bloom_filter,
+                .list = col.repeated,
+            };
+            if (col.unsigned) {
+                const is_64 = col.physical_type == .INT64;
+                pc.converted_type = if (is_64) .UINT_64 else .UINT_32;
+                pc.logical_type = .{ .INTEGER = .{ .bit_width = if (is_64) 64 else 32, .is_signed = false } };
+            }
+        }
+
+        var encoder_pool: ?*EncoderPool = null;
+        if (config.file_path != null and config.num_encoder_threads > 0) {
+            encoder_pool = try EncoderPool.init(allocator, config.num_encoder_threads, encoder_placement);
+        }
+        errdefer if (encoder_pool) |pool| pool.deinit();
+
+        const num_outputs: u32 = if (partitioner) |p| p.count else 1;
+        const outputs = try allocator.alloc(Output, num_outputs);
+        errdefer allocator.free(outputs);
+        var num_open: u32 = 0;
+        errdefer for (outputs[0..num_open]) |*out| out.deinit(allocator, partitioner != null);
+        while (num_open < outputs.len) : (num_open += 1) {
+            outputs[num_open] = try Output.open(allocator, config, parquet_columns, encoder_pool, partitioner, num_open);
+        }
+
+        const current_batches = try allocator.alloc(*BatchAccumulator, num_outputs);
+        errdefer allocator.free(current_batches);
+
+        // Every output holds one filling accumulator; the rest rotate
+        // through the flush thread as before
+        const num_buffers = std.math.clamp(config.num_batch_buffers, 2, MAX_BATCH_BUFFERS) + num_outputs - 1;
+        const batch_buffers = try allocator.alloc(BatchAccumulator, num_buffers);
+        errdefer allocator.free(batch_buffers);
+        var num_ready: usize = 0;
+        errdefer for (batch_buffers[0..num_ready]) |*b| b.deinit();
+        while (num_ready < batch_buffers.len) : (num_ready += 1) {
+            batch_buffers[num_ready] = try BatchAccumulator.init(allocator, schema, config.batch_size);
+            if (config.prefault) batch_buffers[num_ready].prefault();
+        }
+
+        const stage_times = try StageTimes.create(allocator);
+        errdefer allocator.destroy(stage_times);
 
         const self = try allocator.create(LogSink);
+        errdefer allocator.destroy(self);
+
         self.* = LogSink{
-            .ring = ring,
+            .default_producer = undefined,
+            .producers = [_]std.atomic.Value(?*Producer){std.atomic.Value(?*Producer).init(null)} ** MAX_PRODUCERS,
+            .producer_count = std.atomic.Value(u32).init(1),
+            .next_producer = std.atomic.Value(u32).init(1),
+            .schema_hash = schemaHash(schema),
+            .records_recovered = std.atomic.Value(u64).init(0),
+            .rings_discarded = std.atomic.Value(u64).init(0),
+            .writer_placement = writer_placement,
+            .flush_placement = flush_placement,
+            .drain_cursor = 0,
+            .parker = .{},
             .writer_thread = null,
+            .flush_thread = null,
+            .finalizer_thread = null,
             .running = std.atomic.Value(bool).init(true),
             .config = config,
             .schema = schema,
             .allocator = allocator,
+            .batch_buffers = batch_buffers,
+            .free_batches = .{},
+            .full_batches = .{},
+            .partitioner = partitioner,
+            .current_batches = current_batches,
+            .outputs = outputs,
+            .encoder_pool = encoder_pool,
+            .parquet_columns = parquet_columns,
+            .next_rotation_ns = if (config.rotate_interval_ns > 0)
+                nextBoundary(realtimeNs(), config.rotate_interval_ns)
+            else
+                NO_ROTATION,
+            .batches_taken = 0,
+            .pending_columns = std.atomic.Value(?*PendingColumns).init(null),
+            .pending_column_count = std.atomic.Value(u32).init(0),
+            .batches_handed_off = 0,
+            .rotate_pending = std.atomic.Value(bool).init(false),
+            .rotation_mark = std.atomic.Value(u64).init(NO_ROTATION),
+            .sealed_files = .{},
             .records_written = std.atomic.Value(u64).init(0),
+            .records_rejected = std.atomic.Value(u64).init(0),
             .batches_flushed = std.atomic.Value(u64).init(0),
+            .write_errors = std.atomic.Value(u64).init(0),
+            .files_finalized = std.atomic.Value(u64).init(0),
+            .bytes_uncompressed = .{},
+            .bytes_compressed = .{},
+            .bytes_written = .{},
+            .column_rows_written = .{},
+            .stage_times = stage_times,
         };
 
+        const default_producer = try self.createProducer(allocator, config, 0, try self.openRingFile(0, true));
+        errdefer destroyProducer(allocator, default_producer);
+        self.default_producer = default_producer;
+        self.producers[0].store(default_producer, .release);
+
+        // Rings a crashed run left for other producers: the writer drains
+        // them first, and the i-th producer registered continues in ring i
+        errdefer for (self.producers[1..]) |*slot| {
+            if (slot.load(.monotonic)) |producer| destroyProducer(allocator, producer);
+        };
+        if (config.ring_path != null) {
+            for (1..MAX_PRODUCERS) |i| {
+                const index: u32 = @intCast(i);
+                const file = try self.openRingFile(index, false) orelse continue;
+                self.producers[i].store(try self.createProducer(allocator, config, index, file), .release);
+                self.producer_count.store(index + 1, .release);
+            }
+        }
+
+        for (self.batch_buffers) |*b| self.free_batches.push(b);
+
+        if (config.file_path != null and config.rotates()) {
+            self.finalizer_thread = try std.Thread.spawn(.{}, finalizerThread, .{self});
+        }
+        errdefer if (self.finalizer_thread) |t| {
+            self.sealed_files.close();
+            t.join();
+        }
+
+        self.flush_thread = try std.Thread.spawn(.{}, flushThread, .{self});
+        errdefer {
+            self.full_batches.close();
+            self.flush_thread.?.join();
+        }
         self.writer_thread = try std.Thread.spawn(.{}, writerThread, .{self});
 
         return self;
     }
 
+    /// `<ring_path>.<index>`, or null without `ring_path` (or, unless
+    /// `create`, without the file).
+    fn openRingFile(self: *LogSink, index: u32, create: bool) !?RingFile {
+        const prefix = self.config.ring_path orelse return null;
+        const path = try std.fmt.allocPrintSentinel(self.allocator, "{s}.{d}", .{ prefix, index }, 0);
+        return RingFile.open(self.allocator, path, self.config.ring_capacity, self.schema_hash, PRODUCER_LAYOUT_HASH, create);
+    }
+
+    /// A producer on the heap, or inside `file` (taking ownership of it),
+    /// keeping the committed records of a reopened file.
+    fn createProducer(self: *LogSink, allocator: Allocator, config: SinkConfig, index: u32, file: ?RingFile) !*Producer {
+        errdefer if (file) |f| f.close(allocator, false);
+        const producer = if (file) |f| f.state(Producer) else try allocator.create(Producer);
+        errdefer if (file == null) allocator.destroy(producer);
+
+        var region: ?Region = null;
+        if (file == null and config.mapsRings()) {
+            region = try Region.alloc(config.ring_capacity, config.ring_pages, config.numa_nodes, config.prefault);
+        }
+        errdefer if (region) |r| r.free();
+        if (file) |f| {
+            if (config.numa_nodes != 0) _ = placement.bindMemory(f.mapping, config.numa_nodes);
+        }
+
+        var ring = if (file) |f|
+            try ByteRing.initBuffer(f.data())
+        else if (region) |r|
+            try ByteRing.initBuffer(r.memory)
+        else
+            try ByteRing.init(allocator, config.ring_capacity);
+        errdefer if (file == null and region == null) ring.deinit(allocator);
+        var recovered: u64 = 0;
+        if (file) |f| {
+            if (f.reopened) {
+                // Restored before the producer is rewritten, so the positions
+                // in the file never change while it is still marked valid
+                const r = producer.ring.read_pos.load(.monotonic);
+                const w = producer.ring.write_pos.load(.monotonic);
+                // Every frame header is checked before the writer walks
+                // them; anything torn discards the ring rather than its tail
+                if (ring.countFrames(r, w)) |count| {
+                    ring.restore(r, w);
+                    recovered = count;
+                } else {
+                    _ = self.rings_discarded.fetchAdd(1, .monotonic);
+                }
+            }
+        }
+
+        var journal: ?*SpillJournal = null;
+        if (config.overflow_policy == .spill) {
+            const path = if (config.spill_path) |prefix|
+                try std.fmt.allocPrintSentinel(allocator, "{s}.{d}", .{ prefix, index }, 0)
+            else
+                try std.fmt.allocPrintSentinel(allocator, "{s}.spill.{d}", .{ config.file_path.?, index }, 0);
+            journal = try SpillJournal.create(allocator, path, config.spill_capacity);
+        }
+
+        producer.* = .{
+            .ring = ring,
+            .parker = if (config.wait_strategy.usesFutex()) &self.parker else null,
+            .counters = .{},
+            .policy = config.overflow_policy,
+            .block_timeout_ns = if (config.block_timeout_ns != 0) config.block_timeout_ns else DEFAULT_BLOCK_TIMEOUT_NS,
+            .journal = journal,
+            .spilling = false,
+            .pending_spill = false,
+            .reserved = false,
+            .evicting = std.atomic.Value(bool).init(false),
+            .draining = std.atomic.Value(bool).init(false),
+            .ring_file = file,
+            .ring_region = region,
+        };
+        if (file) |f| f.seal();
+        if (recovered > 0) _ = self.records_recovered.fetchAdd(recovered, .monotonic);
+        return producer;
+    }
+
+    fn destroyProducer(allocator: Allocator, producer: *Producer) void {
+        if (producer.journal) |journal| journal.destroy(allocator);
+        if (producer.ring_file) |file| {
+            // The producer lives in the mapping; a drained ring leaves
+            // nothing to recover
+            file.close(allocator, producer.ring.isEmpty());
+            return;
+        }
+        if (producer.ring_region) |region| region.free() else producer.ring.deinit(allocator);
+        allocator.destroy(producer);
+    }
+
+    /// Create a private ring for the calling producer thread. Safe to call
+    /// from any thread while the sink is running; the returned handle lives
+    /// until `deinit()` and must be used by one thread at a time.
+    pub fn registerProducer(self: *LogSink) !*Producer {
+        const index = self.next_producer.fetchAdd(1, .acq_rel);
+        if (index >= MAX_PRODUCERS) {
+            _ = self.next_producer.fetchSub(1, .acq_rel);
+            return error.TooManyProducers;
+        }
+        if (self.producers[index].load(.acquire)) |recovered| return recovered;
+
+        // On failure the slot stays claimed but empty; the writer skips null slots.
+        const producer = try self.createProducer(self.allocator, self.config, index, try self.openRingFile(index, true));
+        self.producers[index].store(producer, .release);
+        _ = self.producer_count.fetchMax(index + 1, .acq_rel);
+        return producer;
+    }
+
     /// Called from the hot thread -- non-blocking.
-    /// Copies record data into a ring buffer slot and returns immediately.
+    /// Copies record data into the default producer's ring and returns immediately.
     pub fn log(self: *LogSink, record: []const u8) LogError!void {
-        if (record.len > MAX_RECORD_SIZE) return LogError.RecordTooLarge;
+        return self.default_producer.log(record);
+    }
 
-        var slot = Record{};
-        @memcpy(slot.data[0..record.len], record);
-        slot.len = @intCast(record.len);
+    /// See `Producer.logWait`; uses the default producer.
+    pub fn logWait(self: *LogSink, record: []const u8) LogError!void {
+        return self.default_producer.logWait(record);
+    }
 
-        if (!self.ring.tryPush(slot)) {
-            return LogError.BufferFull;
+    /// See `Producer.reserve`; uses the default producer.
+    pub fn reserve(self: *LogSink, len: usize) LogError![]u8 {
+        return self.default_producer.reserve(len);
+    }
+
+    /// See `Producer.commit`; uses the default producer.
+    pub fn commit(self: *LogSink) CommitError!void {
+        return self.default_producer.commit();
+    }
+
+    /// Queue rows already laid out column by column. The flush thread writes
+    /// them as row groups of up to `batch_size` rows straight from the
+    /// arrays, bypassing the rings and the transpose. Safe from any thread;
+    /// never blocks. BufferFull while MAX_PENDING_COLUMN_BATCHES batches are
+    /// queued. Not ordered against `log()`ed records, which reach the file
+    /// through the writer thread. On error the caller keeps the arrays and
+    /// `release` is not called. Partitioned sinks take records only and
+    /// refuse every batch with InvalidColumns.
+    pub fn logColumns(self: *LogSink, batch: ColumnBatch) ColumnError!void {
+        if (self.partitioner != null) return ColumnError.InvalidColumns;
+        try batch.validate(self.schema);
+        if (batch.num_rows == 0) {
+            if (batch.release) |release| release(batch.user_data);
+            return;
         }
+        if (self.pending_column_count.fetchAdd(1, .acq_rel) >= MAX_PENDING_COLUMN_BATCHES) {
+            _ = self.pending_column_count.fetchSub(1, .acq_rel);
+            return ColumnError.BufferFull;
+        }
+        errdefer _ = self.pending_column_count.fetchSub(1, .acq_rel);
+        const pending = try PendingColumns.create(self.allocator, batch);
+
+        var head = self.pending_columns.load(.monotonic);
+        while (true) {
+            pending.next = head;
+            head = self.pending_columns.cmpxchgWeak(head, pending, .release, .monotonic) orelse break;
+        }
+        self.full_batches.signal();
+    }
+
+    /// Finish the current file and continue in a new one, e.g. at session
+    /// close. Every record logged before the call lands in the old file.
+    /// Safe from any thread; no-op unless rotation is configured.
+    pub fn rotate(self: *LogSink) void {
+        if (self.config.file_path == null or !self.config.rotates()) return;
+        self.rotate_pending.store(true, .seq_cst);
+        self.parker.wake();
+    }
+
+    /// Largest record accepted by `log()`.
+    pub fn maxRecordLen(self: *const LogSink) u32 {
+        return self.default_producer.ring.maxRecordLen();
+    }
+
+    /// A drain pass's target batches (one per output) and the time spent
+    /// columnarizing into them.
+    const DrainContext = struct {
+        batches: []*BatchAccumulator,
+        partitioner: ?Partitioner,
+        columnarize_ns: u64 = 0,
+        /// Records drained from the rings that no batch accepted.
+        rejected: u32 = 0,
+    };
+
+    fn addRunToBatch(ctx: *DrainContext, run: ByteRing.Run) void {
+        const start_ns = monotonicNs();
+        defer ctx.columnarize_ns += monotonicNs() - start_ns;
+
+        const router = ctx.partitioner orelse return addRecords(ctx, ctx.batches[0], run, 0, run.count);
+        // Consecutive records of one partition still go in one call
+        var first: u32 = 0;
+        while (first < run.count) {
+            const k = router.of(run.record(first));
+            var n: u32 = 1;
+            while (first + n < run.count and router.of(run.record(first + n)) == k) n += 1;
+            addRecords(ctx, ctx.batches[k], run, first, n);
+            first += n;
+        }
+    }
+
+    /// Add records `first..first + n` of `run` to `batch_acc`, counting the
+    /// ones it rejects (too short for the schema, or out of memory).
+    fn addRecords(ctx: *DrainContext, batch_acc: *BatchAccumulator, run: ByteRing.Run, first: u32, n: u32) void {
+        const before = batch_acc.row_count;
+        defer ctx.rejected += n - (batch_acc.row_count - before);
+        if (batch_acc.fixed_width) {
+            batch_acc.addRecords(run.bytes[first * run.stride ..], run.len, run.stride, n) catch {};
+            return;
+        }
+        // Byte array tails vary per record; a bad record drops only itself
+        for (first..first + n) |i| {
+            batch_acc.addRecord(run.record(@intCast(i))) catch {};
+        }
+    }
+
+    /// Move records from every producer ring into the current batches,
+    /// round-robin, never past a full one: a pass takes at most the room
+    /// left in the fullest. The starting ring rotates on every call so a
+    /// small batch cannot starve the higher-numbered producers.
+    fn drainInto(self: *LogSink) u32 {
+        const num_producers = @min(self.producer_count.load(.acquire), MAX_PRODUCERS);
+        const start = self.drain_cursor % num_producers;
+        self.drain_cursor = start + 1;
+
+        const start_ns = monotonicNs();
+        var ctx = DrainContext{ .batches = self.current_batches, .partitioner = self.partitioner };
+        var count: u32 = 0;
+        for (0..num_producers) |i| {
+            const slot = &self.producers[(start + i) % num_producers];
+            const producer = slot.load(.acquire) orelse continue;
+            var room: u32 = DRAIN_CHUNK;
+            for (self.current_batches) |batch_acc| room = @min(room, batch_acc.max_rows -| batch_acc.row_count);
+            if (room == 0) break;
+            count += drainProducer(producer, room, &ctx);
+        }
+        if (count > 0) {
+            _ = self.records_written.fetchAdd(count - ctx.rejected, .monotonic);
+            if (ctx.rejected > 0) _ = self.records_rejected.fetchAdd(ctx.rejected, .monotonic);
+            const pass_ns = monotonicNs() - start_ns;
+            self.stage_times.record(.drain, pass_ns -| ctx.columnarize_ns);
+            self.stage_times.record(.columnarize, ctx.columnarize_ns);
+        }
+        return count;
+    }
+
+    /// Drain up to `max_count` records of one producer: its ring, then its
+    /// spill journal once the ring is empty.
+    fn drainProducer(producer: *Producer, max_count: u32, ctx: *DrainContext) u32 {
+        const ring = &producer.ring;
+        producer.counters.high_water.raise(ring.usedBytes());
+
+        var count: u32 = 0;
+        if (producer.policy == .drop_oldest) {
+            producer.draining.store(true, .seq_cst);
+            defer producer.draining.store(false, .release);
+            // The producer is evicting; its ring is no emptier for waiting
+            if (producer.evicting.load(.seq_cst)) return 0;
+            count = ring.drainRuns(max_count, ctx, addRunToBatch);
+        } else {
+            count = ring.drainRuns(max_count, ctx, addRunToBatch);
+        }
+
+        if (producer.journal) |journal| {
+            if (count < max_count and ring.isEmpty()) {
+                count += journal.ring.drainRuns(max_count - count, ctx, addRunToBatch);
+            }
+        }
+        return count;
     }
 
     /// Background writer thread function.
     fn writerThread(self: *LogSink) void {
-        var batch_acc = BatchAccumulator.init(
-            self.allocator,
-            self.schema,
-            self.config.batch_size,
-        ) catch return;
-        defer batch_acc.deinit();
-
-        var drain_buf: [256]Record = undefined;
+        self.writer_placement.apply();
+        for (self.current_batches, 0..) |*batch_acc, k| batch_acc.* = self.takeFreeBatch(@intCast(k));
+
         var last_flush_time = monotonicNs();
+        var idle_spins: u32 = 0;
 
         while (self.running.load(.acquire)) {
-            const count = self.ring.drainBatch(&drain_buf, 256);
+            if (self.rotate_pending.load(.acquire) and self.rotate_pending.swap(false, .acq_rel)) {
+                self.cutForRotation();
+                last_flush_time = monotonicNs();
+            }
 
-            if (count > 0) {
-                for (0..count) |i| {
-                    const rec = &drain_buf[i];
-                    batch_acc.addRecord(rec.data[0..rec.len]) catch continue;
-                }
-                _ = self.records_written.fetchAdd(count, .monotonic);
+            const count = self.drainInto();
 
-                if (batch_acc.isFull()) {
-                    self.flushBatch(&batch_acc);
-                    last_flush_time = monotonicNs();
-                }
+            if (count > 0) {
+                idle_spins = 0;
+                if (self.handOffFull() == 0) last_flush_time = monotonicNs();
             } else {
-                // Check flush timeout for partial batches
+                // Check flush timeout for partial batches; a partitioned
+                // sink flushes every output's at once
                 const now = monotonicNs();
                 const elapsed = now -% last_flush_time;
-                if (batch_acc.row_count > 0 and elapsed >= self.config.flush_timeout_ns) {
-                    self.flushBatch(&batch_acc);
+                var pending_rows = self.pendingRows();
+                if (pending_rows > 0 and elapsed >= self.config.flush_timeout_ns) {
+                    self.handOffPartial();
+                    pending_rows = 0;
                     last_flush_time = now;
                 }
 
-                // Nothing to drain -- yield briefly (50us)
-                nanosleep(50 * std.time.ns_per_us);
+                // Parked waits end no later than the partial batch's deadline
+                const timeout_ns = if (pending_rows > 0)
+                    self.config.flush_timeout_ns -| elapsed
+                else
+                    IDLE_PARK_NS;
+                self.idle(&idle_spins, timeout_ns);
             }
         }
 
         // Final drain on shutdown
         while (true) {
-            const count = self.ring.drainBatch(&drain_buf, 256);
-            if (count == 0) break;
-            for (0..count) |i| {
-                const rec = &drain_buf[i];
-                batch_acc.addRecord(rec.data[0..rec.len]) catch continue;
+            _ = self.handOffFull();
+            if (self.drainInto() == 0) break;
+        }
+
+        // Final flush; the flush thread writes the footers once the queue drains
+        for (self.current_batches) |batch_acc| {
+            if (batch_acc.row_count > 0) self.full_batches.push(batch_acc);
+        }
+        self.full_batches.close();
+    }
+
+    /// Queue a batch for the flush thread and return an empty one for the
+    /// same output, waiting while every accumulator is still being written.
+    fn handOff(self: *LogSink, batch_acc: *BatchAccumulator) *BatchAccumulator {
+        self.full_batches.push(batch_acc);
+        self.batches_handed_off += 1;
+        return self.takeFreeBatch(batch_acc.partition);
+    }
+
+    /// Hand off every full current batch. Returns the rows left in the
+    /// others.
+    fn handOffFull(self: *LogSink) u64 {
+        for (self.current_batches) |*batch_acc| {
+            if (batch_acc.*.isFull()) batch_acc.* = self.handOff(batch_acc.*);
+        }
+        return self.pendingRows();
+    }
+
+    /// Hand off every current batch holding rows.
+    fn handOffPartial(self: *LogSink) void {
+        for (self.current_batches) |*batch_acc| {
+            if (batch_acc.*.row_count > 0) batch_acc.* = self.handOff(batch_acc.*);
+        }
+    }
+
+    fn pendingRows(self: *const LogSink) u64 {
+        var rows: u64 = 0;
+        for (self.current_batches) |batch_acc| rows += batch_acc.row_count;
+        return rows;
+    }
+
+    /// Hand off everything in the rings, then tell the flush thread to
+    /// start new files once it has written those batches.
+    fn cutForRotation(self: *LogSink) void {
+        while (true) {
+            _ = self.handOffFull();
+            if (self.drainInto() == 0) break;
+        }
+        self.handOffPartial();
+        self.rotation_mark.store(self.batches_handed_off, .release);
+        self.full_batches.signal();
+    }
+
+    fn takeFreeBatch(self: *LogSink, partition: u32) *BatchAccumulator {
+        // The free queue is never closed
+        const batch_acc = self.free_batches.popWait().?;
+        batch_acc.partition = partition;
+        return batch_acc;
+    }
+
+    /// Background flush thread: writes handed-off batches as row groups and
+    /// returns them to the free queue, rotating files between batches (and
+    /// while idle, for interval rotation), then closes the file after the
+    /// writer thread's final batch.
+    fn flushThread(self: *LogSink) void {
+        self.flush_placement.apply();
+        while (true) {
+            const seq = self.full_batches.observe();
+            self.writePendingColumns();
+            const next = self.full_batches.popWaitForAfter(seq, self.rotationWaitNs()) catch {
+                self.maybeRotate(0, 0);
+                continue;
+            };
+            const batch_acc = next orelse break;
+            self.maybeRotate(batch_acc.partition, batch_acc.row_count);
+            self.flushBatch(batch_acc);
+            self.free_batches.push(batch_acc);
+            self.batches_taken += 1;
+            self.maybeRotate(0, 0);
+        }
+        self.writePendingColumns();
+        self.closeFiles();
+    }
+
+    /// How long the idle flush thread may sleep before an interval
+    /// rotation is due. `rotate()` wakes it sooner.
+    fn rotationWaitNs(self: *const LogSink) u64 {
+        if (self.config.rotate_interval_ns == 0) return IDLE_PARK_NS;
+        return std.math.clamp(self.next_rotation_ns -| realtimeNs(), std.time.ns_per_ms, IDLE_PARK_NS);
+    }
+
+    /// Start new files where a rotation is due, counting `incoming_rows`
+    /// about to be written to output `target`'s current one. A `rotate()`
+    /// or interval boundary rotates every output; row and byte limits each
+    /// output on its own. Empty files are never rotated out. Flush thread
+    /// only.
+    fn maybeRotate(self: *LogSink, target: u32, incoming_rows: u64) void {
+        if (self.config.file_path == null or !self.config.rotates()) return;
+        const config = self.config;
+
+        var all_due = false;
+        const mark = self.rotation_mark.load(.acquire);
+        if (mark != NO_ROTATION and self.batches_taken >= mark) {
+            _ = self.rotation_mark.cmpxchgStrong(mark, NO_ROTATION, .acq_rel, .monotonic);
+            all_due = true;
+        }
+        if (config.rotate_interval_ns > 0) {
+            const now = realtimeNs();
+            if (now >= self.next_rotation_ns) {
+                self.next_rotation_ns = nextBoundary(now, config.rotate_interval_ns);
+                all_due = true;
             }
-            _ = self.records_written.fetchAdd(count, .monotonic);
         }
+        for (self.outputs, 0..) |*out, k| {
+            const fw = &out.writer.?;
+            const incoming = if (k == target) incoming_rows else 0;
+            var due = all_due;
+            const rows: u64 = @intCast(fw.total_num_rows);
+            if (config.max_rows_per_file > 0 and rows + incoming > config.max_rows_per_file) due = true;
+            if (config.max_bytes_per_file > 0 and @as(u64, @intCast(fw.position())) >= config.max_bytes_per_file) due = true;
 
-        // Final flush
-        if (batch_acc.row_count > 0) {
-            self.flushBatch(&batch_acc);
+            if (due and rows > 0) {
+                self.rotateFile(out) catch {
+                    // The current file stays open; the next check retries
+                    _ = self.write_errors.fetchAdd(1, .monotonic);
+                };
+            }
         }
     }
 
+    /// Open `out`'s next file, then hand its current one to the finalizer.
+    fn rotateFile(self: *LogSink, out: *Output) !void {
+        const allocator = self.allocator;
+        // Allocated first: once the next file exists, nothing may fail
+        // before it is `out`'s, or its empty `.inprogress` would be orphaned
+        const sealed = try allocator.create(SealedFile);
+        errdefer allocator.destroy(sealed);
+        const next_paths = try FilePaths.init(allocator, out.path.?, out.seq + 1);
+        errdefer next_paths.deinit(allocator);
+        var next = try openWriter(allocator, self.config, self.parquet_columns, next_paths.inprogress, self.encoder_pool);
+
+        // The sealed file only has its footer left to write, which does not
+        // compress; keep the warm codec contexts and row group buffers for
+        // the new one
+        const current = &out.writer.?;
+        std.mem.swap(Compressor, &next.compressor, &current.compressor);
+        std.mem.swap(?parquet.RowGroupWriter, &next.row_group, &current.row_group);
+        sealed.* = .{ .writer = current.*, .paths = out.paths.? };
+        out.writer = next;
+        out.paths = next_paths;
+        out.seq += 1;
+
+        self.sealFile(sealed);
+    }
+
+    /// Queue `sealed` for the finalizer, waiting for room while it still
+    /// works through MAX_SEALED_FILES older files.
+    fn sealFile(self: *LogSink, sealed: *SealedFile) void {
+        self.sealed_files.pushWait(sealed);
+    }
+
+    /// Finalizer thread: completes sealed files in rotation order.
+    fn finalizerThread(self: *LogSink) void {
+        self.flush_placement.apply();
+        while (self.sealed_files.popWait()) |sealed| self.finalize(sealed);
+    }
+
+    /// Write a sealed file's page index and footer, fsync it and rename it
+    /// to its final name. Failures are counted in `write_errors` and leave
+    /// the `.inprogress` file behind.
+    fn finalize(self: *LogSink, sealed: *SealedFile) void {
+        defer {
+            sealed.writer.deinit();
+            sealed.paths.deinit(self.allocator);
+            self.allocator.destroy(sealed);
+        }
+        _ = sealed.writer.close() catch {
+            _ = self.write_errors.fetchAdd(1, .monotonic);
+            return;
+        };
+        if (linux.errno(linux.rename(sealed.paths.inprogress, sealed.paths.final)) != .SUCCESS) {
+            _ = self.write_errors.fetchAdd(1, .monotonic);
+            return;
+        }
+        _ = self.files_finalized.fetchAdd(1, .monotonic);
+    }
+
+    /// Wait for records according to `config.wait_strategy`. Parked waits
+    /// last at most `timeout_ns`.
+    fn idle(self: *LogSink, idle_spins: *u32, timeout_ns: u64) void {
+        switch (self.config.wait_strategy) {
+            .sleep => nanosleep(50 * std.time.ns_per_us),
+            .spin => std.atomic.spinLoopHint(),
+            .spin_then_futex => {
+                if (idle_spins.* < wait.SPIN_LIMIT) {
+                    idle_spins.* += 1;
+                    std.atomic.spinLoopHint();
+                } else {
+                    self.parker.park(timeout_ns, self, hasWork);
+                }
+            },
+            .futex => self.parker.park(timeout_ns, self, hasWork),
+        }
+    }
+
+    /// Whether any ring holds records, or shutdown or a rotation was
+    /// requested; seq_cst loads pair with `Producer.commit()` and `rotate()`
+    /// under futex strategies.
+    fn hasWork(self: *LogSink) bool {
+        if (!self.running.load(.seq_cst)) return true;
+        if (self.rotate_pending.load(.seq_cst)) return true;
+        const num_producers = @min(self.producer_count.load(.acquire), MAX_PRODUCERS);
+        for (self.producers[0..num_producers]) |*slot| {
+            const producer = slot.load(.acquire) orelse continue;
+            if (!producer.ring.isEmptySeqCst()) return true;
+            if (producer.journal) |journal| {
+                if (!journal.ring.isEmptySeqCst()) return true;
+            }
+        }
+        return false;
+    }
+
+    /// Write the accumulated batch as one row group of its output's file
+    /// and reset it. A failed write drops the batch and is counted in
+    /// `write_errors`.
     fn flushBatch(self: *LogSink, batch_acc: *BatchAccumulator) void {
-        // TODO: integrate with Parquet writer to write a row group
-        // For now, just track stats and reset.
+        defer batch_acc.reset();
+
+        if (self.outputs[batch_acc.partition].writer) |*fw| {
+            const start_pos = fw.position();
+            writeRowGroup(fw, batch_acc) catch {
+                _ = self.write_errors.fetchAdd(1, .monotonic);
+                return;
+            };
+            self.recordRowGroup(fw, start_pos);
+        }
         _ = self.batches_flushed.fetchAdd(1, .monotonic);
-        batch_acc.reset();
+    }
+
+    /// Stage times and byte counts of the row group just closed, which
+    /// started at file offset `start_pos`.
+    fn recordRowGroup(self: *LogSink, fw: *const FileWriter, start_pos: i64) void {
+        const rg = fw.last_row_group;
+        self.stage_times.record(.encode, rg.encode_ns);
+        self.stage_times.record(.compress, rg.compress_ns);
+        self.stage_times.record(.write, rg.write_ns);
+        self.bytes_uncompressed.add(rg.uncompressed_bytes);
+        self.bytes_compressed.add(rg.compressed_bytes);
+        self.bytes_written.add(@intCast(fw.position() - start_pos));
+    }
+
+    /// Write every queued `logColumns()` batch, oldest first, and hand its
+    /// arrays back. Flush thread only.
+    fn writePendingColumns(self: *LogSink) void {
+        var newest = self.pending_columns.swap(null, .acquire);
+        var oldest: ?*PendingColumns = null;
+        while (newest) |node| {
+            newest = node.next;
+            node.next = oldest;
+            oldest = node;
+        }
+        while (oldest) |node| {
+            oldest = node.next;
+            self.writeColumnBatch(&node.batch);
+            node.destroy(self.allocator);
+            _ = self.pending_column_count.fetchSub(1, .release);
+        }
+    }
+
+    /// Write `batch` as row groups of up to `batch_size` rows. A failed
+    /// write drops that row group and is counted in `write_errors`.
+    fn writeColumnBatch(self: *LogSink, batch: *const ColumnBatch) void {
+        const rows_per_group = @max(self.config.batch_size, 1);
+        var start: u32 = 0;
+        while (start < batch.num_rows) : (start = @min(batch.num_rows, start +| rows_per_group)) {
+            const end = @min(batch.num_rows, start +| rows_per_group);
+            self.maybeRotate(0, end - start);
+            if (self.outputs[0].writer) |*fw| {
+                const start_pos = fw.position();
+                writeColumnRowGroup(fw, self.schema, batch, start, end) catch {
+                    _ = self.write_errors.fetchAdd(1, .monotonic);
+                    continue;
+                };
+                self.recordRowGroup(fw, start_pos);
+            }
+            _ = self.batches_flushed.fetchAdd(1, .monotonic);
+            self.column_rows_written.add(end - start);
+        }
+    }
+
+    fn writeColumnRowGroup(fw: *FileWriter, schema: SchemaInfo, batch: *const ColumnBatch, start: u32, end: u32) !void {
+        const rg = try fw.rowGroup();
+        for (schema.columns, batch.columns, 0..) |col, data, i| {
+            try column_batch.writeColumnRange(col, data, start, end, rg.column(i));
+        }
+        rg.setNumRows(end - start);
+        try fw.closeRowGroup(rg);
+    }
+
+    fn writeRowGroup(fw: *FileWriter, batch_acc: *const BatchAccumulator) !void {
+        const rg = try fw.rowGroup();
+        for (0..batch_acc.schema.columns.len) |i| {
+            try batch_acc.writeColumnTo(i, rg.column(i));
+        }
+        rg.setNumRows(batch_acc.row_count);
+        try fw.closeRowGroup(rg);
+    }
+
+    /// Write the footers and close the output files. A rotating sink's
+    /// last files go through the finalizer like the others.
+    fn closeFiles(self: *LogSink) void {
+        defer self.sealed_files.close();
+        for (self.outputs) |*out| self.closeFile(out);
+    }
+
+    fn closeFile(self: *LogSink, out: *Output) void {
+        const fw = if (out.writer) |*w| w else return;
+        if (out.paths) |paths| {
+            const sealed = self.allocator.create(SealedFile) catch {
+                _ = self.write_errors.fetchAdd(1, .monotonic);
+                return;
+            };
+            sealed.* = .{ .writer = fw.*, .paths = paths };
+            out.writer = null;
+            out.paths = null;
+            self.sealFile(sealed);
+            return;
+        }
+        _ = fw.close() catch {
+            _ = self.write_errors.fetchAdd(1, .monotonic);
+            return;
+        };
+    }
+
+    /// Counters and stage timings so far. Lock-free and safe from any
+    /// thread; reads only memory the sink's threads publish with relaxed
+    /// stores, so calling it never slows producers down.
+    pub fn stats(self: *LogSink) SinkStats {
+        var out = SinkStats{
+            .records_written = self.records_written.load(.monotonic),
+            .records_rejected = self.records_rejected.load(.monotonic),
+            .batches_flushed = self.batches_flushed.load(.monotonic),
+            .write_errors = self.write_errors.load(.monotonic),
+            .files_finalized = self.files_finalized.load(.monotonic),
+            .bytes_uncompressed = self.bytes_uncompressed.get(),
+            .bytes_compressed = self.bytes_compressed.get(),
+            .bytes_written = self.bytes_written.get(),
+            .ring_capacity = self.config.ring_capacity,
+            .records_recovered = self.records_recovered.load(.monotonic),
+            .rings_discarded = self.rings_discarded.load(.monotonic),
+            .column_rows_written = self.column_rows_written.get(),
+        };
+        const num_producers = @min(self.producer_count.load(.acquire), MAX_PRODUCERS);
+        for (self.producers[0..num_producers]) |*slot| {
+            const producer = slot.load(.acquire) orelse continue;
+            const counters = &producer.counters;
+            out.num_producers += 1;
+            out.records_logged += counters.logged.get();
+            out.bytes_logged += counters.logged_bytes.get();
+            out.records_dropped_full += counters.dropped_full.get();
+            out.records_dropped_too_large += counters.dropped_too_large.get();
+            out.records_dropped_oldest += counters.dropped_oldest.get();
+            out.records_spilled += counters.spilled.get();
+            if (producer.journal) |journal| out.spill_used_bytes += journal.ring.usedBytes();
+            out.ring_used_bytes = @max(out.ring_used_bytes, producer.ring.usedBytes());
+            out.ring_high_water_bytes = @max(out.ring_high_water_bytes, counters.high_water.get());
+        }
+        for (&out.stages, 0..) |*stage, i| stage.* = self.stage_times.summary(@enumFromInt(i));
+        return out;
     }
 
     /// Force flush pending data (signals writer thread, waits for completion).
@@ -174,30 +1674,61 @@ pub const LogSink = struct {
         _ = self;
     }
 
-    /// Graceful shutdown: stop the writer thread and flush remaining data.
+    /// Graceful shutdown: stop both threads and flush remaining data.
     pub fn deinit(self: *LogSink) void {
-        self.running.store(false, .release);
+        self.running.store(false, .seq_cst);
+        self.parker.wake();
         if (self.writer_thread) |t| {
             t.join();
         }
+        if (self.flush_thread) |t| {
+            t.join();
+        }
+        if (self.finalizer_thread) |t| {
+            t.join();
+        }
         const allocator = self.allocator;
-        allocator.destroy(self.ring);
+        // Batches queued after the flush thread's last pass
+        var pending = self.pending_columns.swap(null, .acquire);
+        while (pending) |node| {
+            pending = node.next;
+            node.destroy(allocator);
+        }
+        for (self.batch_buffers) |*b| b.deinit();
+        allocator.free(self.batch_buffers);
+        for (self.outputs) |*out| out.deinit(allocator, self.partitioner != null);
+        allocator.free(self.outputs);
+        allocator.free(self.current_batches);
+        if (self.encoder_pool) |pool| pool.deinit();
+        allocator.free(self.parquet_columns);
+        allocator.destroy(self.stage_times);
+        for (&self.producers) |*slot| {
+            if (slot.load(.acquire)) |producer| destroyProducer(allocator, producer);
+        }
         allocator.destroy(self);
     }
 };
 
-test "LogSink basic log and shutdown" {
-    const allocator = std.testing.allocator;
+const tmpPath = @import("../testing.zig").tmpPath;
 
-    const columns = [_]batch_mod.ColumnDef{
-        .{ .name = "val", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 0, .size = 4 },
-    };
-    const schema = SchemaInfo{
-        .columns = &columns,
+const test_columns = [_]batch_mod.ColumnDef{
+    .{ .name = "val", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 0, .size = 4 },
+};
+
+/// One required INT32 column, "val": the records of most tests below.
+fn testSchema() SchemaInfo {
+    return .{
+        .columns = &test_columns,
         .record_size = 4,
         .nullable_count = 0,
         .null_bitmap_bytes = 0,
     };
+}
+
+test "LogSink basic log and shutdown" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
 
     const sink = try LogSink.init(.{}, schema, allocator);
 
@@ -213,3 +1744,468 @@ test "LogSink basic log and shutdown" {
     // Shutdown
     sink.deinit();
 }
+
+test "LogSink drains every registered producer" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{ .batch_size = 64, .ring_capacity = 1 << 12 }, schema, allocator);
+    defer sink.deinit();
+
+    const per_thread = 5000;
+    const Worker = struct {
+        fn run(producer: *Producer) void {
+            var rec: [4]u8 = undefined;
+            for (0..per_thread) |i| {
+                std.mem.writeInt(i32, &rec, @intCast(i), .little);
+                while (true) {
+                    producer.log(&rec) catch {
+                        std.atomic.spinLoopHint();
+                        continue;
+                    };
+                    break;
+                }
+            }
+        }
+    };
+
+    var threads: [4]std.Thread = undefined;
+    for (&threads) |*t| {
+        t.* = try std.Thread.spawn(.{}, Worker.run, .{try sink.registerProducer()});
+    }
+    for (threads) |t| t.join();
+
+    // Wait (bounded) for the writer thread to drain all rings
+    var waited_ms: u32 = 0;
+    while (sink.records_written.load(.monotonic) < threads.len * per_thread and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+    try std.testing.expectEqual(@as(u64, threads.len * per_thread), sink.records_written.load(.monotonic));
+}
+
+test "LogSink futex wait strategy wakes on commit" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{ .wait_strategy = .futex }, schema, allocator);
+    defer sink.deinit();
+
+    // Let the writer park, then log; it must wake well before the 1s idle bound
+    nanosleep(5 * std.time.ns_per_ms);
+    const rec = [_]u8{ 1, 0, 0, 0 };
+    try sink.log(&rec);
+
+    var waited_ms: u32 = 0;
+    while (sink.records_written.load(.monotonic) == 0 and waited_ms < 500) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+    try std.testing.expectEqual(@as(u64, 1), sink.records_written.load(.monotonic));
+}
+
+test "LogSink commit needs a pending reservation" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{ .ring_capacity = 1 << 12 }, schema, allocator);
+    defer sink.deinit();
+    try std.testing.expectError(CommitError.NoReservation, sink.commit());
+
+    // A second commit of the same record publishes and counts nothing
+    std.mem.writeInt(i32, (try sink.reserve(4))[0..4], 1, .little);
+    try sink.commit();
+    try std.testing.expectError(CommitError.NoReservation, sink.commit());
+
+    // Neither does a commit after a failed reserve, even with an abandoned
+    // reservation before it
+    _ = try sink.reserve(4);
+    try std.testing.expectError(LogError.RecordTooLarge, sink.reserve(1 << 12));
+    try std.testing.expectError(CommitError.NoReservation, sink.commit());
+
+    var waited_ms: u32 = 0;
+    while (sink.records_written.load(.monotonic) < 1 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+    nanosleep(10 * std.time.ns_per_ms);
+    const s = sink.stats();
+    try std.testing.expectEqual(@as(u64, 1), s.records_logged);
+    try std.testing.expectEqual(@as(u64, 4), s.bytes_logged);
+    try std.testing.expectEqual(@as(u64, 1), s.records_written);
+}
+
+test "LogSink cycles batch buffers through the flush thread" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{ .batch_size = 16, .num_batch_buffers = 3 }, schema, allocator);
+    defer sink.deinit();
+    try std.testing.expectEqual(@as(usize, 3), sink.batch_buffers.len);
+
+    // Far more batches than buffers, so every accumulator is reused
+    const total = 1000;
+    var rec: [4]u8 = undefined;
+    for (0..total) |i| {
+        std.mem.writeInt(i32, &rec, @intCast(i), .little);
+        while (true) {
+            sink.log(&rec) catch {
+                std.atomic.spinLoopHint();
+                continue;
+            };
+            break;
+        }
+    }
+
+    var waited_ms: u32 = 0;
+    while (sink.batches_flushed.load(.monotonic) < total / 16 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+    try std.testing.expectEqual(@as(u64, total), sink.records_written.load(.monotonic));
+    try std.testing.expect(sink.batches_flushed.load(.monotonic) >= total / 16);
+}
+
+test "LogSink stats count drops, bytes and stage timings" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try tmpPath(allocator, &tmp, "stats.parquet");
+    defer allocator.free(path);
+    const sink = try LogSink.init(.{ .batch_size = 64, .ring_capacity = 1 << 12, .file_path = path }, schema, allocator);
+    defer sink.deinit();
+
+    const total = 1000;
+    var retries: u64 = 0;
+    var rec: [4]u8 = undefined;
+    for (0..total) |i| {
+        std.mem.writeInt(i32, &rec, @intCast(i), .little);
+        while (true) {
+            sink.log(&rec) catch {
+                retries += 1;
+                std.atomic.spinLoopHint();
+                continue;
+            };
+            break;
+        }
+    }
+    var big: [1 << 12]u8 = undefined;
+    try std.testing.expectError(LogError.RecordTooLarge, sink.log(&big));
+
+    var waited_ms: u32 = 0;
+    while (sink.batches_flushed.load(.monotonic) < total / 64 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+
+    const s = sink.stats();
+    try std.testing.expectEqual(@as(u64, total), s.records_logged);
+    try std.testing.expectEqual(@as(u64, total * 4), s.bytes_logged);
+    try std.testing.expectEqual(retries, s.records_dropped_full);
+    try std.testing.expectEqual(@as(u64, 1), s.records_dropped_too_large);
+    try std.testing.expectEqual(@as(u64, total), s.records_written);
+    try std.testing.expectEqual(@as(u32, 1), s.num_producers);
+    try std.testing.expect(s.ring_high_water_bytes > 0 and s.ring_high_water_bytes <= 1 << 12);
+    try std.testing.expect(s.bytes_written >= s.bytes_compressed and s.bytes_compressed > 0);
+    try std.testing.expect(s.stages[@intFromEnum(Stage.drain)].count > 0);
+    try std.testing.expectEqual(s.batches_flushed, s.stages[@intFromEnum(Stage.write)].count);
+}
+
+test "LogSink overflow policies account for every record" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try tmpPath(allocator, &tmp, "overflow.parquet");
+    defer allocator.free(path);
+    const spill_path = try tmpPath(allocator, &tmp, "overflow.spill");
+    defer allocator.free(spill_path);
+    for ([_]OverflowPolicy{ .drop_oldest, .spill }) |policy| {
+        const sink = try LogSink.init(.{
+            .batch_size = 64,
+            .ring_capacity = 1 << 12,
+            .file_path = path,
+            .overflow_policy = policy,
+            .spill_path = spill_path,
+            .spill_capacity = 1 << 16,
+        }, schema, allocator);
+        defer sink.deinit();
+
+        // Never retried: a full ring evicts or spills instead of refusing
+        const total = 2000;
+        var rec: [4]u8 = undefined;
+        for (0..total) |i| {
+            std.mem.writeInt(i32, &rec, @intCast(i), .little);
+            sink.log(&rec) catch {};
+        }
+
+        var s = sink.stats();
+        var waited_ms: u32 = 0;
+        while (s.records_written + s.records_dropped_oldest < s.records_logged and waited_ms < 5000) : (waited_ms += 1) {
+            nanosleep(std.time.ns_per_ms);
+            s = sink.stats();
+        }
+        try std.testing.expectEqual(@as(u64, total), s.records_logged + s.records_dropped_full);
+        try std.testing.expectEqual(s.records_logged, s.records_written + s.records_dropped_oldest);
+        if (policy == .spill) {
+            try std.testing.expectEqual(@as(u64, 0), s.records_dropped_full);
+            try std.testing.expectEqual(@as(u64, 0), s.spill_used_bytes);
+        }
+    }
+}
+
+test "LogSink logWait drops and counts nothing under drop_oldest" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{
+        .batch_size = 64,
+        .ring_capacity = 1 << 12,
+        .overflow_policy = .drop_oldest,
+    }, schema, allocator);
+    defer sink.deinit();
+
+    // Far more than the ring holds, logged without pause
+    const total = 5000;
+    var rec: [4]u8 = undefined;
+    for (0..total) |i| {
+        std.mem.writeInt(i32, &rec, @intCast(i), .little);
+        try sink.logWait(&rec);
+    }
+
+    var waited_ms: u32 = 0;
+    while (sink.records_written.load(.monotonic) < total and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+    }
+    const s = sink.stats();
+    try std.testing.expectEqual(@as(u64, total), s.records_logged);
+    try std.testing.expectEqual(@as(u64, total), s.records_written);
+    try std.testing.expectEqual(@as(u64, 0), s.records_dropped_full);
+    try std.testing.expectEqual(@as(u64, 0), s.records_dropped_oldest);
+}
+
+test "LogSink drains the rings a crashed run left in ring files" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try tmpPath(allocator, &tmp, "recover.parquet");
+    defer allocator.free(path);
+    const ring_path = try tmpPath(allocator, &tmp, "recover.ring");
+    defer allocator.free(ring_path);
+
+    // What a crash leaves behind: producers 0 and 1 with committed records
+    for ([_]u32{ 10, 3 }, 0..) |count, index| {
+        const file_path = try std.fmt.allocPrintSentinel(allocator, "{s}.{d}", .{ ring_path, index }, 0);
+        const file = (try RingFile.open(allocator, file_path, 1 << 12, schemaHash(schema), PRODUCER_LAYOUT_HASH, true)).?;
+        const crashed = file.state(Producer);
+        crashed.ring = try ByteRing.initBuffer(file.data());
+        var left: [4]u8 = undefined;
+        for (0..count) |i| {
+            std.mem.writeInt(i32, &left, @intCast(i), .little);
+            try std.testing.expect(crashed.ring.tryPush(&left));
+        }
+        file.seal();
+        file.close(allocator, false);
+    }
+
+    const sink = try LogSink.init(.{ .batch_size = 64, .ring_capacity = 1 << 12, .file_path = path, .ring_path = ring_path }, schema, allocator);
+    var s = sink.stats();
+    try std.testing.expectEqual(@as(u64, 13), s.records_recovered);
+    try std.testing.expectEqual(@as(u32, 2), s.num_producers);
+    // The first producer registered continues in the recovered ring 1
+    const producer = try sink.registerProducer();
+    try std.testing.expect(producer == sink.producers[1].load(.acquire).?);
+
+    var rec: [4]u8 = undefined;
+    std.mem.writeInt(i32, &rec, 99, .little);
+    try producer.log(&rec);
+    var waited_ms: u32 = 0;
+    while (s.records_written < 14 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+        s = sink.stats();
+    }
+    try std.testing.expectEqual(@as(u64, 14), s.records_written);
+    sink.deinit();
+
+    // Drained rings are deleted on shutdown
+    for (0..2) |index| {
+        const file_path = try std.fmt.allocPrintSentinel(allocator, "{s}.{d}", .{ ring_path, index }, 0);
+        try std.testing.expect((try RingFile.open(allocator, file_path, 1 << 12, 0, 0, false)) == null);
+    }
+}
+
+test "LogSink counts records the batch rejects instead of writing them" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    const sink = try LogSink.init(.{ .batch_size = 16 }, schema, allocator);
+    defer sink.deinit();
+
+    // Two records too short for the schema between three valid ones
+    const rec = [_]u8{ 1, 0, 0, 0 };
+    for (0..5) |i| try sink.log(if (i % 2 == 1) rec[0..2] else &rec);
+
+    var s = sink.stats();
+    var waited_ms: u32 = 0;
+    while (s.records_written + s.records_rejected < 5 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+        s = sink.stats();
+    }
+    try std.testing.expectEqual(@as(u64, 3), s.records_written);
+    try std.testing.expectEqual(@as(u64, 2), s.records_rejected);
+}
+
+test "LogSink starts a ring file with a corrupt frame header empty" {
+    const allocator = std.testing.allocator;
+
+    const schema = testSchema();
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try tmpPath(allocator, &tmp, "torn.parquet");
+    defer allocator.free(path);
+    const ring_path = try tmpPath(allocator, &tmp, "torn.ring");
+    defer allocator.free(ring_path);
+
+    // Five committed records, the third with a torn length header
+    {
+        const file_path = try std.fmt.allocPrintSentinel(allocator, "{s}.0", .{ring_path}, 0);
+        const file = (try RingFile.open(allocator, file_path, 1 << 12, schemaHash(schema), PRODUCER_LAYOUT_HASH, true)).?;
+        const crashed = file.state(Producer);
+        crashed.ring = try ByteRing.initBuffer(file.data());
+        var left: [4]u8 = undefined;
+        for (0..5) |i| {
+            std.mem.writeInt(i32, &left, @intCast(i), .little);
+            try std.testing.expect(crashed.ring.tryPush(&left));
+        }
+        std.mem.writeInt(u32, file.data()[2 * ByteRing.frameSize(4) ..][0..4], 0x7fff_fff0, .little);
+        file.seal();
+        file.close(allocator, false);
+    }
+
+    const sink = try LogSink.init(.{ .batch_size = 64, .ring_capacity = 1 << 12, .file_path = path, .ring_path = ring_path }, schema, allocator);
+    var s = sink.stats();
+    try std.testing.expectEqual(@as(u64, 0), s.records_recovered);
+    try std.testing.expectEqual(@as(u64, 1), s.rings_discarded);
+
+    // The ring is usable again from empty
+    var rec: [4]u8 = undefined;
+    std.mem.writeInt(i32, &rec, 7, .little);
+    try sink.log(&rec);
+    var waited_ms: u32 = 0;
+    while (s.records_written < 1 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+        s = sink.stats();
+    }
+    try std.testing.expectEqual(@as(u64, 1), s.records_written);
+    sink.deinit();
+}
+
+test "Partitioner routes records by key value or hash" {
+    const columns = [_]batch_mod.ColumnDef{
+        .{ .name = "venue", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 0, .size = 4 },
+        .{ .name = "sym", .physical_type = .FIXED_LEN_BYTE_ARRAY, .type_length = 4, .nullable = false, .offset = 4, .size = 4 },
+        .{ .name = "px", .physical_type = .DOUBLE, .type_length = 0, .nullable = true, .offset = 8, .size = 8 },
+    };
+    const schema = SchemaInfo{ .columns = &columns, .record_size = 17, .nullable_count = 1, .null_bitmap_bytes = 1 };
+
+    try std.testing.expect((try Partitioner.init(.{}, schema)) == null);
+    const by_venue = (try Partitioner.init(.{ .partition_column = "venue", .num_partitions = 4 }, schema)).?;
+    var rec = [_]u8{0} ** 17;
+    std.mem.writeInt(i32, rec[0..4], 6, .little);
+    try std.testing.expectEqual(@as(u32, 2), by_venue.of(&rec));
+    std.mem.writeInt(i32, rec[0..4], -1, .little);
+    try std.testing.expectEqual(@as(u32, 3), by_venue.of(&rec));
+    try std.testing.expectEqual(@as(u32, 0), by_venue.of(rec[0..2]));
+
+    // Keys past the count and negative keys share buckets, so the
+    // directory names the bucket rather than a venue
+    const allocator = std.testing.allocator;
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const file_path = try tmpPath(allocator, &tmp, "orders.parquet");
+    defer allocator.free(file_path);
+    const expected = try tmpPath(allocator, &tmp, "venue_bucket=3/orders.parquet");
+    defer allocator.free(expected);
+    const path = try by_venue.outputPath(allocator, file_path, by_venue.of(&rec));
+    defer allocator.free(path);
+    try std.testing.expectEqualStrings(expected, path);
+
+    // Same symbol, same bucket
+    const by_sym = (try Partitioner.init(.{ .partition_column = "sym", .num_partitions = 8, .partition_hash = true }, schema)).?;
+    @memcpy(rec[4..8], "AAPL");
+    const k = by_sym.of(&rec);
+    try std.testing.expect(k < 8);
+    std.mem.writeInt(i32, rec[0..4], 1, .little);
+    try std.testing.expectEqual(k, by_sym.of(&rec));
+
+    try std.testing.expectError(error.InvalidPartitionColumn, Partitioner.init(.{ .partition_column = "sym", .num_partitions = 2 }, schema));
+    try std.testing.expectError(error.InvalidPartitionColumn, Partitioner.init(.{ .partition_column = "px", .num_partitions = 2, .partition_hash = true }, schema));
+    try std.testing.expectError(error.InvalidPartitionColumn, Partitioner.init(.{ .partition_column = "nope", .num_partitions = 2 }, schema));
+    try std.testing.expectError(error.InvalidPartitions, Partitioner.init(.{ .partition_column = "venue", .num_partitions = MAX_PARTITIONS + 1 }, schema));
+}
+
+test "LogSink writes columnar batches as row groups and releases them" {
+    const allocator = std.testing.allocator;
+
+    const columns = [_]batch_mod.ColumnDef{
+        .{ .name = "px", .physical_type = .INT64, .type_length = 0, .nullable = true, .offset = 0, .size = 8 },
+        .{ .name = "sym", .physical_type = .BYTE_ARRAY, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    };
+    const schema = SchemaInfo{
+        .columns = &columns,
+        .record_size = 12,
+        .nullable_count = 1,
+        .null_bitmap_bytes = 1,
+    };
+
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try tmpPath(allocator, &tmp, "columns.parquet");
+    defer allocator.free(path);
+    const sink = try LogSink.init(.{ .batch_size = 4, .file_path = path }, schema, allocator);
+
+    const Released = struct {
+        count: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+
+        fn release(user_data: ?*anyopaque) callconv(.c) void {
+            const self: *@This() = @ptrCast(@alignCast(user_data.?));
+            _ = self.count.fetchAdd(1, .release);
+        }
+    };
+    var released = Released{};
+
+    const px = [_]i64{ 1, 0, 3, 4, 5, 6 };
+    const validity = [_]u8{0b111101};
+    const offsets = [_]i32{ 0, 1, 2, 3, 4, 5, 6 };
+    const data = [_]ColumnData{
+        .{ .values = std.mem.sliceAsBytes(&px), .validity = &validity },
+        .{ .values = "abcdef", .offsets = &offsets },
+    };
+    // Read in place until released, then copied
+    try sink.logColumns(.{ .columns = &data, .num_rows = 6, .release = Released.release, .user_data = &released });
+    try sink.logColumns(.{ .columns = &data, .num_rows = 6 });
+    try std.testing.expectError(ColumnError.InvalidColumns, sink.logColumns(.{ .columns = data[0..1], .num_rows = 6 }));
+
+    var s = sink.stats();
+    var waited_ms: u32 = 0;
+    while (s.column_rows_written < 12 and waited_ms < 5000) : (waited_ms += 1) {
+        nanosleep(std.time.ns_per_ms);
+        s = sink.stats();
+    }
+    try std.testing.expectEqual(@as(u64, 12), s.column_rows_written);
+    // Six rows in groups of four: two row groups per batch
+    try std.testing.expectEqual(@as(u64, 4), s.batches_flushed);
+    try std.testing.expectEqual(@as(u64, 0), s.write_errors);
+    try std.testing.expectEqual(@as(u32, 1), released.count.load(.acquire));
+    sink.deinit();
+}
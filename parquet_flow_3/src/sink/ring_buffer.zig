@@ -51,25 +51,50 @@ pub fn RingBuffer(comptime T: type, comptime capacity: u32) type {
             return item;
         }
 
-        /// Batch drain -- reads up to max_count items into output slice.
-        /// Returns number of items actually read.
-        pub fn drainBatch(self: *Self, output: []T, max_count: u32) u32 {
-            var r = self.read_head.load(.monotonic);
+        /// Readable items as at most two contiguous runs of ring memory:
+        /// `first` starts at the read head, `second` continues from index 0
+        /// after a wrap.
+        pub const Span = struct {
+            first: []const T,
+            second: []const T,
+
+            pub fn len(self: Span) u32 {
+                return @intCast(self.first.len + self.second.len);
+            }
+        };
+
+        /// Consumer side -- exposes up to `max_count` readable items in place
+        /// with a single acquire load. Nothing is consumed until `release()`.
+        pub fn peekContiguous(self: *Self, max_count: u32) Span {
+            const r = self.read_head.load(.monotonic);
             const w = self.write_head.load(.acquire);
 
-            var count: u32 = 0;
-            const limit = @min(max_count, @as(u32, @intCast(output.len)));
+            const available = (w -% r) & mask;
+            const n = @min(available, max_count);
+            const first_len = @min(n, capacity - r);
+            return .{
+                .first = self.buffer[r..][0..first_len],
+                .second = self.buffer[0 .. n - first_len],
+            };
+        }
 
-            while (count < limit and r != w) {
-                output[count] = self.buffer[r];
-                r = (r +% 1) & mask;
-                count += 1;
-            }
+        /// Consumer side -- frees the first `count` items returned by
+        /// `peekContiguous()`.
+        pub fn release(self: *Self, count: u32) void {
+            const r = self.read_head.load(.monotonic);
+            self.read_head.store((r +% count) & mask, .release);
+        }
 
-            if (count > 0) {
-                self.read_head.store(r, .release);
-            }
+        /// Batch drain -- reads up to max_count items into output slice.
+        /// Returns number of items actually read.
+        pub fn drainBatch(self: *Self, output: []T, max_count: u32) u32 {
+            const span = self.peekContiguous(@min(max_count, @as(u32, @intCast(output.len))));
+            const count = span.len();
+            if (count == 0) return 0;
 
+            @memcpy(output[0..span.first.len], span.first);
+            @memcpy(output[span.first.len..][0..span.second.len], span.second);
+            self.release(count);
             return count;
         }
 
@@ -89,6 +114,375 @@ pub fn RingBuffer(comptime T: type, comptime capacity: u32) type {
     };
 }
 
+/// Lock-free single-producer single-consumer ring of variable-length byte
+/// records. Each record is stored contiguously behind an 8-byte header (u32
+/// length + 4 reserved bytes, keeping payloads 8-byte aligned so reserved
+/// memory can be cast to a record struct) and padded to `RECORD_ALIGN`, so memory use and cache lines touched per
+/// push scale with the record, not with a worst-case slot size. A record that
+/// would straddle the end of the buffer is preceded by a pad marker and
+/// written at offset 0 instead.
+///
+/// Positions are free-running u64 byte counters; `write_pos - read_pos` is
+/// the number of bytes in use. Capacity must be a power of 2.
+pub const ByteRing = struct {
+    pub const HEADER_SIZE = 8;
+    pub const RECORD_ALIGN = 8;
+    /// Length header value marking the rest of the buffer as skipped.
+    const PAD_MARKER: u32 = std.math.maxInt(u32);
+
+    // Cache-line aligned producer state. `cached_read_pos` is a producer-local
+    // snapshot of `read_pos` so the common case never touches the consumer's line;
+    // `reserved_end` is where the pending reservation ends, and `reserved`
+    // whether there is one to commit.
+    write_pos: std.atomic.Value(u64) align(CACHE_LINE) = std.atomic.Value(u64).init(0),
+    cached_read_pos: u64 = 0,
+    reserved_end: u64 = 0,
+    reserved: bool = false,
+    _pad1: [CACHE_LINE - 3 * @sizeOf(u64) - 1]u8 = undefined,
+
+    // Cache-line aligned consumer state
+    read_pos: std.atomic.Value(u64) align(CACHE_LINE) = std.atomic.Value(u64).init(0),
+    _pad2: [CACHE_LINE - @sizeOf(u64)]u8 = undefined,
+
+    buffer: []align(CACHE_LINE) u8,
+    mask: u64,
+
+    pub fn init(allocator: std.mem.Allocator, capacity: u32) !ByteRing {
+        if (capacity < 2 * CACHE_LINE or (capacity & (capacity - 1)) != 0) {
+            return error.InvalidCapacity;
+        }
+        const buffer = try allocator.alignedAlloc(u8, std.mem.Alignment.fromByteUnits(CACHE_LINE), capacity);
+        return .{ .buffer = buffer, .mask = capacity - 1 };
+    }
+
+    /// A ring over caller-owned memory (e.g. a file mapping), which must
+    /// outlive it; do not call `deinit()`.
+    pub fn initBuffer(buffer: []align(CACHE_LINE) u8) !ByteRing {
+        if (buffer.len < 2 * CACHE_LINE or !std.math.isPowerOfTwo(buffer.len)) {
+            return error.InvalidCapacity;
+        }
+        return .{ .buffer = buffer, .mask = buffer.len - 1 };
+    }
+
+    /// Resume a ring whose buffer (from `initBuffer()`) still holds the
+    /// frames committed between `read_pos` and `write_pos` by an earlier
+    /// owner, e.g. a file mapping reopened after a crash.
+    pub fn restore(self: *ByteRing, read_pos: u64, write_pos: u64) void {
+        self.read_pos.store(read_pos, .monotonic);
+        self.write_pos.store(write_pos, .monotonic);
+        self.cached_read_pos = read_pos;
+        self.reserved_end = write_pos;
+        self.reserved = false;
+    }
+
+    /// Number of frames between `read_pos` and `write_pos` if they are what
+    /// this ring's producer writes: aligned positions at most a buffer apart,
+    /// lengths up to `maxRecordLen()`, every frame inside the span and the
+    /// buffer, and pad markers only where a frame would have straddled the
+    /// end. Null otherwise, e.g. for a torn header in a reopened file
+    /// mapping, which `restore()` must not be given.
+    pub fn countFrames(self: *const ByteRing, read_pos: u64, write_pos: u64) ?u64 {
+        if (read_pos > write_pos or write_pos - read_pos > self.buffer.len) return null;
+        if (read_pos % RECORD_ALIGN != 0 or write_pos % RECORD_ALIGN != 0) return null;
+        var pos = read_pos;
+        var count: u64 = 0;
+        while (pos < write_pos) {
+            const index = pos & self.mask;
+            const tail_room = self.buffer.len - index;
+            const len = self.readHeader(index);
+            if (len == PAD_MARKER) {
+                // Padding runs to the end of the buffer, and only when the
+                // next frame would not have fit in it
+                if (write_pos - pos <= tail_room) return null;
+                const next = self.readHeader(0);
+                if (next == PAD_MARKER or next > self.maxRecordLen() or frameSize(next) <= tail_room) return null;
+                pos += tail_room;
+                continue;
+            }
+            if (len > self.maxRecordLen()) return null;
+            const frame = frameSize(len);
+            if (frame > tail_room or frame > write_pos - pos) return null;
+            pos += frame;
+            count += 1;
+        }
+        return count;
+    }
+
+    pub fn deinit(self: *ByteRing, allocator: std.mem.Allocator) void {
+        allocator.free(self.buffer);
+    }
+
+    /// Largest record `tryPush` accepts. Bounded to half the buffer so a
+    /// record always fits after at most one wrap pad.
+    pub fn maxRecordLen(self: *const ByteRing) u32 {
+        return @intCast(self.buffer.len / 2 - HEADER_SIZE);
+    }
+
+    /// Ring bytes one record of `len` bytes occupies, header included.
+    pub fn frameSize(len: usize) u64 {
+        return std.mem.alignForward(u64, HEADER_SIZE + len, RECORD_ALIGN);
+    }
+
+    fn writeHeader(self: *ByteRing, index: u64, value: u32) void {
+        std.mem.writeInt(u32, self.buffer[index..][0..4], value, .little);
+    }
+
+    fn readHeader(self: *const ByteRing, index: u64) u32 {
+        return std.mem.readInt(u32, self.buffer[index..][0..4], .little);
+    }
+
+    /// Producer side -- copies `record` into the ring. Returns false if there
+    /// is not enough free space (NEVER blocks).
+    pub fn tryPush(self: *ByteRing, record: []const u8) bool {
+        const dest = self.reserve(record.len) orelse return false;
+        @memcpy(dest, record);
+        return self.commit();
+    }
+
+    /// Producer side -- claims `len` contiguous bytes of ring memory for the
+    /// caller to fill in place. Nothing is visible to the consumer until
+    /// `commit()`; calling `reserve` again first abandons this reservation.
+    /// Returns null if the record is too large or the ring is full.
+    pub fn reserve(self: *ByteRing, len: usize) ?[]u8 {
+        self.reserved = false;
+        if (len > self.maxRecordLen()) return null;
+
+        const capacity: u64 = self.buffer.len;
+        const frame = frameSize(len);
+        var w = self.write_pos.load(.monotonic);
+        const index = w & self.mask;
+        const tail_room = capacity - index;
+        const pad: u64 = if (frame > tail_room) tail_room else 0;
+
+        if (w + pad + frame - self.cached_read_pos > capacity) {
+            self.cached_read_pos = self.read_pos.load(.acquire);
+            if (w + pad + frame - self.cached_read_pos > capacity) return null; // full
+        }
+
+        if (pad != 0) {
+            self.writeHeader(index, PAD_MARKER);
+            w += pad;
+        }
+
+        const start = w & self.mask;
+        self.writeHeader(start, @intCast(len));
+        self.reserved_end = w + frame;
+        self.reserved = true;
+        return self.buffer[start + HEADER_SIZE ..][0..len];
+    }
+
+    /// Producer side -- discards the oldest committed record to make room,
+    /// for drop-oldest overflow. Only safe while the consumer is excluded
+    /// from the ring (see `Producer.reserveEvicting` in log_sink.zig).
+    /// Returns false if the ring is empty.
+    pub fn evictOldest(self: *ByteRing) bool {
+        var r = self.read_pos.load(.monotonic);
+        const w = self.write_pos.load(.monotonic);
+        while (r != w) {
+            const index = r & self.mask;
+            const len = self.readHeader(index);
+            if (len == PAD_MARKER) {
+                r += self.buffer.len - index;
+                continue;
+            }
+            r += frameSize(len);
+            self.read_pos.store(r, .release);
+            self.cached_read_pos = r;
+            return true;
+        }
+        return false;
+    }
+
+    /// Producer side -- publishes the bytes claimed by the last `reserve()`.
+    /// Returns false, publishing nothing, without one: after a `reserve()`
+    /// that returned null, or a second `commit()` of the same bytes.
+    pub fn commit(self: *ByteRing) bool {
+        if (!self.reserved) return false;
+        self.reserved = false;
+        self.write_pos.store(self.reserved_end, .release);
+        return true;
+    }
+
+    /// `commit()` with a seq_cst store, for producers that check whether the
+    /// consumer is parked right after publishing (see `wait.Parker`).
+    pub fn commitSeqCst(self: *ByteRing) bool {
+        if (!self.reserved) return false;
+        self.reserved = false;
+        self.write_pos.store(self.reserved_end, .seq_cst);
+        return true;
+    }
+
+    /// Committed bytes as at most two contiguous runs of ring memory: `first`
+    /// starts at the read position, `second` continues from offset 0 after a
+    /// wrap. Walk the records with `records()`.
+    pub const Span = struct {
+        first: []const u8,
+        second: []const u8,
+
+        pub fn records(self: Span) RecordIterator {
+            return .{ .span = self };
+        }
+    };
+
+    /// Yields the payload of each frame in a `Span`, in place. `consumed`
+    /// is the byte count to pass to `release()`, including wrap padding.
+    pub const RecordIterator = struct {
+        span: Span,
+        offset: usize = 0,
+        in_second: bool = false,
+        consumed: u64 = 0,
+
+        pub fn next(self: *RecordIterator) ?[]const u8 {
+            while (true) {
+                const part = if (self.in_second) self.span.second else self.span.first;
+                if (self.offset == part.len) {
+                    if (self.in_second or self.span.second.len == 0) return null;
+                    self.in_second = true;
+                    self.offset = 0;
+                    continue;
+                }
+
+                const len = std.mem.readInt(u32, part[self.offset..][0..4], .little);
+                if (len == PAD_MARKER) {
+                    // The rest of `first` is padding; the record is at offset 0
+                    self.consumed += part.len - self.offset;
+                    self.offset = part.len;
+                    continue;
+                }
+
+                const frame = frameSize(len);
+                const payload = part[self.offset + HEADER_SIZE ..][0..len];
+                self.offset += frame;
+                self.consumed += frame;
+                return payload;
+            }
+        }
+
+        /// Yields up to `max_count` consecutive records of the same length
+        /// that sit in one contiguous part of the span, so a consumer can
+        /// process them as a single strided run.
+        pub fn nextRun(self: *RecordIterator, max_count: u32) ?Run {
+            if (max_count == 0) return null;
+            const first = self.next() orelse return null;
+            const part = if (self.in_second) self.span.second else self.span.first;
+            const stride = frameSize(first.len);
+
+            // A pad marker never equals a real length, so it ends the run
+            var count: u32 = 1;
+            while (count < max_count and self.offset < part.len) : (count += 1) {
+                const len = std.mem.readInt(u32, part[self.offset..][0..4], .little);
+                if (len != first.len) break;
+                self.offset += stride;
+                self.consumed += stride;
+            }
+            return .{
+                .bytes = first.ptr[0 .. (count - 1) * stride + first.len],
+                .len = first.len,
+                .stride = stride,
+                .count = count,
+            };
+        }
+    };
+
+    /// `count` payloads of `len` bytes, each `stride` bytes after the
+    /// previous; the first starts at `bytes[0]`.
+    pub const Run = struct {
+        bytes: []const u8,
+        len: usize,
+        stride: usize,
+        count: u32,
+
+        pub fn record(self: Run, i: u32) []const u8 {
+            return self.bytes[i * self.stride ..][0..self.len];
+        }
+    };
+
+    /// Consumer side -- exposes every committed frame in place with a single
+    /// acquire load. Nothing is consumed until `release()`.
+    pub fn peekContiguous(self: *ByteRing) Span {
+        const r = self.read_pos.load(.monotonic);
+        const w = self.write_pos.load(.acquire);
+
+        const index = r & self.mask;
+        const used = w - r;
+        const first_len = @min(used, self.buffer.len - index);
+        return .{
+            .first = self.buffer[index..][0..first_len],
+            .second = self.buffer[0 .. used - first_len],
+        };
+    }
+
+    /// Consumer side -- frees `bytes` of the span returned by
+    /// `peekContiguous()` (use `RecordIterator.consumed`).
+    pub fn release(self: *ByteRing, bytes: u64) void {
+        const r = self.read_pos.load(.monotonic);
+        self.read_pos.store(r + bytes, .release);
+    }
+
+    /// Consumer side -- calls `onRecord(context, bytes)` for up to `max_count`
+    /// records in place, then releases their space with a single store.
+    /// `bytes` is only valid for the duration of the callback.
+    /// Returns the number of records consumed.
+    pub fn drain(
+        self: *ByteRing,
+        max_count: u32,
+        context: anytype,
+        comptime onRecord: fn (@TypeOf(context), []const u8) void,
+    ) u32 {
+        var it = self.peekContiguous().records();
+        var count: u32 = 0;
+        while (count < max_count) : (count += 1) {
+            const record = it.next() orelse break;
+            onRecord(context, record);
+        }
+
+        if (it.consumed != 0) {
+            self.release(it.consumed);
+        }
+        return count;
+    }
+
+    /// Consumer side -- like `drain()`, but hands consecutive same-length
+    /// records to `onRun(context, run)` as strided runs in place.
+    /// Returns the number of records consumed.
+    pub fn drainRuns(
+        self: *ByteRing,
+        max_count: u32,
+        context: anytype,
+        comptime onRun: fn (@TypeOf(context), Run) void,
+    ) u32 {
+        var it = self.peekContiguous().records();
+        var count: u32 = 0;
+        while (it.nextRun(max_count - count)) |run| {
+            onRun(context, run);
+            count += run.count;
+        }
+
+        if (it.consumed != 0) {
+            self.release(it.consumed);
+        }
+        return count;
+    }
+
+    /// Returns true if the ring holds no records.
+    pub fn isEmpty(self: *ByteRing) bool {
+        return self.read_pos.load(.monotonic) == self.write_pos.load(.monotonic);
+    }
+
+    /// Consumer side -- `isEmpty()` with a seq_cst load of the write
+    /// position, pairing with `commitSeqCst()`.
+    pub fn isEmptySeqCst(self: *ByteRing) bool {
+        return self.read_pos.load(.monotonic) == self.write_pos.load(.seq_cst);
+    }
+
+    /// Returns the number of bytes in use, including headers and padding.
+    pub fn usedBytes(self: *ByteRing) u64 {
+        const w = self.write_pos.load(.monotonic);
+        const r = self.read_pos.load(.monotonic);
+        return w -% r;
+    }
+};
+
 test "RingBuffer basic push/pop" {
     var rb = RingBuffer(u32, 4).init();
 
@@ -124,3 +518,249 @@ test "RingBuffer drainBatch" {
     }
     try std.testing.expectEqual(@as(u32, 2), rb.len());
 }
+
+test "ByteRing variable-length records and wraparound" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+
+    const Collector = struct {
+        total: usize = 0,
+        last: [64]u8 = undefined,
+        last_len: usize = 0,
+
+        fn onRecord(self: *@This(), bytes: []const u8) void {
+            self.total += bytes.len;
+            @memcpy(self.last[0..bytes.len], bytes);
+            self.last_len = bytes.len;
+        }
+    };
+
+    var rec: [48]u8 = undefined;
+    @memset(&rec, 0xAB);
+
+    // Full detection: 48-byte records occupy 56-byte frames, 256 bytes hold four
+    for (0..4) |_| try std.testing.expect(ring.tryPush(&rec));
+    try std.testing.expect(!ring.tryPush(&rec));
+    var drained = Collector{};
+    try std.testing.expectEqual(@as(u32, 4), ring.drain(8, &drained, Collector.onRecord));
+    try std.testing.expectEqual(@as(usize, 4 * 48), drained.total);
+
+    // Every few pushes a frame no longer fits before the end and wraps to offset 0
+    for (0..50) |i| {
+        @memset(&rec, @intCast(i));
+        try std.testing.expect(ring.tryPush(&rec));
+        var c = Collector{};
+        try std.testing.expectEqual(@as(u32, 1), ring.drain(8, &c, Collector.onRecord));
+        try std.testing.expectEqual(@as(usize, 48), c.last_len);
+        try std.testing.expectEqualSlices(u8, &rec, c.last[0..c.last_len]);
+    }
+    try std.testing.expect(ring.isEmpty());
+
+    // Records larger than half the buffer are rejected outright
+    var big: [200]u8 = undefined;
+    @memset(&big, 0);
+    try std.testing.expect(!ring.tryPush(&big));
+}
+
+test "ByteRing reserve and commit in place" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+
+    const Collector = struct {
+        count: u32 = 0,
+        first: u8 = 0,
+
+        fn onRecord(self: *@This(), bytes: []const u8) void {
+            self.count += 1;
+            self.first = bytes[0];
+        }
+    };
+
+    // Reserved bytes are invisible until commit
+    const dest = ring.reserve(16).?;
+    @memset(dest, 7);
+    try std.testing.expect(ring.isEmpty());
+    try std.testing.expect(ring.commit());
+
+    var c = Collector{};
+    try std.testing.expectEqual(@as(u32, 1), ring.drain(8, &c, Collector.onRecord));
+    try std.testing.expectEqual(@as(u8, 7), c.first);
+
+    // An uncommitted reservation is abandoned by the next one
+    _ = ring.reserve(16).?;
+    const second = ring.reserve(16).?;
+    @memset(second, 9);
+    try std.testing.expect(ring.commit());
+    c = .{};
+    try std.testing.expectEqual(@as(u32, 1), ring.drain(8, &c, Collector.onRecord));
+    try std.testing.expectEqual(@as(u8, 9), c.first);
+
+    try std.testing.expect(ring.reserve(200) == null);
+}
+
+test "ByteRing commit needs a pending reservation" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+    try std.testing.expect(!ring.commit());
+
+    // A second commit of the same frame publishes nothing
+    @memset(ring.reserve(16).?, 1);
+    try std.testing.expect(ring.commit());
+    const one_frame = ring.write_pos.load(.monotonic);
+    try std.testing.expect(!ring.commit());
+    try std.testing.expect(!ring.commitSeqCst());
+    try std.testing.expectEqual(one_frame, ring.write_pos.load(.monotonic));
+
+    // Neither does a commit after a reserve that failed, even with an
+    // abandoned reservation before it
+    _ = ring.reserve(16).?;
+    try std.testing.expect(ring.reserve(200) == null);
+    try std.testing.expect(!ring.commit());
+    try std.testing.expectEqual(one_frame, ring.write_pos.load(.monotonic));
+    try std.testing.expectEqual(@as(?u64, 1), ring.countFrames(0, one_frame));
+}
+
+test "ByteRing evictOldest frees the oldest frames across the wrap pad" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+
+    const First = struct {
+        first: ?u8 = null,
+
+        fn onRecord(self: *@This(), bytes: []const u8) void {
+            if (self.first == null) self.first = bytes[0];
+        }
+    };
+
+    var rec: [48]u8 = undefined;
+    try std.testing.expect(!ring.evictOldest());
+
+    // Offset the ring so the next records wrap with a pad marker
+    for (0..3) |_| try std.testing.expect(ring.tryPush(&rec));
+    var skip = First{};
+    _ = ring.drain(3, &skip, First.onRecord);
+
+    // Keep pushing 1, 2, ... evicting the oldest whenever full
+    var seq: u8 = 1;
+    while (seq <= 12) : (seq += 1) {
+        @memset(&rec, seq);
+        while (!ring.tryPush(&rec)) try std.testing.expect(ring.evictOldest());
+    }
+    // Four 56-byte frames fit, so 9..12 survive
+    var c = First{};
+    try std.testing.expectEqual(@as(u32, 4), ring.drain(8, &c, First.onRecord));
+    try std.testing.expectEqual(@as(u8, 9), c.first.?);
+    try std.testing.expect(ring.isEmpty());
+}
+
+test "ByteRing countFrames rejects torn headers and stray padding" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+
+    // Four 56-byte frames, two consumed, two more after a 32-byte wrap pad
+    var rec: [48]u8 = undefined;
+    @memset(&rec, 0xCD);
+    for (0..4) |_| try std.testing.expect(ring.tryPush(&rec));
+    var it = ring.peekContiguous().records();
+    _ = it.next();
+    _ = it.next();
+    ring.release(it.consumed);
+    for (0..2) |_| try std.testing.expect(ring.tryPush(&rec));
+    const r = ring.read_pos.load(.monotonic);
+    const w = ring.write_pos.load(.monotonic);
+    try std.testing.expectEqual(@as(?u64, 4), ring.countFrames(r, w));
+
+    try std.testing.expectEqual(@as(?u64, null), ring.countFrames(r + 4, w));
+    try std.testing.expectEqual(@as(?u64, null), ring.countFrames(r, w + 256));
+    try std.testing.expectEqual(@as(?u64, null), ring.countFrames(r, w - 8));
+
+    // A length past the buffer, then a pad where the frame would have fit
+    ring.writeHeader((r + 56) & ring.mask, 1000);
+    try std.testing.expectEqual(@as(?u64, null), ring.countFrames(r, w));
+    ring.writeHeader((r + 56) & ring.mask, 48);
+    ring.writeHeader(0, 16);
+    try std.testing.expectEqual(@as(?u64, null), ring.countFrames(r, w));
+}
+
+test "ByteRing peekContiguous spans the wrap point" {
+    var ring = try ByteRing.init(std.testing.allocator, 256);
+    defer ring.deinit(std.testing.allocator);
+
+    // Three 56-byte frames, consume two so the read position sits at 112
+    var rec: [48]u8 = undefined;
+    for (0..3) |i| {
+        @memset(&rec, @intCast(i));
+        try std.testing.expect(ring.tryPush(&rec));
+    }
+    var it = ring.peekContiguous().records();
+    _ = it.next().?;
+    _ = it.next().?;
+    ring.release(it.consumed);
+
+    // Two more: the first fits before the end (ends at 224), the second wraps
+    for (3..5) |i| {
+        @memset(&rec, @intCast(i));
+        try std.testing.expect(ring.tryPush(&rec));
+    }
+
+    const span = ring.peekContiguous();
+    try std.testing.expect(span.second.len > 0);
+
+    it = span.records();
+    var expected: u8 = 2;
+    while (it.next()) |payload| : (expected += 1) {
+        try std.testing.expectEqual(@as(usize, 48), payload.len);
+        try std.testing.expectEqual(expected, payload[0]);
+    }
+    try std.testing.expectEqual(@as(u8, 5), expected);
+    ring.release(it.consumed);
+    try std.testing.expect(ring.isEmpty());
+}
+
+test "RingBuffer peekContiguous and release" {
+    var rb = RingBuffer(u32, 8).init();
+
+    for (0..6) |i| try std.testing.expect(rb.tryPush(@intCast(i)));
+    rb.release(rb.peekContiguous(5).len());
+    for (6..10) |i| try std.testing.expect(rb.tryPush(@intCast(i)));
+
+    // Items 5..9 sit at indices 5,6,7,0,1
+    const span = rb.peekContiguous(8);
+    try std.testing.expectEqualSlices(u32, &.{ 5, 6, 7 }, span.first);
+    try std.testing.expectEqualSlices(u32, &.{ 8, 9 }, span.second);
+    rb.release(span.len());
+    try std.testing.expect(rb.isEmpty());
+}
+
+test "ByteRing drainRuns groups same-length records" {
+    var ring = try ByteRing.init(std.testing.allocator, 1024);
+    defer ring.deinit(std.testing.allocator);
+
+    const Collector = struct {
+        runs: [8]u32 = undefined,
+        num_runs: usize = 0,
+
+        fn onRun(self: *@This(), run: ByteRing.Run) void {
+            for (0..run.count) |i| {
+                const rec = run.record(@intCast(i));
+                std.debug.assert(rec.len == run.len and rec[0] == rec.len);
+            }
+            self.runs[self.num_runs] = run.count;
+            self.num_runs += 1;
+        }
+    };
+
+    var rec: [24]u8 = undefined;
+    for ([_]usize{ 12, 12, 12, 20, 20, 12 }) |len| {
+        @memset(rec[0..len], @intCast(len));
+        try std.testing.expect(ring.tryPush(rec[0..len]));
+    }
+
+    var c = Collector{};
+    try std.testing.expectEqual(@as(u32, 5), ring.drainRuns(5, &c, Collector.onRun));
+    try std.testing.expectEqualSlices(u32, &.{ 3, 2 }, c.runs[0..c.num_runs]);
+
+    c = .{};
+    try std.testing.expectEqual(@as(u32, 1), ring.drainRuns(8, &c, Collector.onRun));
+    try std.testing.expect(ring.isEmpty());
+}
@@ -0,0 +1,170 @@
+const std = @import("std");
+const linux = std.os.linux;
+
+const CACHE_LINE = 64;
+
+/// Bytes before the ring data: the `Header` on the first cache line, then
+/// the state the owner places with `state()` (the sink keeps its whole
+/// `Producer` there, so the ring positions persist in place).
+pub const STATE_BYTES = 4096;
+
+/// Offset of the owner's state within the mapping.
+pub const STATE_OFFSET = CACHE_LINE;
+
+const MAGIC: u64 = 0x31474e4952514650; // "PFQRING1"
+const VERSION: u32 = 1;
+
+pub const Header = extern struct {
+    /// Written last, once the state is initialized.
+    magic: u64,
+    version: u32,
+    capacity: u32,
+    /// Identifies the record layout the ring was filled with.
+    schema_hash: u64,
+    /// Identifies the in-memory layout of the state, which changes between
+    /// builds; a mismatch makes the ring unrecoverable.
+    layout_hash: u64,
+};
+
+/// A producer ring's backing file, mapped shared so that whatever the
+/// process commits to it is in the page cache (tmpfs such as /dev/shm, or a
+/// DAX mount) the moment it is stored and survives a crash of the process.
+/// Pushes touch the mapping exactly as they would heap memory; the pages
+/// are populated up front so the first pass incurs no faults either.
+///
+/// Layout: `STATE_BYTES` of header and owner state, then `capacity` bytes
+/// of ring data.
+pub const RingFile = struct {
+    mapping: []align(std.heap.page_size_min) u8,
+    path: [:0]u8,
+    /// Kept open for the exclusive `flock` that keeps a second sink (or
+    /// process) with the same `ring_path` out of the mapping.
+    fd: linux.fd_t,
+    /// The file already held a ring of the same capacity, schema and layout;
+    /// its state is intact and may hold unconsumed records.
+    reopened: bool,
+
+    /// Map the file at `path` (taking ownership of it), reusing its contents
+    /// when they match. With `create` false, returns null if the file does
+    /// not exist. error.RingFileLocked if another open `RingFile` holds it.
+    pub fn open(
+        allocator: std.mem.Allocator,
+        path: [:0]u8,
+        capacity: u32,
+        schema_hash: u64,
+        layout_hash: u64,
+        create: bool,
+    ) !?RingFile {
+        errdefer allocator.free(path);
+        if (!std.math.isPowerOfTwo(capacity)) return error.InvalidCapacity;
+
+        const rc = linux.open(path, .{ .ACCMODE = .RDWR, .CREAT = create, .CLOEXEC = true }, 0o600);
+        switch (linux.errno(rc)) {
+            .SUCCESS => {},
+            .NOENT => if (!create) {
+                allocator.free(path);
+                return null;
+            } else return error.FileOpenFailed,
+            else => return error.FileOpenFailed,
+        }
+        const fd: linux.fd_t = @intCast(rc);
+        errdefer _ = linux.close(fd);
+        switch (linux.errno(linux.flock(fd, linux.LOCK.EX | linux.LOCK.NB))) {
+            .SUCCESS => {},
+            .AGAIN => return error.RingFileLocked,
+            else => return error.FileOpenFailed,
+        }
+
+        // A file of any other size holds no usable ring; empty it
+        const size: u64 = STATE_BYTES + @as(u64, capacity);
+        const end = linux.lseek(fd, 0, linux.SEEK.END);
+        if (linux.errno(end) != .SUCCESS) return error.FileOpenFailed;
+        const matches_size = end == size;
+        if (!matches_size) {
+            if (linux.errno(linux.ftruncate(fd, 0)) != .SUCCESS) return error.FileWriteFailed;
+            if (linux.errno(linux.ftruncate(fd, @intCast(size))) != .SUCCESS) return error.FileWriteFailed;
+        }
+
+        const addr = linux.mmap(null, size, linux.PROT.READ | linux.PROT.WRITE, .{ .TYPE = .SHARED, .POPULATE = true }, fd, 0);
+        if (linux.errno(addr) != .SUCCESS) return error.MapFailed;
+        const mapping = @as([*]align(std.heap.page_size_min) u8, @ptrFromInt(addr))[0..size];
+
+        var self = RingFile{ .mapping = mapping, .path = path, .fd = fd, .reopened = false };
+        const header = self.header();
+        self.reopened = matches_size and header.magic == MAGIC and header.version == VERSION and
+            header.capacity == capacity and header.schema_hash == schema_hash and header.layout_hash == layout_hash;
+        if (!self.reopened) {
+            // Invalid until the owner has initialized its state
+            @atomicStore(u64, &header.magic, 0, .release);
+            header.version = VERSION;
+            header.capacity = capacity;
+            header.schema_hash = schema_hash;
+            header.layout_hash = layout_hash;
+        }
+        return self;
+    }
+
+    /// Mark the file recoverable once the owner's state is initialized.
+    pub fn seal(self: RingFile) void {
+        @atomicStore(u64, &self.header().magic, MAGIC, .release);
+    }
+
+    pub fn header(self: RingFile) *Header {
+        return @ptrCast(self.mapping.ptr);
+    }
+
+    /// The owner's state, at `STATE_OFFSET`.
+    pub fn state(self: RingFile, comptime T: type) *T {
+        comptime std.debug.assert(@alignOf(T) <= CACHE_LINE and STATE_OFFSET + @sizeOf(T) <= STATE_BYTES);
+        return @ptrCast(@alignCast(self.mapping.ptr + STATE_OFFSET));
+    }
+
+    /// Ring data, for `ByteRing.initBuffer`.
+    pub fn data(self: RingFile) []align(CACHE_LINE) u8 {
+        return @alignCast(self.mapping[STATE_BYTES..]);
+    }
+
+    /// Unmap the file, and delete it when `remove` (nothing left to recover).
+    /// Frees the path.
+    pub fn close(self: RingFile, allocator: std.mem.Allocator, remove: bool) void {
+        _ = linux.munmap(self.mapping.ptr, self.mapping.len);
+        if (remove) _ = linux.unlink(self.path);
+        _ = linux.close(self.fd);
+        allocator.free(self.path);
+    }
+};
+
+// ---- Tests ----
+
+test "ring file state survives a reopen only with a matching header" {
+    const allocator = std.testing.allocator;
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try @import("../testing.zig").tmpPath(allocator, &tmp, "state.ring");
+    defer allocator.free(path);
+
+    const State = struct { pos: u64 align(CACHE_LINE) };
+
+    var file = (try RingFile.open(allocator, try allocator.dupeZ(u8, path), 1 << 12, 7, 9, true)).?;
+    try std.testing.expect(!file.reopened);
+    file.state(State).pos = 1234;
+    file.data()[100] = 0x5A;
+    file.seal();
+    file.close(allocator, false);
+
+    file = (try RingFile.open(allocator, try allocator.dupeZ(u8, path), 1 << 12, 7, 9, false)).?;
+    try std.testing.expect(file.reopened);
+    try std.testing.expectEqual(@as(u64, 1234), file.state(State).pos);
+    try std.testing.expectEqual(@as(u8, 0x5A), file.data()[100]);
+    file.close(allocator, false);
+
+    // Another schema cannot read these records
+    file = (try RingFile.open(allocator, try allocator.dupeZ(u8, path), 1 << 12, 8, 9, false)).?;
+    try std.testing.expect(!file.reopened);
+
+    // Nor can a second owner map the file while it is open
+    try std.testing.expectError(error.RingFileLocked, RingFile.open(allocator, try allocator.dupeZ(u8, path), 1 << 12, 8, 9, false));
+    file.close(allocator, true);
+
+    try std.testing.expect((try RingFile.open(allocator, try allocator.dupeZ(u8, path), 1 << 12, 7, 9, false)) == null);
+}
@@ -0,0 +1,172 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const Histogram = @import("../histogram.zig").Histogram;
+
+const CACHE_LINE = 64;
+
+/// Monotonic counter with a single writing thread. `add` is a relaxed load
+/// and store rather than an atomic read-modify-write, so bumping it costs
+/// the same as a plain increment; any thread may `get` it.
+pub const Counter = struct {
+    value: std.atomic.Value(u64) = .init(0),
+
+    pub inline fn add(self: *Counter, n: u64) void {
+        self.value.store(self.value.load(.monotonic) +% n, .monotonic);
+    }
+
+    /// Raise the counter to `v` if it is lower (high-water marks).
+    pub inline fn raise(self: *Counter, v: u64) void {
+        if (v > self.value.load(.monotonic)) self.value.store(v, .monotonic);
+    }
+
+    pub fn get(self: *const Counter) u64 {
+        return self.value.load(.monotonic);
+    }
+};
+
+/// Per-producer counters, embedded in each `Producer`. The producer thread
+/// and the writer thread each write their own cache line, so counting adds
+/// no shared writes to the logging path.
+pub const ProducerCounters = struct {
+    // Producer thread
+    logged: Counter align(CACHE_LINE) = .{},
+    logged_bytes: Counter = .{},
+    dropped_full: Counter = .{},
+    dropped_too_large: Counter = .{},
+    /// Evicted by the drop-oldest policy.
+    dropped_oldest: Counter = .{},
+    /// Committed to the spill journal rather than the ring.
+    spilled: Counter = .{},
+    /// Length of the open reservation, counted on `commit()`.
+    pending_len: u64 = 0,
+
+    // Writer thread: fullest the ring was seen at the start of a drain pass
+    high_water: Counter align(CACHE_LINE) = .{},
+};
+
+/// Pipeline stages the sink's background threads time (mirrors pqflow_stage).
+pub const Stage = enum(u32) {
+    /// Writer thread: one pass over the rings, less the columnarize time.
+    drain = 0,
+    /// Writer thread: splitting the pass's records into column buffers.
+    columnarize = 1,
+    /// Flush thread: value and level encoding of one row group, summed over
+    /// columns (CPU time across threads with an encoder pool).
+    encode = 2,
+    /// Flush thread: page compression of one row group, summed over columns.
+    compress = 3,
+    /// Flush thread: handing one row group's bytes to the file output.
+    write = 4,
+};
+
+pub const NUM_STAGES = @typeInfo(Stage).@"enum".fields.len;
+
+/// One latency histogram (in nanoseconds) per stage. Each stage has a
+/// single writing thread; readers take `summary()` at any time.
+pub const StageTimes = struct {
+    histograms: [NUM_STAGES]Histogram,
+
+    pub fn create(allocator: Allocator) !*StageTimes {
+        const self = try allocator.create(StageTimes);
+        for (&self.histograms) |*h| h.* = .empty;
+        return self;
+    }
+
+    pub fn record(self: *StageTimes, stage: Stage, ns: u64) void {
+        self.histograms[@intFromEnum(stage)].recordShared(ns);
+    }
+
+    pub fn summary(self: *const StageTimes, stage: Stage) StageSummary {
+        const hist = &self.histograms[@intFromEnum(stage)];
+        const ps = [_]f64{ 50, 99, 99.9 };
+        var out: [ps.len]u64 = undefined;
+        hist.sharedPercentiles(&ps, &out);
+        const totals = hist.sharedTotals();
+        return .{
+            .count = totals.count,
+            .total_ns = totals.sum,
+            .p50_ns = out[0],
+            .p99_ns = out[1],
+            .p999_ns = out[2],
+            .max_ns = totals.max,
+        };
+    }
+};
+
+pub const StageSummary = struct {
+    count: u64,
+    total_ns: u64,
+    p50_ns: u64,
+    p99_ns: u64,
+    p999_ns: u64,
+    max_ns: u64,
+};
+
+/// Point-in-time view of a sink, from `LogSink.stats()`. Counters are read
+/// one by one, so they may be a few records apart from each other.
+pub const SinkStats = struct {
+    /// Records committed to the rings, and their bytes.
+    records_logged: u64 = 0,
+    bytes_logged: u64 = 0,
+    /// Records refused because their ring was full.
+    records_dropped_full: u64 = 0,
+    /// Records refused for exceeding the largest record a ring holds.
+    records_dropped_too_large: u64 = 0,
+    /// Records drained into batches.
+    records_written: u64 = 0,
+    batches_flushed: u64 = 0,
+    write_errors: u64 = 0,
+    files_finalized: u64 = 0,
+    /// Column chunk bytes of written row groups before and after compression.
+    bytes_uncompressed: u64 = 0,
+    bytes_compressed: u64 = 0,
+    /// Row group bytes handed to output files.
+    bytes_written: u64 = 0,
+    num_producers: u32 = 0,
+    ring_capacity: u32 = 0,
+    /// Bytes held by the fullest ring right now.
+    ring_used_bytes: u64 = 0,
+    /// Most bytes any ring held when the writer thread came to drain it.
+    ring_high_water_bytes: u64 = 0,
+    stages: [NUM_STAGES]StageSummary = @splat(std.mem.zeroes(StageSummary)),
+    /// Records the drop-oldest policy evicted from a full ring.
+    records_dropped_oldest: u64 = 0,
+    /// Records committed to spill journals (included in `records_logged`).
+    records_spilled: u64 = 0,
+    /// Spilled bytes not yet replayed, over all journals.
+    spill_used_bytes: u64 = 0,
+    /// Records a crashed run left in reopened ring files (`ring_path`),
+    /// drained ahead of new ones; counted in `records_written` but not in
+    /// `records_logged`.
+    records_recovered: u64 = 0,
+    /// Rows `logColumns()` wrote straight into row groups (not counted in
+    /// `records_logged` or `records_written`).
+    column_rows_written: u64 = 0,
+    /// Reopened ring files started empty because their positions or frame
+    /// headers were corrupt (e.g. torn by the crash).
+    rings_discarded: u64 = 0,
+    /// Records drained from the rings that the batch rejected, e.g. shorter
+    /// than the schema's record size; not counted in `records_written`.
+    records_rejected: u64 = 0,
+};
+
+test "counters and stage summaries" {
+    var counters = ProducerCounters{};
+    counters.logged.add(3);
+    counters.logged.add(2);
+    counters.high_water.raise(100);
+    counters.high_water.raise(40);
+    try std.testing.expectEqual(@as(u64, 5), counters.logged.get());
+    try std.testing.expectEqual(@as(u64, 100), counters.high_water.get());
+    // The two writers never share a cache line
+    try std.testing.expect(@offsetOf(ProducerCounters, "high_water") - @offsetOf(ProducerCounters, "logged") >= CACHE_LINE);
+
+    const times = try StageTimes.create(std.testing.allocator);
+    defer std.testing.allocator.destroy(times);
+    for (1..101) |ns| times.record(.encode, ns * 1000);
+    const s = times.summary(.encode);
+    try std.testing.expectEqual(@as(u64, 100), s.count);
+    try std.testing.expectEqual(@as(u64, 100_000), s.max_ns);
+    try std.testing.expect(s.p50_ns >= 50_000 and s.p50_ns <= 50_000 + 50_000 / 128);
+    try std.testing.expectEqual(@as(u64, 0), times.summary(.drain).count);
+}
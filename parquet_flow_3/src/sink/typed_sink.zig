@@ -0,0 +1,358 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const batch_mod = @import("batch.zig");
+const BatchAccumulator = batch_mod.BatchAccumulator;
+const ColumnDef = batch_mod.ColumnDef;
+const ColumnEncoding = batch_mod.ColumnEncoding;
+const PhysicalType = batch_mod.PhysicalType;
+const SchemaInfo = batch_mod.SchemaInfo;
+const log_sink = @import("log_sink.zig");
+const LogSink = log_sink.LogSink;
+const LogError = log_sink.LogError;
+const CommitError = log_sink.CommitError;
+const SinkConfig = log_sink.SinkConfig;
+const ByteRing = @import("ring_buffer.zig").ByteRing;
+
+/// A `LogSink` whose schema is derived at comptime from the `extern struct`
+/// `Record`: one required column per field, in declaration order, named
+/// after the field. Supported field types are bool, i32/u32, i64/u64
+/// (unsigned ones annotated `INTEGER(bits, false)`), f32, f64, enums with a
+/// 32- or 64-bit tag, and [N]u8 (FIXED_LEN_BYTE_ARRAY).
+///
+/// The writer thread columnarizes runs of records with a kernel generated
+/// for `Record`: every field's offset, size and the ring stride are
+/// constants, so the transpose is one unrolled gather per field with no
+/// schema interpretation.
+///
+/// Per-column encodings may be chosen with an optional declaration on
+/// `Record`, e.g. `pub const column_encodings = .{ .ts = .delta_binary_packed };`,
+/// and Bloom filters enabled with `pub const bloom_filter_columns = .{"order_id"};`.
+pub fn Sink(comptime Record: type) type {
+    const info = @typeInfo(Record).@"struct";
+    if (info.layout != .@"extern") {
+        @compileError("Sink record " ++ @typeName(Record) ++ " must be an extern struct");
+    }
+    if (@alignOf(Record) > ByteRing.RECORD_ALIGN) {
+        @compileError("Sink record " ++ @typeName(Record) ++ " is over-aligned for the ring");
+    }
+
+    const fields = info.fields;
+    // Ring stride of back-to-back `Record`s; runs at this stride hit the
+    // fully constant kernel.
+    const frame_stride: usize = comptime ByteRing.frameSize(@sizeOf(Record));
+
+    return struct {
+        const Self = @This();
+
+        pub const columns: [fields.len]ColumnDef = blk: {
+            var cols: [fields.len]ColumnDef = undefined;
+            for (fields, &cols) |field, *col| {
+                const physical_type = physicalTypeOf(field.type);
+                col.* = .{
+                    .name = field.name,
+                    .physical_type = physical_type,
+                    .type_length = if (physical_type == .FIXED_LEN_BYTE_ARRAY) @sizeOf(field.type) else 0,
+                    .nullable = false,
+                    .offset = @offsetOf(Record, field.name),
+                    .size = @sizeOf(field.type),
+                    .encoding = encodingOf(field.name),
+                    .bloom_filter = hasBloomFilter(field.name),
+                    .unsigned = isUnsigned(field.type),
+                };
+            }
+            break :blk cols;
+        };
+
+        pub const schema = SchemaInfo{
+            .columns = &columns,
+            .record_size = @sizeOf(Record),
+            .nullable_count = 0,
+            .null_bitmap_bytes = 0,
+            .transpose = &transpose,
+        };
+
+        sink: *LogSink,
+
+        /// Typed handle on a producer thread's private ring.
+        pub const Producer = struct {
+            inner: *log_sink.Producer,
+
+            /// Non-blocking. Copies `record` into this producer's ring.
+            pub fn log(self: Producer, record: *const Record) LogError!void {
+                return self.inner.log(std.mem.asBytes(record));
+            }
+
+            /// Non-blocking. Claims ring memory for one record to be filled in
+            /// place; publish it with `commit()`.
+            pub fn reserve(self: Producer) LogError!*Record {
+                const bytes = try self.inner.reserve(@sizeOf(Record));
+                return @ptrCast(@alignCast(bytes.ptr));
+            }
+
+            pub fn commit(self: Producer) CommitError!void {
+                return self.inner.commit();
+            }
+        };
+
+        pub fn init(config: SinkConfig, allocator: Allocator) !Self {
+            return .{ .sink = try LogSink.init(config, schema, allocator) };
+        }
+
+        pub fn deinit(self: Self) void {
+            self.sink.deinit();
+        }
+
+        /// See `LogSink.registerProducer`.
+        pub fn registerProducer(self: Self) !Producer {
+            return .{ .inner = try self.sink.registerProducer() };
+        }
+
+        /// Non-blocking. Copies `record` into the default producer's ring.
+        pub fn log(self: Self, record: *const Record) LogError!void {
+            return self.producer().log(record);
+        }
+
+        /// See `Producer.reserve`; uses the default producer.
+        pub fn reserve(self: Self) LogError!*Record {
+            return self.producer().reserve();
+        }
+
+        /// See `Producer.commit`; uses the default producer.
+        pub fn commit(self: Self) CommitError!void {
+            return self.producer().commit();
+        }
+
+        pub fn flush(self: Self) void {
+            self.sink.flush();
+        }
+
+        /// See `LogSink.stats`.
+        pub fn stats(self: Self) log_sink.SinkStats {
+            return self.sink.stats();
+        }
+
+        fn producer(self: Self) Producer {
+            return .{ .inner = self.sink.default_producer };
+        }
+
+        fn transpose(acc: *BatchAccumulator, records: []const u8, stride: usize, count: u32) void {
+            if (stride == frame_stride) {
+                gatherFields(acc, records, frame_stride, count);
+            } else {
+                gatherFields(acc, records, stride, count);
+            }
+        }
+
+        inline fn gatherFields(acc: *BatchAccumulator, records: []const u8, stride: usize, count: u32) void {
+            inline for (fields, 0..) |field, i| {
+                const size = @sizeOf(field.type);
+                const offset = @offsetOf(Record, field.name);
+                const dst = acc.column_buffers[i].addManyAsSliceAssumeCapacity(@as(usize, count) * size);
+                if (size == 4 or size == 8) {
+                    batch_mod.gatherField(size, dst, records, stride, offset, count);
+                } else {
+                    batch_mod.gatherBytes(dst, records, stride, offset, size, count);
+                }
+            }
+        }
+
+        fn encodingOf(comptime name: []const u8) ColumnEncoding {
+            if (!@hasDecl(Record, "column_encodings")) return .default;
+            const encodings = Record.column_encodings;
+            if (!@hasField(@TypeOf(encodings), name)) return .default;
+            return @field(encodings, name);
+        }
+
+        fn hasBloomFilter(comptime name: []const u8) bool {
+            if (!@hasDecl(Record, "bloom_filter_columns")) return false;
+            inline for (Record.bloom_filter_columns) |column| {
+                if (std.mem.eql(u8, column, name)) return true;
+            }
+            return false;
+        }
+    };
+}
+
+/// Parquet physical type stored for a record field of type `T`.
+fn physicalTypeOf(comptime T: type) PhysicalType {
+    return switch (@typeInfo(T)) {
+        .bool => .BOOLEAN,
+        .int => |int| switch (int.bits) {
+            32 => .INT32,
+            64 => .INT64,
+            else => @compileError("unsupported record field type " ++ @typeName(T)),
+        },
+        .float => |float| switch (float.bits) {
+            32 => .FLOAT,
+            64 => .DOUBLE,
+            else => @compileError("unsupported record field type " ++ @typeName(T)),
+        },
+        .@"enum" => |e| physicalTypeOf(e.tag_type),
+        .array => |array| if (array.child == u8)
+            .FIXED_LEN_BYTE_ARRAY
+        else
+            @compileError("unsupported record field type " ++ @typeName(T)),
+        else => @compileError("unsupported record field type " ++ @typeName(T)),
+    };
+}
+
+/// Whether a field of type `T` is stored as an unsigned INT32/INT64.
+fn isUnsigned(comptime T: type) bool {
+    return switch (@typeInfo(T)) {
+        .int => |int| int.signedness == .unsigned,
+        .@"enum" => |e| isUnsigned(e.tag_type),
+        else => false,
+    };
+}
+
+// ---- Tests ----
+
+const TestOrder = extern struct {
+    timestamp_ns: i64,
+    symbol: [8]u8,
+    order_id: u64,
+    price: f64,
+    quantity: u32,
+    side: Side,
+    is_hidden: bool,
+    venue: [3]u8,
+
+    const Side = enum(i32) { buy = 0, sell = 1 };
+
+    pub const column_encodings = .{
+        .timestamp_ns = .delta_binary_packed,
+        .price = .byte_stream_split,
+    };
+    pub const bloom_filter_columns = .{"order_id"};
+};
+
+test "Sink derives the schema from the record type" {
+    const OrderSink = Sink(TestOrder);
+    const cols = OrderSink.columns;
+
+    try std.testing.expectEqual(@as(usize, 8), cols.len);
+    try std.testing.expectEqual(@as(u32, @sizeOf(TestOrder)), OrderSink.schema.record_size);
+    try std.testing.expectEqualStrings("timestamp_ns", cols[0].name);
+    try std.testing.expectEqual(PhysicalType.INT64, cols[0].physical_type);
+    try std.testing.expectEqual(ColumnEncoding.delta_binary_packed, cols[0].encoding);
+    try std.testing.expectEqual(PhysicalType.FIXED_LEN_BYTE_ARRAY, cols[1].physical_type);
+    try std.testing.expectEqual(@as(u32, 8), cols[1].type_length);
+    try std.testing.expectEqual(PhysicalType.DOUBLE, cols[3].physical_type);
+    try std.testing.expectEqual(ColumnEncoding.byte_stream_split, cols[3].encoding);
+    try std.testing.expect(cols[2].bloom_filter and !cols[1].bloom_filter);
+    try std.testing.expect(cols[2].unsigned and cols[4].unsigned and !cols[0].unsigned and !cols[5].unsigned);
+    try std.testing.expectEqual(PhysicalType.INT32, cols[5].physical_type);
+    try std.testing.expectEqual(PhysicalType.BOOLEAN, cols[6].physical_type);
+    try std.testing.expectEqual(@as(u32, @offsetOf(TestOrder, "venue")), cols[7].offset);
+}
+
+test "Sink transpose kernel matches the interpreted path" {
+    const allocator = std.testing.allocator;
+    const OrderSink = Sink(TestOrder);
+    const stride: usize = comptime ByteRing.frameSize(@sizeOf(TestOrder));
+    const num_rows = 37;
+
+    var records: [num_rows * stride]u8 align(8) = @splat(0);
+    for (0..num_rows) |r| {
+        const order: *TestOrder = @ptrCast(@alignCast(&records[r * stride]));
+        order.* = .{
+            .timestamp_ns = @intCast(r * 100),
+            .symbol = "AAPL    ".*,
+            .order_id = 1000 + r,
+            .price = 100.5 + @as(f64, @floatFromInt(r)),
+            .quantity = @intCast(r),
+            .side = if (r % 2 == 0) .buy else .sell,
+            .is_hidden = r % 5 == 0,
+            .venue = "XNY".*,
+        };
+    }
+
+    var interpreted_schema = OrderSink.schema;
+    interpreted_schema.transpose = null;
+    var expected = try BatchAccumulator.init(allocator, interpreted_schema, num_rows);
+    defer expected.deinit();
+    try expected.addRecords(&records, @sizeOf(TestOrder), stride, num_rows);
+
+    var batch = try BatchAccumulator.init(allocator, OrderSink.schema, num_rows);
+    defer batch.deinit();
+    try batch.addRecords(&records, @sizeOf(TestOrder), stride, num_rows);
+
+    try std.testing.expectEqual(expected.row_count, batch.row_count);
+    for (0..OrderSink.columns.len) |i| {
+        try std.testing.expectEqualSlices(u8, expected.column_buffers[i].items, batch.column_buffers[i].items);
+    }
+}
+
+/// Alternates pairs of small and above-maxInt(i32) quantities by order id.
+fn testQuantity(order_id: u64) u32 {
+    const id: u32 = @intCast(order_id);
+    return if (id / 2 % 2 == 0) id else std.math.maxInt(u32) - id;
+}
+
+test "Sink logs typed records" {
+    const allocator = std.testing.allocator;
+    const Reader = @import("../reader.zig").Reader;
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const path = try @import("../testing.zig").tmpPath(allocator, &tmp, "orders.parquet");
+    defer allocator.free(path);
+
+    const total = 200;
+    {
+        const sink = try Sink(TestOrder).init(.{ .batch_size = 16, .file_path = path }, allocator);
+        defer sink.deinit();
+
+        // Built in place on a registered producer, copied on the default one
+        const producer = try sink.registerProducer();
+        var order = std.mem.zeroes(TestOrder);
+        for (0..total / 2) |i| {
+            order.order_id = 2 * i;
+            order.quantity = testQuantity(order.order_id);
+            const slot = try producer.reserve();
+            slot.* = order;
+            try producer.commit();
+            order.order_id += 1;
+            order.quantity = testQuantity(order.order_id);
+            try sink.log(&order);
+        }
+
+        var waited_ms: u32 = 0;
+        while (sink.stats().records_written < total and waited_ms < 5000) : (waited_ms += 1) {
+            log_sink.nanosleep(std.time.ns_per_ms);
+        }
+        try std.testing.expectEqual(@as(u64, total), sink.stats().records_written);
+    }
+
+    const reader = try Reader.open(allocator, path);
+    defer reader.close();
+    try std.testing.expectEqual(@as(u64, total), reader.numRows());
+    try std.testing.expectEqual(@as(usize, 8), reader.columns.len);
+    try std.testing.expect(reader.columns[2].physical_type == .INT64 and reader.columns[2].unsigned);
+    try std.testing.expect(reader.columns[4].physical_type == .INT32 and reader.columns[4].unsigned);
+    try std.testing.expect(!reader.columns[5].unsigned);
+    // A row group of 3 or more rows holds two consecutive records of one
+    // producer, so quantities on both sides of maxInt(i32); signed
+    // statistics would put the large ones below the small ones
+    for (0..reader.numRowGroups()) |rg| {
+        if (reader.rowGroupRows(@intCast(rg)) < 3) continue;
+        const range = reader.columnRange(@intCast(rg), 4).?;
+        try std.testing.expect(range[0] <= std.math.maxInt(i32) and range[1] > std.math.maxInt(i32));
+    }
+
+    // Every order_id comes back once, with its quantity
+    const Check = struct {
+        ids: [total]bool = @splat(false),
+
+        fn onRow(self: *@This(), record: []const u8) bool {
+            const id = std.mem.readInt(u64, record[0..8], .little);
+            const quantity = std.mem.readInt(u32, record[8..12], .little);
+            if (id >= total or self.ids[id] or quantity != testQuantity(id)) return false;
+            self.ids[id] = true;
+            return true;
+        }
+    };
+    var check = Check{};
+    const result = try reader.scan(.{ .columns = &.{ 2, 4 } }, &check, Check.onRow);
+    try std.testing.expectEqual(@as(u64, total), result.rows);
+    for (check.ids) |seen| try std.testing.expect(seen);
+}
@@ -0,0 +1,89 @@
+const std = @import("std");
+const futex = @import("../futex.zig");
+
+/// How the writer thread waits when every ring is empty.
+pub const WaitStrategy = enum(i32) {
+    /// Poll with a 50us nanosleep. Low CPU, up to 50us added latency.
+    sleep = 0,
+    /// Busy-spin with the CPU's pause hint. Burns a core, lowest latency.
+    spin = 1,
+    /// Spin for `SPIN_LIMIT` iterations, then park on a futex.
+    spin_then_futex = 2,
+    /// Park on a futex immediately; producers wake it only while it is parked.
+    futex = 3,
+
+    pub fn usesFutex(self: WaitStrategy) bool {
+        return self == .spin_then_futex or self == .futex;
+    }
+};
+
+/// Pause iterations before `spin_then_futex` parks (roughly 10-50us).
+pub const SPIN_LIMIT: u32 = 4096;
+
+/// Single-waiter park/unpark. The consumer announces it is about to sleep,
+/// re-checks for work, then blocks on the futex; producers pay one load of
+/// a read-mostly cache line per commit and a syscall only when the
+/// consumer is actually parked.
+///
+/// Correctness relies on Dekker-style ordering: the producer's publish and
+/// the consumer's `parked` store are both seq_cst, as are the loads that
+/// follow them, so at least one side always sees the other.
+pub const Parker = struct {
+    parked: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
+
+    /// Consumer side. `hasWork(context)` must read producer state with
+    /// seq_cst loads.
+    pub fn park(
+        self: *Parker,
+        timeout_ns: u64,
+        context: anytype,
+        comptime hasWork: fn (@TypeOf(context)) bool,
+    ) void {
+        self.parked.store(1, .seq_cst);
+        if (!hasWork(context)) {
+            futex.wait(&self.parked, 1, timeout_ns);
+        }
+        self.parked.store(0, .monotonic);
+    }
+
+    /// Producer side -- call after publishing with a seq_cst store.
+    pub fn wake(self: *Parker) void {
+        if (self.parked.load(.seq_cst) == 0) return;
+        if (self.parked.swap(0, .seq_cst) != 0) {
+            futex.wake(&self.parked, 1);
+        }
+    }
+};
+
+test "Parker returns immediately when work is pending" {
+    var parker = Parker{};
+    const Ctx = struct {
+        fn hasWork(_: void) bool {
+            return true;
+        }
+    };
+    parker.park(std.time.ns_per_s, {}, Ctx.hasWork);
+    try std.testing.expectEqual(@as(u32, 0), parker.parked.load(.monotonic));
+}
+
+test "Parker wake releases a parked thread" {
+    var parker = Parker{};
+    var done = std.atomic.Value(bool).init(false);
+
+    const Waiter = struct {
+        fn hasWork(flag: *std.atomic.Value(bool)) bool {
+            return flag.load(.seq_cst);
+        }
+
+        fn run(p: *Parker, flag: *std.atomic.Value(bool)) void {
+            while (!flag.load(.seq_cst)) {
+                p.park(5 * std.time.ns_per_s, flag, hasWork);
+            }
+        }
+    };
+
+    const t = try std.Thread.spawn(.{}, Waiter.run, .{ &parker, &done });
+    done.store(true, .seq_cst);
+    parker.wake();
+    t.join();
+}
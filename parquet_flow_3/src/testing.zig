@@ -0,0 +1,16 @@
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const linux = std.os.linux;
+
+// Helpers for the in-file tests.
+
+/// Absolute path of `name` inside `tmp`, for the sink and output APIs that
+/// take paths rather than a `Dir`. Tests write there, never to the working
+/// directory, so they can run in parallel and leave nothing behind.
+pub fn tmpPath(allocator: Allocator, tmp: *const std.testing.TmpDir, name: []const u8) ![:0]u8 {
+    var cwd: [4096]u8 = undefined; // PATH_MAX
+    if (linux.errno(linux.getcwd(&cwd, cwd.len)) != .SUCCESS) return error.CurrentDirUnavailable;
+    const dir = std.mem.sliceTo(&cwd, 0);
+    // Where std.testing.tmpDir() creates `sub_path`
+    return std.fmt.allocPrintSentinel(allocator, "{s}/.zig-cache/tmp/{s}/{s}", .{ dir, tmp.sub_path, name }, 0);
+}
@@ -109,3 +109,195 @@ test "write parquet file with market data schema" {
     try testing.expectEqualStrings("PAR1", file_bytes[file_bytes.len - 4 ..]);
     try testing.expect(file_bytes.len > 100); // Should be a reasonable size
 }
+
+fn readFileAlloc(allocator: std.mem.Allocator, path: [*:0]const u8) ![]u8 {
+    const fp = std.c.fopen(path, "rb") orelse return error.FileOpenFailed;
+    defer _ = std.c.fclose(fp);
+
+    var out: std.ArrayList(u8) = .empty;
+    errdefer out.deinit(allocator);
+
+    var buf: [4096]u8 = undefined;
+    while (true) {
+        const n = std.c.fread(&buf, 1, buf.len, fp);
+        if (n == 0) break;
+        try out.appendSlice(allocator, buf[0..n]);
+    }
+    return out.toOwnedSlice(allocator);
+}
+
+test "log sink persists batches to a parquet file" {
+    const allocator = testing.allocator;
+    const batch = pf.batch;
+    const path = "/tmp/pqflow_test_log_sink.parquet";
+
+    const columns = [_]batch.ColumnDef{
+        .{ .name = "timestamp_ns", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 0, .size = 8 },
+        .{ .name = "quantity", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    };
+    const schema = batch.SchemaInfo{
+        .columns = &columns,
+        .record_size = 12,
+        .nullable_count = 0,
+        .null_bitmap_bytes = 0,
+    };
+
+    // 200 records with 64-row batches: three full row groups plus a partial one on shutdown
+    const sink = try pf.log_sink.LogSink.init(.{ .batch_size = 64, .file_path = path }, schema, allocator);
+    var rec: [12]u8 = undefined;
+    for (0..200) |i| {
+        std.mem.writeInt(i64, rec[0..8], @intCast(i), .little);
+        std.mem.writeInt(i32, rec[8..12], @intCast(i), .little);
+        try sink.log(&rec);
+    }
+    sink.deinit();
+
+    const file_bytes = try readFileAlloc(allocator, path);
+    defer allocator.free(file_bytes);
+
+    try testing.expectEqualStrings("PAR1", file_bytes[0..4]);
+    try testing.expectEqualStrings("PAR1", file_bytes[file_bytes.len - 4 ..]);
+    try testing.expect(file_bytes.len > 200 * 12);
+}
+
+test "log sink rotates files by row count" {
+    const allocator = testing.allocator;
+    const batch = pf.batch;
+
+    const columns = [_]batch.ColumnDef{
+        .{ .name = "seq", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 0, .size = 8 },
+    };
+    const schema = batch.SchemaInfo{
+        .columns = &columns,
+        .record_size = 8,
+        .nullable_count = 0,
+        .null_bitmap_bytes = 0,
+    };
+
+    // 64-row batches, at most two per file: at least four files for 500 rows
+    const sink = try pf.log_sink.LogSink.init(.{
+        .batch_size = 64,
+        .file_path = "/tmp/pqflow_test_rotate.parquet",
+        .max_rows_per_file = 128,
+    }, schema, allocator);
+    var rec: [8]u8 = undefined;
+    for (0..500) |i| {
+        std.mem.writeInt(i64, &rec, @intCast(i), .little);
+        try sink.log(&rec);
+    }
+    sink.deinit();
+
+    var num_files: usize = 0;
+    var path_buf: [64]u8 = undefined;
+    while (true) : (num_files += 1) {
+        const path = try std.fmt.bufPrintSentinel(&path_buf, "/tmp/pqflow_test_rotate.{d:0>6}.parquet", .{num_files}, 0);
+        const file_bytes = readFileAlloc(allocator, path) catch break;
+        defer allocator.free(file_bytes);
+        _ = std.c.unlink(path);
+
+        try testing.expectEqualStrings("PAR1", file_bytes[0..4]);
+        try testing.expectEqualStrings("PAR1", file_bytes[file_bytes.len - 4 ..]);
+        // Every file was finalized and renamed
+        const inprogress = try std.fmt.bufPrintSentinel(&path_buf, "/tmp/pqflow_test_rotate.{d:0>6}.parquet.inprogress", .{num_files}, 0);
+        try testing.expect(std.c.fopen(inprogress, "rb") == null);
+    }
+    try testing.expect(num_files >= 4);
+}
+
+test "log sink writes one hive partition per key" {
+    const allocator = testing.allocator;
+    const batch = pf.batch;
+    const root = "/tmp/pqflow_test_partitions";
+    _ = std.c.mkdir(root, 0o755);
+    defer _ = std.c.rmdir(root);
+
+    const columns = [_]batch.ColumnDef{
+        .{ .name = "seq", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 0, .size = 8 },
+        .{ .name = "venue", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    };
+    const schema = batch.SchemaInfo{
+        .columns = &columns,
+        .record_size = 12,
+        .nullable_count = 0,
+        .null_bitmap_bytes = 0,
+    };
+
+    // Three venues interleaved record by record, one file each
+    const sink = try pf.log_sink.LogSink.init(.{
+        .batch_size = 64,
+        .file_path = root ++ "/orders.parquet",
+        .partition_column = "venue",
+        .num_partitions = 3,
+    }, schema, allocator);
+    var rec: [12]u8 = undefined;
+    for (0..300) |i| {
+        std.mem.writeInt(i64, rec[0..8], @intCast(i), .little);
+        std.mem.writeInt(i32, rec[8..12], @intCast(i % 3), .little);
+        try sink.log(&rec);
+    }
+    sink.deinit();
+
+    var dir_buf: [64]u8 = undefined;
+    var path_buf: [96]u8 = undefined;
+    for (0..3) |k| {
+        const dir = try std.fmt.bufPrintSentinel(&dir_buf, root ++ "/venue_bucket={d}", .{k}, 0);
+        defer _ = std.c.rmdir(dir);
+        const path = try std.fmt.bufPrintSentinel(&path_buf, "{s}/orders.parquet", .{dir}, 0);
+        const file_bytes = try readFileAlloc(allocator, path);
+        defer allocator.free(file_bytes);
+        _ = std.c.unlink(path);
+
+        try testing.expectEqualStrings("PAR1", file_bytes[0..4]);
+        try testing.expectEqualStrings("PAR1", file_bytes[file_bytes.len - 4 ..]);
+        try testing.expect(file_bytes.len > 100 * 12);
+    }
+}
+
+test "reader replays the records a log sink wrote" {
+    const allocator = testing.allocator;
+    const batch = pf.batch;
+    const path = "/tmp/pqflow_test_replay.parquet";
+    defer _ = std.c.unlink(path);
+
+    const columns = [_]batch.ColumnDef{
+        .{ .name = "seq", .physical_type = .INT64, .type_length = 0, .nullable = false, .offset = 0, .size = 8 },
+        .{ .name = "venue", .physical_type = .INT32, .type_length = 0, .nullable = false, .offset = 8, .size = 4 },
+    };
+    const schema = batch.SchemaInfo{
+        .columns = &columns,
+        .record_size = 12,
+        .nullable_count = 0,
+        .null_bitmap_bytes = 0,
+    };
+
+    // Several row groups, so they are decoded on more than one thread
+    const sink = try pf.log_sink.LogSink.init(.{ .batch_size = 64, .file_path = path }, schema, allocator);
+    var rec: [12]u8 = undefined;
+    for (0..300) |i| {
+        std.mem.writeInt(i64, rec[0..8], @intCast(i), .little);
+        std.mem.writeInt(i32, rec[8..12], @intCast(i % 3), .little);
+        try sink.log(&rec);
+    }
+    sink.deinit();
+
+    const reader = try pf.reader.Reader.open(allocator, path);
+    defer reader.close();
+    try testing.expectEqual(@as(u64, 300), reader.numRows());
+    try testing.expect(reader.numRowGroups() > 1);
+
+    const Check = struct {
+        next: i64 = 0,
+
+        fn onRow(self: *@This(), record: []const u8) bool {
+            if (record.len != 12) return false;
+            if (std.mem.readInt(i64, record[0..8], .little) != self.next) return false;
+            if (std.mem.readInt(i32, record[8..12], .little) != @mod(self.next, 3)) return false;
+            self.next += 1;
+            return true;
+        }
+    };
+    var check = Check{};
+    const result = try reader.scan(.{ .num_threads = 4 }, &check, Check.onRow);
+    try testing.expectEqual(@as(u64, 300), result.rows);
+    try testing.expectEqual(@as(i64, 300), check.next);
+}
@@ -215,3 +215,55 @@ test "concurrent producer/consumer with drainBatch" {
     try std.testing.expect(!consumer_error.load(.acquire));
     try std.testing.expect(rb.isEmpty());
 }
+
+test "ByteRing concurrent variable-length producer/consumer" {
+    const ByteRing = ring_buffer_mod.ByteRing;
+    var ring = try ByteRing.init(std.testing.allocator, 4096);
+    defer ring.deinit(std.testing.allocator);
+
+    const num_items: u32 = 100_000;
+    var consumer_error = std.atomic.Value(bool).init(false);
+
+    const producer = try std.Thread.spawn(.{}, struct {
+        fn run(r: *ByteRing, count: u32) void {
+            var rec: [300]u8 = undefined;
+            var i: u32 = 0;
+            while (i < count) {
+                // Lengths 1..300 exercise both tiny frames and wrap padding
+                const len = i % 300 + 1;
+                @memset(rec[0..len], @truncate(i));
+                if (r.tryPush(rec[0..len])) {
+                    i += 1;
+                } else {
+                    std.atomic.spinLoopHint();
+                }
+            }
+        }
+    }.run, .{ &ring, num_items });
+
+    const Checker = struct {
+        expected: u32 = 0,
+        err_flag: *std.atomic.Value(bool),
+
+        fn onRecord(self: *@This(), bytes: []const u8) void {
+            const want_len = self.expected % 300 + 1;
+            const want_byte: u8 = @truncate(self.expected);
+            if (bytes.len != want_len or bytes[0] != want_byte or bytes[bytes.len - 1] != want_byte) {
+                self.err_flag.store(true, .release);
+            }
+            self.expected += 1;
+        }
+    };
+
+    var checker = Checker{ .err_flag = &consumer_error };
+    while (checker.expected < num_items) {
+        if (ring.drain(64, &checker, Checker.onRecord) == 0) {
+            std.Thread.yield() catch {};
+        }
+    }
+
+    producer.join();
+
+    try std.testing.expect(!consumer_error.load(.acquire));
+    try std.testing.expect(ring.isEmpty());
+}
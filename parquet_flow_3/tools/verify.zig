@@ -0,0 +1,77 @@
+const std = @import("std");
+const pf = @import("parquet_flow");
+const Reader = pf.reader.Reader;
+const cycles = pf.cycles;
+const writeAll = pf.parquet.parquet_output.writeAll;
+const linux = std.os.linux;
+
+/// Decode every flat column of every row group of each file given and check
+/// the row counts against the footer, reporting the decode rate. Exits
+/// non-zero if any file fails.
+pub fn main(init: std.process.Init) !void {
+    const allocator = std.heap.c_allocator;
+
+    var args = std.process.Args.Iterator.init(init.minimal.args);
+    _ = args.skip();
+    var num_threads: u32 = 0;
+    var failed = false;
+    var any = false;
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "-h") or std.mem.eql(u8, arg, "--help")) {
+            return printUsage();
+        }
+        if (std.mem.eql(u8, arg, "--threads")) {
+            const value = args.next() orelse return error.MissingValue;
+            num_threads = try std.fmt.parseInt(u32, value, 10);
+            continue;
+        }
+        any = true;
+        verifyFile(allocator, arg, num_threads) catch |err| {
+            var buf: [1024]u8 = undefined;
+            try writeAll(2, try std.fmt.bufPrint(&buf, "{s}: FAILED: {s}\n", .{ arg, @errorName(err) }));
+            failed = true;
+        };
+    }
+    if (!any) return printUsage();
+    if (failed) std.process.exit(1);
+}
+
+fn verifyFile(allocator: std.mem.Allocator, path: []const u8, num_threads: u32) !void {
+    const start_ns = cycles.monotonicNs();
+    const reader = try Reader.open(allocator, path);
+    defer reader.close();
+    const result = try reader.verify(num_threads);
+    const elapsed_ns = @max(cycles.monotonicNs() - start_ns, 1);
+
+    const file_bytes = fileSize(reader.path);
+    const seconds = @as(f64, @floatFromInt(elapsed_ns)) / std.time.ns_per_s;
+    var buf: [1024]u8 = undefined;
+    try writeAll(1, try std.fmt.bufPrint(&buf, "{s}: ok rows={d} row_groups={d} columns={d} {d:.0} rows/s {d:.1} MB/s {d:.3} s\n", .{
+        path,
+        result.rows,
+        result.row_groups,
+        reader.columns.len,
+        @as(f64, @floatFromInt(result.rows)) / seconds,
+        @as(f64, @floatFromInt(file_bytes)) / seconds / 1e6,
+        seconds,
+    }));
+}
+
+fn fileSize(path: [*:0]const u8) u64 {
+    const rc = linux.open(path, .{ .ACCMODE = .RDONLY, .CLOEXEC = true }, 0);
+    if (linux.errno(rc) != .SUCCESS) return 0;
+    const fd: linux.fd_t = @intCast(rc);
+    defer _ = linux.close(fd);
+    const end = linux.lseek(fd, 0, linux.SEEK.END);
+    if (linux.errno(end) != .SUCCESS) return 0;
+    return end;
+}
+
+fn printUsage() !void {
+    try writeAll(1,
+        \\usage: zig build verify -Doptimize=ReleaseFast -- [--threads N] FILE.parquet...
+        \\  --threads N                  decode threads, 0 = one per CPU (default 0)
+        \\Decodes every flat column of every row group and checks the row counts.
+        \\
+    );
+}